@@ -21,8 +21,12 @@ AdventureTracker::AdventureTracker(GameObserver &observer, QObject *const parent
     m_observer.sig2_sentToUserString.connect(m_lifetime,
                                              [this](const QString &str) { onUserText(str); });
 
-    m_observer.sig2_sentToUserGmcp.connect(m_lifetime,
-                                           [this](const GmcpMessage &gmcp) { onUserGmcp(gmcp); });
+    m_observer.sentToUserGmcp.subscribe({GmcpMessageTypeEnum::CHAR_NAME,
+                                         GmcpMessageTypeEnum::CHAR_STATUSVARS,
+                                         GmcpMessageTypeEnum::CHAR_VITALS,
+                                         GmcpMessageTypeEnum::CORE_GOODBYE},
+                                        m_lifetime,
+                                        [this](const GmcpMessage &gmcp) { onUserGmcp(gmcp); });
 }
 
 void AdventureTracker::onUserText(const QString &line)
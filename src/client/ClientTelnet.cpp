@@ -104,11 +104,11 @@ void ClientTelnet::onReadyRead()
     });
 }
 
-void ClientTelnet::virt_sendToMapper(const RawBytes &data, bool /*goAhead*/)
+void ClientTelnet::virt_sendToMapper(const RawSlice &data, bool /*goAhead*/)
 {
     // The encoding for the built-in client is always Utf8.
     assert(getEncoding() == CharacterEncodingEnum::UTF8);
-    QString out = QString::fromUtf8(data.getQByteArray());
+    QString out = QString::fromUtf8(data.getQByteArrayView());
 
     // REVISIT: Why is virt_sendToMapper() calling sendToUser()? One needs to be renamed?
     m_output.sendToUser(out);
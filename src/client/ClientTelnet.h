@@ -61,7 +61,7 @@ class NODISCARD ClientTelnet final : AbstractTelnet
     NODISCARD bool isConnected() const { return m_socket.isConnected(); }
 
 private:
-    void virt_sendToMapper(const RawBytes &, bool goAhead) final;
+    void virt_sendToMapper(const RawSlice &, bool goAhead) final;
     void virt_receiveEchoMode(bool) final;
     void virt_sendRawData(const TelnetIacBytes &data) final;
 
@@ -13,7 +13,7 @@
 
 PreviewWidget::PreviewWidget(QWidget *parent)
     : QTextEdit(parent)
-    , helper{*this}
+    , helper{deref(document())}
 {
     const auto &settings = getConfig().integratedClient;
 
@@ -7,7 +7,10 @@
 #include "../configuration/configuration.h"
 #include "../global/AnsiTextUtils.h"
 
+#include <algorithm>
+
 #include <QApplication>
+#include <QDesktopServices>
 #include <QMessageLogContext>
 #include <QRegularExpression>
 #include <QScrollBar>
@@ -66,20 +69,52 @@ FontDefaults::FontDefaults()
 
 void AnsiTextHelper::init()
 {
-    QTextFrameFormat frameFormat = textEdit.document()->rootFrame()->frameFormat();
+    QTextFrameFormat frameFormat = document.rootFrame()->frameFormat();
     frameFormat.setBackground(defaults.defaultBg);
     frameFormat.setForeground(defaults.defaultFg);
-    textEdit.document()->rootFrame()->setFrameFormat(frameFormat);
+    document.rootFrame()->setFrameFormat(frameFormat);
 
     format = cursor.charFormat();
     setDefaultFormat(format, defaults);
     cursor.setCharFormat(format);
+
+    m_defaultFormat = format;
+    m_formatCache.clear();
+    currentAnsi = RawAnsi{};
+}
+
+void AnsiTextHelper::setAnsi(const RawAnsi &ansi)
+{
+    if (ansi == currentAnsi) {
+        return;
+    }
+
+    const auto it = std::find_if(m_formatCache.begin(),
+                                 m_formatCache.end(),
+                                 [&ansi](const CachedFormat &cached) {
+                                     return cached.ansi == ansi;
+                                 });
+    if (it != m_formatCache.end()) {
+        format = it->format;
+        currentAnsi = it->resolved;
+        return;
+    }
+
+    // Resolving from the default state gives the same result as updating the previous format.
+    QTextCharFormat resolvedFormat = m_defaultFormat;
+    const RawAnsi resolved = updateFormat(resolvedFormat, defaults, RawAnsi{}, ansi);
+    if (m_formatCache.size() >= MAX_CACHED_FORMATS) {
+        m_formatCache.clear();
+    }
+    m_formatCache.emplace_back(CachedFormat{ansi, resolved, resolvedFormat});
+    format = std::move(resolvedFormat);
+    currentAnsi = resolved;
 }
 
 DisplayWidgetOutputs::~DisplayWidgetOutputs() = default;
 DisplayWidget::DisplayWidget(QWidget *const parent)
-    : QTextBrowser(parent)
-    , m_ansiTextHelper{static_cast<QTextEdit &>(*this)}
+    : QPlainTextEdit(parent)
+    , m_ansiTextHelper{deref(document())}
     , m_timer{new QTimer(this)}
 {
     setReadOnly(true);
@@ -88,30 +123,31 @@ DisplayWidget::DisplayWidget(QWidget *const parent)
 
     m_timer->setSingleShot(true);
     connect(m_timer, &QTimer::timeout, this, [this]() {
-        QTextFrameFormat frameFormat = document()->rootFrame()->frameFormat();
-        frameFormat.setBackground(getConfig().integratedClient.backgroundColor);
-        document()->rootFrame()->setFrameFormat(frameFormat);
+        setBackgroundColor(getConfig().integratedClient.backgroundColor);
     });
     setDocumentTitle("MMapper Mud Client");
     setTextInteractionFlags(Qt::TextBrowserInteraction);
-    setOpenExternalLinks(true);
     setTabChangesFocus(false);
 
     // REVISIT: Is this necessary to do in both places?
     document()->setUndoRedoEnabled(false);
     m_ansiTextHelper.init();
 
+    // QPlainTextEdit doesn't paint the root frame's background.
+    setBackgroundColor(m_ansiTextHelper.defaults.defaultBg);
+    setMaximumBlockCount(getConfig().integratedClient.linesOfScrollback);
+
     // Set word wrap mode and other settings
     QFontMetrics fm{getDefaultFont()};
-    setLineWrapMode(QTextEdit::FixedColumnWidth);
+    setFont(getDefaultFont());
+    setLineWrapMode(QPlainTextEdit::WidgetWidth);
     setWordWrapMode(QTextOption::WordWrap);
     setSizeIncrement(fm.averageCharWidth(), fm.lineSpacing());
     setTabStopDistance(fm.horizontalAdvance(" ") * TAB_WIDTH_SPACES);
 
-    // Scrollbar settings
+    // Scrollbar settings (QPlainTextEdit scrolls by lines rather than pixels)
     QScrollBar *const scrollbar = verticalScrollBar();
-    scrollbar->setSingleStep(fm.lineSpacing());
-    scrollbar->setPageStep(sizeHint().height());
+    scrollbar->setPageStep(getConfig().integratedClient.rows);
     setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
     setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
 
@@ -130,6 +166,25 @@ DisplayWidget::DisplayWidget(QWidget *const parent)
 
 DisplayWidget::~DisplayWidget() = default;
 
+void DisplayWidget::setBackgroundColor(const QColor &color)
+{
+    QPalette pal = palette();
+    pal.setColor(QPalette::Base, color);
+    pal.setColor(QPalette::Text, m_ansiTextHelper.defaults.defaultFg);
+    setPalette(pal);
+}
+
+QString DisplayWidget::getAnchorAt(const QPoint &pos) const
+{
+    QTextCursor cur = cursorForPosition(pos);
+    // charFormat() describes the character before the cursor.
+    if (!cur.atBlockEnd()) {
+        cur.movePosition(QTextCursor::NextCharacter);
+    }
+    const QTextCharFormat fmt = cur.charFormat();
+    return fmt.isAnchor() ? fmt.anchorHref() : QString{};
+}
+
 QSize DisplayWidget::sizeHint() const
 {
     const auto &settings = getConfig().integratedClient;
@@ -168,8 +223,7 @@ void DisplayWidget::resizeEvent(QResizeEvent *const event)
         y -= 2;
     }
 
-    // Set the line wrap width/height
-    setLineWrapColumnOrWidth(x);
+    // Lines wrap at the widget's width; the page step is in lines.
     verticalScrollBar()->setPageStep(y);
 
     // Inform user of new dimensions
@@ -183,7 +237,7 @@ void DisplayWidget::resizeEvent(QResizeEvent *const event)
         getOutput().windowSizeChanged(x, y);
     }
 
-    QTextEdit::resizeEvent(event);
+    base::resizeEvent(event);
 
     bool atBottom = (verticalScrollBar()->sliderPosition() == verticalScrollBar()->maximum());
     getOutput().showPreview(!atBottom);
@@ -213,13 +267,32 @@ void DisplayWidget::keyPressEvent(QKeyEvent *event)
     };
 
     if (isModifier || isNavigationKey() || isAllowedKeySequence()) {
-        QTextBrowser::keyPressEvent(event);
+        base::keyPressEvent(event);
     } else {
         getOutput().returnFocusToInput();
         event->accept();
     }
 }
 
+void DisplayWidget::mouseMoveEvent(QMouseEvent *const event)
+{
+    base::mouseMoveEvent(event);
+    const bool overLink = !getAnchorAt(event->position().toPoint()).isEmpty();
+    viewport()->setCursor(overLink ? Qt::PointingHandCursor : Qt::IBeamCursor);
+}
+
+void DisplayWidget::mouseReleaseEvent(QMouseEvent *const event)
+{
+    // Unlike QTextBrowser, QPlainTextEdit doesn't open links on its own.
+    if (event->button() == Qt::LeftButton && !textCursor().hasSelection()) {
+        const QString href = getAnchorAt(event->position().toPoint());
+        if (!href.isEmpty()) {
+            QDesktopServices::openUrl(QUrl{href});
+        }
+    }
+    base::mouseReleaseEvent(event);
+}
+
 void setDefaultFormat(QTextCharFormat &format, const FontDefaults &defaults)
 {
     format.setFont(defaults.serverOutputFont);
@@ -233,9 +306,6 @@ void setDefaultFormat(QTextCharFormat &format, const FontDefaults &defaults)
 
 void AnsiTextHelper::displayText(const QStringView input_str)
 {
-    // ANSI codes are formatted as the following:
-    // escape + [ + n1 (+ n2) + m
-    static const QRegularExpression ansi_regex{R"regex(\x1B[^A-Za-z\x1B]*[A-Za-z]?)regex"};
     static const QRegularExpression url_regex{
         R"regex(https?:\/\/(www\.)?[-a-zA-Z0-9@:%._\+~#=]{1,256}\.[a-zA-Z0-9()]{1,6}\b([-a-zA-Z0-9()@:%_\+.~#?&//=]*))regex"};
 
@@ -264,60 +334,71 @@ void AnsiTextHelper::displayText(const QStringView input_str)
     static const volatile bool debug_backspaces = false;
 
     auto try_remove_backspace = [this]() {
-        if (!allow_backspaces) {
-            return;
-        }
-
-        const auto block = cursor.block();
-        if (!block.isValid() || cursor.block().length() == 0) {
+        if (!allow_backspaces || cursor.positionInBlock() == 0) {
             return;
         }
 
-        const auto text = block.text();
-        if (text.isNull() || text.isEmpty() || text.back() != char_consts::C_BACKSPACE) {
+        if (document.characterAt(cursor.position() - 1) != char_consts::C_BACKSPACE) {
             return;
         }
 
         cursor.deletePreviousChar();
-        if (block.length() > 0) {
+        if (cursor.positionInBlock() > 0) {
             cursor.deletePreviousChar();
         }
     };
 
-    auto add_raw = [this, &try_remove_backspace](const QStringView text,
-                                                 const QTextCharFormat &withFmt) {
+    // Contiguous text in the current format is collected here and inserted all at once,
+    // since every insertion has to find (or split) a fragment of the document.
+    QString pending;
+    auto flush = [this, &pending, &try_remove_backspace]() {
+        if (pending.isEmpty()) {
+            return;
+        }
+        try_remove_backspace();
+        cursor.insertText(pending, format);
+        pending.clear();
+    };
+
+    auto add_raw = [this, &flush, &try_remove_backspace](const QStringView text,
+                                                         const QTextCharFormat &withFmt) {
+        flush();
         try_remove_backspace();
         cursor.insertText(text.toString(), withFmt);
     };
 
-    auto try_add_backspace = [this, &add_raw]() {
+    auto try_add_backspace = [this, &flush, &add_raw]() {
         if (debug_backspaces) {
             add_raw(u"(BACKSPACE)", {});
             return;
         }
 
+        // The checks below look at the document, so the text before the backspace
+        // has to be in it.
+        flush();
         if (!allow_backspaces || cursor.position() < 1) {
             return;
         }
 
+        // note: the length includes the block separator
         const auto block = cursor.block();
-        if (!block.isValid() && block.length() < 1) {
-            return;
-        }
-
-        const auto text = block.text();
-        if (text.isNull() || text.isEmpty()) {
+        if (!block.isValid() || block.length() <= 1) {
             return;
         }
 
         add_raw(mmqt::QS_BACKSPACE, {});
     };
 
-    auto add_formatted = [this, &add_raw, &try_remove_backspace](const QStringView text) {
+    auto add_formatted = [this, &pending, &flush, &try_remove_backspace](const QStringView text) {
+        if (!text.contains(u"http")) {
+            pending.append(text);
+            return;
+        }
+
         mmqt::foreach_regex(
             url_regex,
             text,
-            [this, &try_remove_backspace](const QStringView url) {
+            [this, &flush, &try_remove_backspace](const QStringView url) {
                 const auto s = url.toString();
                 // TODO: override the document's CSS for URLs
                 const auto link
@@ -326,41 +407,53 @@ void AnsiTextHelper::displayText(const QStringView input_str)
                           .arg(QString::fromUtf8(QUrl::fromUserInput(s).toEncoded()),
                                s.toHtmlEscaped());
 
+                flush();
                 try_remove_backspace();
                 cursor.insertHtml(link);
             },
-            [this, &add_raw](const QStringView non_url) { add_raw(non_url, format); });
+            [&pending](const QStringView non_url) { pending.append(non_url); });
+    };
+
+    auto add_text = [&try_add_backspace, &add_formatted](const QStringView textStr) {
+        if (!textStr.isEmpty()) {
+            foreach_backspace(textStr, try_add_backspace, add_formatted);
+        }
     };
 
     // Display text using a cursor
-    mmqt::foreach_regex(
-        ansi_regex,
-        input_str,
-        [this, &add_raw](const QStringView ansiStr) {
-            assert(!ansiStr.isEmpty() && ansiStr.front() == char_consts::C_ESC);
-            if (mmqt::isAnsiColor(ansiStr)) {
-                if (auto optNewColor = mmqt::parseAnsiColor(currentAnsi, ansiStr)) {
-                    currentAnsi = updateFormat(format, defaults, currentAnsi, *optNewColor);
-                }
-            } else if (mmqt::isAnsiEraseLine(ansiStr)) {
-                cursor.movePosition(QTextCursor::Left, QTextCursor::MoveAnchor, 1);
-                cursor.movePosition(QTextCursor::End, QTextCursor::KeepAnchor);
-                cursor.removeSelectedText();
-            } else {
-                add_raw(u"<ESC>", {});
-                if (ansiStr.length() > 1) {
-                    add_raw(ansiStr.mid(1), format);
-                }
+    qsizetype pos = 0;
+    auto on_ansi = [this, &input_str, &pos, &add_text, &add_raw, &flush](
+                       const qsizetype start, const QStringView ansiStr) {
+        add_text(input_str.mid(pos, start - pos));
+        pos = start + ansiStr.size();
+
+        assert(!ansiStr.isEmpty() && ansiStr.front() == char_consts::C_ESC);
+        if (mmqt::isAnsiColor(ansiStr)) {
+            if (auto optNewColor = mmqt::parseAnsiColor(currentAnsi, ansiStr);
+                optNewColor && *optNewColor != currentAnsi) {
+                flush();
+                setAnsi(*optNewColor);
             }
-        },
-        [&try_add_backspace, &add_formatted](const QStringView textStr) {
-            foreach_backspace(textStr, try_add_backspace, add_formatted);
-        });
+        } else if (mmqt::isAnsiEraseLine(ansiStr)) {
+            flush();
+            cursor.movePosition(QTextCursor::Left, QTextCursor::MoveAnchor, 1);
+            cursor.movePosition(QTextCursor::End, QTextCursor::KeepAnchor);
+            cursor.removeSelectedText();
+        } else {
+            add_raw(u"<ESC>", {});
+            if (ansiStr.length() > 1) {
+                add_raw(ansiStr.mid(1), format);
+            }
+        }
+    };
+    mmqt::foreachAnsi(input_str, on_ansi);
+    add_text(input_str.mid(pos));
+    flush();
 }
 
 void AnsiTextHelper::limitScrollback(int lineLimit)
 {
-    const int lineCount = textEdit.document()->lineCount();
+    const int lineCount = document.lineCount();
     if (lineCount > lineLimit) {
         const int trimLines = lineCount - lineLimit;
         cursor.movePosition(QTextCursor::Start);
@@ -372,11 +465,16 @@ void AnsiTextHelper::limitScrollback(int lineLimit)
 
 void DisplayWidget::slot_displayText(const QStringView str)
 {
+    // The document discards the oldest blocks by itself once it holds this many,
+    // so trimming doesn't have to count every line after each insertion.
     const int lineLimit = getConfig().integratedClient.linesOfScrollback;
+    if (maximumBlockCount() != lineLimit) {
+        setMaximumBlockCount(lineLimit);
+    }
 
     auto &vscroll = deref(verticalScrollBar());
-    constexpr int ALMOST_ALL_THE_WAY = 4;
-    const bool wasAtBottom = (vscroll.sliderPosition() >= vscroll.maximum() - ALMOST_ALL_THE_WAY);
+    // note: the scrollbar's units are lines
+    const bool wasAtBottom = (vscroll.sliderPosition() >= vscroll.maximum());
 
     auto on_bell = [this]() {
         const auto &settings = getConfig().integratedClient;
@@ -384,12 +482,6 @@ void DisplayWidget::slot_displayText(const QStringView str)
             QApplication::beep();
         }
         if (settings.visualBell) {
-            auto setBackgroundColor = [this](const QColor &color) {
-                QTextFrameFormat frameFormat = document()->rootFrame()->frameFormat();
-                frameFormat.setBackground(color);
-                document()->rootFrame()->setFrameFormat(frameFormat);
-            };
-
             QColor flashColor = getConfig().integratedClient.backgroundColor;
             flashColor.setRed(std::min(255, flashColor.red() + 80));
             setBackgroundColor(flashColor);
@@ -402,11 +494,6 @@ void DisplayWidget::slot_displayText(const QStringView str)
         m_ansiTextHelper.displayText(nonBellText);
     });
 
-    // REVISIT: include option to limit scrollback in the displayText function,
-    // so it can choose to remove lines from the top when the overflow occurs,
-    // to improve performance for massive inserts.
-    m_ansiTextHelper.limitScrollback(lineLimit);
-
     // Detecting the keyboard Scroll Lock status would be preferable, but we'll have to live with
     // this because Qt is apparently the only windowing system in existence that doesn't provide
     // a way to query CapsLock/NumLock/ScrollLock ?!?
@@ -563,7 +650,7 @@ void setAnsiText(QTextEdit *const pEdit, const std::string_view text)
     // REVISIT: Is this necessary to do in both places?
     deref(edit.document()).setUndoRedoEnabled(false);
 
-    AnsiTextHelper helper{edit};
+    AnsiTextHelper helper{deref(edit.document())};
     helper.init();
     helper.displayText(mmqt::toQStringUtf8(text));
 
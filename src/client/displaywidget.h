@@ -7,12 +7,13 @@
 #include "../global/macros.h"
 
 #include <optional>
+#include <vector>
 
 #include <QColor>
 #include <QFont>
+#include <QPlainTextEdit>
 #include <QSize>
 #include <QString>
-#include <QTextBrowser>
 #include <QTextCursor>
 #include <QTextEdit>
 #include <QTextFormat>
@@ -20,6 +21,7 @@
 #include <QtCore>
 #include <QtGui>
 
+class QMouseEvent;
 class QObject;
 class QResizeEvent;
 class QTextDocument;
@@ -45,26 +47,47 @@ NODISCARD extern RawAnsi updateFormat(QTextCharFormat &format,
 
 struct NODISCARD AnsiTextHelper final
 {
-    QTextEdit &textEdit;
+private:
+    struct NODISCARD CachedFormat final
+    {
+        RawAnsi ansi;
+        RawAnsi resolved; // as returned by updateFormat()
+        QTextCharFormat format;
+    };
+    // A session only ever sees a handful of distinct ANSI states, so a short list is plenty;
+    // it's cleared if something manages to fill it.
+    static constexpr size_t MAX_CACHED_FORMATS = 64;
+
+public:
+    QTextDocument &document;
     QTextCursor cursor;
     QTextCharFormat format;
     const FontDefaults defaults;
     RawAnsi currentAnsi;
 
-    explicit AnsiTextHelper(QTextEdit &input_textEdit, FontDefaults def)
-        : textEdit{input_textEdit}
-        , cursor{textEdit.document()->rootFrame()->firstCursorPosition()}
+private:
+    QTextCharFormat m_defaultFormat;
+    std::vector<CachedFormat> m_formatCache;
+
+public:
+    explicit AnsiTextHelper(QTextDocument &input_document, FontDefaults def)
+        : document{input_document}
+        , cursor{document.rootFrame()->firstCursorPosition()}
         , format{cursor.charFormat()}
         , defaults{std::move(def)}
     {}
 
-    explicit AnsiTextHelper(QTextEdit &input_textEdit)
-        : AnsiTextHelper{input_textEdit, FontDefaults{}}
+    explicit AnsiTextHelper(QTextDocument &input_document)
+        : AnsiTextHelper{input_document, FontDefaults{}}
     {}
 
     void init();
     void displayText(const QStringView str);
     void limitScrollback(int lineLimit);
+
+private:
+    // Switches to the (cached) format of the given ANSI state.
+    void setAnsi(const RawAnsi &ansi);
 };
 
 extern void setAnsiText(QTextEdit *pEdit, std::string_view text);
@@ -92,12 +115,15 @@ struct DisplayWidgetOutputs
     virtual void virt_showPreview(bool visible) = 0;
 };
 
-class NODISCARD_QOBJECT DisplayWidget final : public QTextBrowser
+// QPlainTextEdit only lays out the blocks that are visible, and the document drops blocks from
+// the top once it reaches the scrollback limit, so appending stays cheap no matter how much
+// scrollback is kept.
+class NODISCARD_QOBJECT DisplayWidget final : public QPlainTextEdit
 {
     Q_OBJECT
 
 private:
-    using base = QTextBrowser;
+    using base = QPlainTextEdit;
 
 private:
     DisplayWidgetOutputs *m_output = nullptr;
@@ -127,6 +153,8 @@ class NODISCARD_QOBJECT DisplayWidget final : public QTextBrowser
     {
         return m_ansiTextHelper.defaults.serverOutputFont;
     }
+    void setBackgroundColor(const QColor &color);
+    NODISCARD QString getAnchorAt(const QPoint &pos) const;
 
 public:
     NODISCARD bool canCopy() const { return m_canCopy; }
@@ -135,6 +163,8 @@ class NODISCARD_QOBJECT DisplayWidget final : public QTextBrowser
 protected:
     void resizeEvent(QResizeEvent *event) override;
     void keyPressEvent(QKeyEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
 
 public slots:
     void slot_displayText(const QStringView str);
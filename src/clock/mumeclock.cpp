@@ -111,8 +111,10 @@ MumeClock::MumeClock(int64_t mumeEpoch, GameObserver &observer, QObject *const p
     , m_mumeStartEpoch(mumeEpoch)
     , m_precision(MumeClockPrecisionEnum::UNSET)
 {
-    m_observer.sig2_sentToUserGmcp.connect(m_lifetime,
-                                           [this](const GmcpMessage &gmcp) { onUserGmcp(gmcp); });
+    m_observer.sentToUserGmcp.subscribe({GmcpMessageTypeEnum::EVENT_DARKNESS,
+                                         GmcpMessageTypeEnum::EVENT_SUN},
+                                        m_lifetime,
+                                        [this](const GmcpMessage &gmcp) { onUserGmcp(gmcp); });
     connect(&m_timer, &QTimer::timeout, this, &MumeClock::slot_tick);
     m_timer.start(1000);
 }
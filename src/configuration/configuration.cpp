@@ -247,6 +247,7 @@ ConstString KEY_GROUP_NPC_HIDE = "npc hide";
 ConstString KEY_AUTO_LOG = "Auto log";
 ConstString KEY_AUTO_LOG_ASK_DELETE = "Auto log ask before deleting";
 ConstString KEY_AUTO_LOG_CLEANUP_STRATEGY = "Auto log cleanup strategy";
+ConstString KEY_AUTO_LOG_COMPRESS = "Auto log compress";
 ConstString KEY_AUTO_LOG_DELETE_AFTER_DAYS = "Auto log delete after X days";
 ConstString KEY_AUTO_LOG_DELETE_AFTER_BYTES = "Auto log delete after X bytes";
 ConstString KEY_AUTO_LOG_DIRECTORY = "Auto log directory";
@@ -267,6 +268,7 @@ ConstString KEY_LINES_OF_PEEK_PREVIEW = "Lines of peek preview";
 ConstString KEY_LINES_OF_SCROLLBACK = "Lines of scrollback";
 ConstString KEY_PROXY_LOCAL_PORT = "Local port number";
 ConstString KEY_MAP_MODE = "Map Mode";
+ConstString KEY_MAP_ROOM_TEXT_ON_DISK = "Keep room text on disk";
 ConstString KEY_MUSIC_VOLUME = "Music volume";
 ConstString KEY_SOUND_VOLUME = "Sound volume";
 ConstString KEY_AUDIO_OUTPUT_DEVICE = "Audio output device";
@@ -603,6 +605,7 @@ void Configuration::GeneralSettings::read(const QSettings &conf)
     mapMode = sanitizeMapMode(
         conf.value(KEY_MAP_MODE, static_cast<uint32_t>(MapModeEnum::PLAY)).toUInt());
     checkForUpdate = conf.value(KEY_CHECK_FOR_UPDATE, true).toBool();
+    mapRoomTextOnDisk = conf.value(KEY_MAP_ROOM_TEXT_ON_DISK, false).toBool();
     characterEncoding = sanitizeCharacterEncoding(
         conf.value(KEY_CHARACTER_ENCODING, static_cast<uint32_t>(CharacterEncodingEnum::LATIN1))
             .toUInt());
@@ -714,6 +717,7 @@ void Configuration::AutoLogSettings::read(const QSettings &conf)
             .toInt());
     deleteWhenLogsReachDays = conf.value(KEY_AUTO_LOG_DELETE_AFTER_DAYS, 30).toInt();
     deleteWhenLogsReachBytes = conf.value(KEY_AUTO_LOG_DELETE_AFTER_BYTES, 100 * 1000000).toInt();
+    compressLogs = conf.value(KEY_AUTO_LOG_COMPRESS, false).toBool();
 }
 
 void Configuration::ParserSettings::read(const QSettings &conf)
@@ -838,6 +842,7 @@ void Configuration::GeneralSettings::write(QSettings &conf) const
     conf.setValue(KEY_SHOW_MENU_BAR, showMenuBar);
     conf.setValue(KEY_MAP_MODE, static_cast<uint32_t>(mapMode));
     conf.setValue(KEY_CHECK_FOR_UPDATE, checkForUpdate);
+    conf.setValue(KEY_MAP_ROOM_TEXT_ON_DISK, mapRoomTextOnDisk);
     conf.setValue(KEY_CHARACTER_ENCODING, static_cast<uint32_t>(characterEncoding));
     conf.setValue(KEY_THEME, static_cast<uint32_t>(m_theme));
 }
@@ -908,6 +913,7 @@ void Configuration::AutoLogSettings::write(QSettings &conf) const
     conf.setValue(KEY_AUTO_LOG_ASK_DELETE, askDelete);
     conf.setValue(KEY_AUTO_LOG_DELETE_AFTER_DAYS, deleteWhenLogsReachDays);
     conf.setValue(KEY_AUTO_LOG_DELETE_AFTER_BYTES, deleteWhenLogsReachBytes);
+    conf.setValue(KEY_AUTO_LOG_COMPRESS, compressLogs);
 }
 
 void Configuration::ParserSettings::write(QSettings &conf) const
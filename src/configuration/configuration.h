@@ -82,6 +82,8 @@ class NODISCARD Configuration final
         bool showMenuBar = true;
         MapModeEnum mapMode = MapModeEnum::PLAY;
         bool checkForUpdate = true;
+        // Keeps room descriptions and contents in a memory-mapped file instead of the heap.
+        bool mapRoomTextOnDisk = false;
         CharacterEncodingEnum characterEncoding = CharacterEncodingEnum::LATIN1;
 
     private:
@@ -280,6 +282,7 @@ class NODISCARD Configuration final
         int deleteWhenLogsReachBytes = 0;
         bool askDelete = false;
         int rotateWhenLogsReachBytes = 0;
+        bool compressLogs = false;
 
     private:
         SUBGROUP();
@@ -7,6 +7,7 @@
 #include "../global/CaseUtils.h"
 #include "../global/ChangeMonitor.h"
 #include "../global/ConfigConsts.h"
+#include "../global/PerfStats.h"
 #include "../global/RuleOf5.h"
 #include "../global/logging.h"
 #include "../global/progresscounter.h"
@@ -518,6 +519,8 @@ void MapCanvas::updateMapBatches()
         return;
     }
 
+    DECL_PERF_TIMER(t, Remesh);
+
     if (m_data.getNeedsMapUpdate()) {
         m_data.clearNeedsMapUpdate();
         assert(!m_data.getNeedsMapUpdate());
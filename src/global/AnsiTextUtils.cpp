@@ -10,7 +10,9 @@
 #include "Flags.h"
 #include "LineUtils.h"
 #include "PrintUtils.h"
+#include "SimdUtils.h"
 #include "logging.h"
+#include "string_view_utils.h"
 #include "tests.h"
 #include "utils.h"
 
@@ -1957,6 +1959,34 @@ TextBuffer normalizeAnsi(AnsiSupportFlags supportFlags, const QString &str)
     return normalizeAnsi(supportFlags, QStringView{str});
 }
 
+qsizetype weakAnsiLength(const QStringView sv)
+{
+    assert(!sv.empty() && sv.front() == QC_ESC);
+
+    // Same as weakAnsiRegex: ESC, then an optional '[', any number of digits, ';' and ':',
+    // and an optional ASCII letter.
+    const auto asciiAt = [&sv](const qsizetype i) -> char {
+        const char16_t u = sv[i].unicode();
+        return (u < 0x80u) ? static_cast<char>(u) : C_NUL;
+    };
+
+    const auto len = sv.size();
+    qsizetype pos = 1;
+    if (pos < len && asciiAt(pos) == C_OPEN_BRACKET) {
+        ++pos;
+    }
+    for (; pos < len; ++pos) {
+        const char c = asciiAt(pos);
+        if (!ascii::isDigit(c) && c != C_SEMICOLON && c != C_COLON) {
+            break;
+        }
+    }
+    if (pos < len && (ascii::isLower(asciiAt(pos)) || ascii::isUpper(asciiAt(pos)))) {
+        ++pos;
+    }
+    return pos;
+}
+
 bool AnsiStringToken::isAnsiCsi() const
 {
     return type == TokenTypeEnum::Ansi && length() >= 4 && at(0) == QC_ESC
@@ -1980,7 +2010,10 @@ AnsiStringToken AnsiTokenizer::Iterator::getCurrent()
 {
     assert(!m_str.empty());
     const QChar c = m_str[0];
-    if (c == QC_ESC) {
+    if (const char16_t u = c.unicode(); u > 0x20u && u < 0x7Fu) {
+        // Most tokens are words made of printable ASCII.
+        return AnsiStringToken{TokenTypeEnum::Word, m_str, 0, skip_word()};
+    } else if (c == QC_ESC) {
         return AnsiStringToken{TokenTypeEnum::Ansi, m_str, 0, skip_ansi()};
     } else if (c == QC_NEWLINE) {
         return AnsiStringToken{TokenTypeEnum::Newline, m_str, 0, 1};
@@ -2053,17 +2086,25 @@ AnsiTokenizer::Iterator::size_type AnsiTokenizer::Iterator::skip_space() const
 
 AnsiTokenizer::Iterator::size_type AnsiTokenizer::Iterator::skip_word() const
 {
-    return skip([](const QChar qc) -> ResultEnum {
-        switch (mmqt::toLatin1(qc)) {
-        case C_ESC:
-        case C_NBSP:
-        case C_CARRIAGE_RETURN:
-        case C_NEWLINE:
-            return ResultEnum::STOP;
-        default:
-            return (qc.isSpace() || isControl(qc)) ? ResultEnum::STOP : ResultEnum::KEEPGOING;
-        }
-    });
+    // Printable ASCII never ends a word, so only the rest needs the per-character checks.
+    const auto graph = simd_utils::countLeadingGraphAscii(mmqt::as_u16string_view(m_str));
+    const auto from = std::max<size_type>(1, static_cast<size_type>(graph));
+    if (from == m_str.size()) {
+        return from;
+    }
+    return skip(
+        [](const QChar qc) -> ResultEnum {
+            switch (mmqt::toLatin1(qc)) {
+            case C_ESC:
+            case C_NBSP:
+            case C_CARRIAGE_RETURN:
+            case C_NEWLINE:
+                return ResultEnum::STOP;
+            default:
+                return (qc.isSpace() || isControl(qc)) ? ResultEnum::STOP : ResultEnum::KEEPGOING;
+            }
+        },
+        from);
 }
 
 } // namespace mmqt
@@ -2348,6 +2389,61 @@ void test_ansi_parse()
         TEST_ASSERT(tmp.value() == expect);
     }
 }
+
+void test_foreach_ansi()
+{
+    // weakAnsiLength() must report the same matches as weakAnsiRegex.
+    const auto expectSameAsRegex = [](const QString &line) {
+        std::vector<std::pair<qsizetype, QString>> expect;
+        for (auto it = mmqt::weakAnsiRegex.globalMatch(line); it.hasNext();) {
+            const auto m = it.next();
+            expect.emplace_back(m.capturedStart(), m.captured());
+        }
+        std::vector<std::pair<qsizetype, QString>> actual;
+        mmqt::foreachAnsi(line, [&actual](const qsizetype start, const QStringView sv) {
+            actual.emplace_back(start, sv.toString());
+        });
+        TEST_ASSERT(actual == expect);
+    };
+
+    expectSameAsRegex("");
+    expectSameAsRegex("plain text");
+    expectSameAsRegex("\x1B");
+    expectSameAsRegex("\x1B\x1B[");
+    expectSameAsRegex("a\x1B[0mb\x1B[1;31mc\x1B[38:5:208md\x1B[e");
+    expectSameAsRegex("\x1B[32mThe Prancing Pony\x1B[0m\r\n\x1B[1;33mA large inn.\x1B[0m");
+    expectSameAsRegex(QString::fromUtf8("\x1B[3\u00E9m \x1B\u00E9 \x1B[1\u2014"));
+}
+
+void test_ansi_tokenizer()
+{
+    using mmqt::TokenTypeEnum;
+    const QString text = QString::fromUtf8("\x1B[1;32mThe\x1B[0m  caf\u00E9\u00A0is open.\n"
+                                           "\tA\u2003verylongwordthatspansvectors!\x01");
+
+    std::vector<std::pair<TokenTypeEnum, QString>> tokens;
+    for (const mmqt::AnsiStringToken token : mmqt::AnsiTokenizer{text}) {
+        tokens.emplace_back(token.type, token.getQStringView().toString());
+    }
+
+    const std::vector<std::pair<TokenTypeEnum, QString>> expect{
+        {TokenTypeEnum::Ansi, "\x1B[1;32m"},
+        {TokenTypeEnum::Word, "The"},
+        {TokenTypeEnum::Ansi, "\x1B[0m"},
+        {TokenTypeEnum::Space, "  "},
+        {TokenTypeEnum::Word, QString::fromUtf8("caf\u00E9")},
+        {TokenTypeEnum::Word, QString::fromUtf8("\u00A0is")},
+        {TokenTypeEnum::Space, " "},
+        {TokenTypeEnum::Word, "open."},
+        {TokenTypeEnum::Newline, "\n"},
+        {TokenTypeEnum::Control, "\t"},
+        {TokenTypeEnum::Word, "A"},
+        {TokenTypeEnum::Space, QString::fromUtf8("\u2003")},
+        {TokenTypeEnum::Word, "verylongwordthatspansvectors!"},
+        {TokenTypeEnum::Control, "\x01"},
+    };
+    TEST_ASSERT(tokens == expect);
+}
 } // namespace
 
 namespace test {
@@ -2560,6 +2656,8 @@ void testAnsiTextUtils()
 
     test_itu();
     test_ansi_parse();
+    test_foreach_ansi();
+    test_ansi_tokenizer();
 }
 
 } // namespace test
@@ -943,14 +943,16 @@ struct NODISCARD AnsiTokenizer final
     private:
         enum class NODISCARD ResultEnum : uint8_t { KEEPGOING, STOP };
 
+        // The first `from` units are already known to belong to the token.
         template<typename Callback>
-        NODISCARD size_type skip(Callback &&check) const
+        NODISCARD size_type skip(Callback &&check, const size_type from = 1) const
         {
             const auto len = m_str.size();
             assert(len > 0);
             const auto start = 0;
             assert(isClamped<qsizetype>(start, 0, len));
-            auto it = start + 1;
+            assert(isClamped<qsizetype>(from, 1, len));
+            auto it = from;
             for (; it < len; ++it) {
                 if (check(m_str[it]) == ResultEnum::STOP) {
                     break;
@@ -983,11 +985,14 @@ NODISCARD bool containsAnsi(const QString &str);
 
 extern const QRegularExpression weakAnsiRegex;
 
+// Returns the length of the weakAnsiRegex match at the start of sv, which must begin with ESC.
+NODISCARD extern qsizetype weakAnsiLength(QStringView sv);
+
 // Reports any potential ANSI sequence, including invalid sequences.
 // Use isAnsiColor(ref) to verify if the value reported is a color.
 //
 // Callback:
-// void(int start, QStringView sv)
+// void(qsizetype start, QStringView sv)
 //
 // NOTE: This version only reports callback(start, length),
 // because the intended caller needs the start position,
@@ -998,12 +1003,13 @@ void foreachAnsi(const QStringView line, Callback &&callback)
     const auto len = line.size();
     qsizetype pos = 0;
     while (pos < len) {
-        QRegularExpressionMatch m = weakAnsiRegex.match(line, pos);
-        if (!m.hasMatch()) {
+        const auto start = line.indexOf(QC_ESC, pos);
+        if (start < 0) {
             break;
         }
-        callback(m.capturedStart(), m.captured());
-        pos = m.capturedEnd();
+        const auto ansi = line.mid(start, weakAnsiLength(line.mid(start)));
+        callback(start, ansi);
+        pos = start + ansi.size();
     }
 }
 
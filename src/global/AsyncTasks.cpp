@@ -10,7 +10,10 @@
 #include "thread_utils.h"
 
 #include <chrono>
+#include <deque>
 #include <future>
+#include <iomanip>
+#include <sstream>
 
 #include <QTimer>
 
@@ -24,6 +27,26 @@ auto coloredString(const std::string_view msg)
     return ColoredQuotedStringView{green, yellow, msg};
 }
 
+NODISCARD std::string toFixed(const double value, const int precision)
+{
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(precision) << value;
+    return std::move(oss).str();
+}
+
+void formatBytes(AnsiOstream &aos, const size_t bytes)
+{
+    constexpr size_t KiB = 1024;
+    constexpr size_t MiB = KiB * KiB;
+    if (bytes < KiB) {
+        aos << ColoredValue{green, bytes} << " bytes";
+    } else if (bytes < MiB) {
+        aos << ColoredValue{green, toFixed(static_cast<double>(bytes) / KiB, 1)} << " KiB";
+    } else {
+        aos << ColoredValue{green, toFixed(static_cast<double>(bytes) / MiB, 1)} << " MiB";
+    }
+}
+
 } // namespace
 
 namespace async_tasks {
@@ -85,6 +108,34 @@ void formatElapsedSeconds(AnsiOstream &aos, const Clock::duration dt)
     }
 }
 
+void formatReport(AnsiOstream &aos, const ProgressCounter::Report &report)
+{
+    for (const auto &phase : report.phases) {
+        const auto seconds = std::chrono::duration<double>(phase.elapsed).count();
+        aos << "  " << coloredString(phase.msg.getStdStringViewUtf8()) << ": "
+            << ColoredValue{green, toFixed(seconds * 1000.0, 1)} << " ms";
+        if (phase.steps != 0) {
+            aos << ", " << ColoredValue{green, phase.steps} << " step"
+                << ((phase.steps == 1) ? "" : "s");
+            if (seconds > 0.0) {
+                const auto rate = static_cast<double>(phase.steps) / seconds;
+                aos << " (" << ColoredValue{green, toFixed(rate, 0)} << "/s)";
+            }
+        }
+        aos << "\n";
+    }
+    for (const auto &[what, bytes] : report.byteCounts) {
+        aos << "  " << what << ": ";
+        formatBytes(aos, bytes);
+        aos << "\n";
+    }
+    if (report.peakResidentBytes.has_value()) {
+        aos << "  peak memory: ";
+        formatBytes(aos, report.peakResidentBytes.value());
+        aos << "\n";
+    }
+}
+
 namespace AsyncTasksWatcher {
 static void started(const AsyncTaskHandle &task)
 {
@@ -502,9 +553,20 @@ class NODISCARD AsyncTasks final
 private:
     using Clock = std::chrono::steady_clock;
     static constexpr auto g_timer_period = std::chrono::milliseconds(250);
+    static constexpr size_t g_max_finished_reports = 10;
+
+    struct NODISCARD FinishedTask final
+    {
+        std::string name;
+        size_t id = 0;
+        AsyncTaskTypeEnum type = AsyncTaskTypeEnum::Task;
+        Clock::duration elapsed{};
+        ProgressCounter::Report report;
+    };
 
 private:
     std::list<AsyncTaskHandle> m_tasks;
+    std::deque<FinishedTask> m_finished;
     QTimer m_timer;
     std::optional<Clock::time_point> m_last_status_log_time;
 
@@ -570,6 +632,59 @@ class NODISCARD AsyncTasks final
         }
     }
 
+    void reportStats(AnsiOstream &aos) const
+    {
+        ABORT_IF_NOT_ON_MAIN_THREAD();
+
+        aos << "Running Tasks:\n";
+        if (m_tasks.empty()) {
+            aos << " (none)\n";
+        }
+        for (const auto &task : m_tasks) {
+            formatTaskNameId(aos, task);
+            aos << " [elapsed: ";
+            formatElapsedSeconds(aos, task.getElapsedTime());
+            aos << "]\n";
+            formatReport(aos, task.getProgressCounter().getReport());
+        }
+
+        aos << "Recently Finished Tasks:\n";
+        if (m_finished.empty()) {
+            aos << " (none)\n";
+        }
+        for (const auto &finished : m_finished) {
+            formatFinished(aos, finished);
+        }
+    }
+
+private:
+    static void formatFinished(AnsiOstream &aos, const FinishedTask &finished)
+    {
+        formatTaskNameId(aos, TaskNameIdType{finished.name, finished.id, finished.type});
+        aos << " took ";
+        formatElapsedSeconds(aos, finished.elapsed);
+        aos << ":\n";
+        formatReport(aos, finished.report);
+    }
+
+    void recordFinished(const AsyncTaskHandle &task)
+    {
+        FinishedTask finished{task.getName(),
+                              task.getId(),
+                              task.getType(),
+                              task.getElapsedTime(),
+                              task.getProgressCounter().getReport()};
+        global::logOnly(global::LogDestEnum::Info, [&finished](AnsiOstream &aos) {
+            formatFinished(aos, finished);
+        });
+
+        m_finished.emplace_back(std::move(finished));
+        while (m_finished.size() > g_max_finished_reports) {
+            m_finished.pop_front();
+        }
+    }
+
+public:
     void cancelAll()
     {
         for (auto &task : m_tasks) {
@@ -652,10 +767,11 @@ class NODISCARD AsyncTasks final
     void filterTasks()
     {
         // ABORT_IF_NOT_ON_MAIN_THREAD();
-        std::ignore = utils::listRemoveIf(m_tasks, [](const AsyncTaskHandle &task) -> bool {
+        std::ignore = utils::listRemoveIf(m_tasks, [this](const AsyncTaskHandle &task) -> bool {
             if (task.isRunningOnBackgroundThread()) {
                 return false;
             }
+            recordFinished(task);
             task.onRemoved(Badge<AsyncTasks>{});
             return true;
         });
@@ -789,6 +905,12 @@ void report_status(AnsiOstream &aos, size_t id)
     deref(g_tasks).reportStatus(aos, id);
 }
 
+void report_stats(AnsiOstream &aos)
+{
+    ABORT_IF_NOT_ON_MAIN_THREAD();
+    deref(g_tasks).reportStats(aos);
+}
+
 void cancel_all()
 {
     ABORT_IF_NOT_ON_MAIN_THREAD();
@@ -107,6 +107,8 @@ NODISCARD extern AsyncTaskHandle startAsyncTask2(AsyncTaskTypeEnum type,
 
 extern void report_status(AnsiOstream &aos);
 extern void report_status(AnsiOstream &aos, size_t id);
+// per-phase timings and memory usage for running and recently finished tasks
+extern void report_stats(AnsiOstream &aos);
 extern void cancel_all();
 NODISCARD extern bool cancel(AnsiOstream &aos, size_t id);
 extern void for_each(const std::function<void(const AsyncTaskHandle &)> &);
@@ -114,5 +116,6 @@ extern void for_each_status(
     const std::function<void(size_t id, std::string_view name, const ProgressCounter::Status &)> &);
 
 void formatElapsedSeconds(AnsiOstream &aos, const Clock::duration dt);
+void formatReport(AnsiOstream &aos, const ProgressCounter::Report &report);
 
 } // namespace async_tasks
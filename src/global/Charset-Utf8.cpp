@@ -3,6 +3,7 @@
 
 #include "Charset.h"
 #include "Consts.h"
+#include "SimdUtils.h"
 #include "TextUtils.h"
 #include "entities.h"
 
@@ -44,37 +45,14 @@ void latin1ToUtf8(std::ostream &os, const char c)
 void latin1ToUtf8(std::ostream &os, std::string_view sv)
 {
     assert(isAscii(sv) || !isValidUtf8(sv));
-    if ((false)) {
-        if (isAscii(sv)) {
-            os << sv;
-            return;
-        }
-        for (const char c : sv) {
-            latin1ToUtf8(os, c);
-        }
-    } else {
-        const auto asc = static_cast<bool (*)(char)>(isAscii);
-        while (!sv.empty()) {
-            const auto beg = sv.begin();
-            const auto end = sv.end();
-            const auto first_non_ascii = std::find_if_not(beg, end, asc);
-            if (first_non_ascii != beg) {
-                // ascii
-                const auto len = static_cast<size_t>(first_non_ascii - beg);
-                os << sv.substr(0, len);
-                sv.remove_prefix(len);
-            } else {
-                // non-ascii
-                assert(first_non_ascii == beg);
-                assert(first_non_ascii != end);
-                const auto it = std::find_if(std::next(first_non_ascii), end, asc);
-                const auto len = static_cast<size_t>(it - beg);
-                for (char c : sv.substr(0, len)) {
-                    latin1ToUtf8(os, c);
-                }
-                sv.remove_prefix(len);
-            }
+    while (!sv.empty()) {
+        if (const size_t len = simd_utils::countLeadingAscii(sv); len != 0) {
+            os.write(sv.data(), static_cast<std::streamsize>(len));
+            sv.remove_prefix(len);
+            continue;
         }
+        latin1ToUtf8(os, sv.front());
+        sv.remove_prefix(1);
     }
 }
 
@@ -549,19 +527,18 @@ NODISCARD static constexpr bool is7bit(const char c) noexcept
 {
     return (static_cast<uint8_t>(c) & 0x80u) == 0u;
 }
-NODISCARD static constexpr bool is7bit(const std::string_view sv) noexcept
-{
-    return std::all_of(sv.begin(), sv.end(), [](char c) { return is7bit(c); });
-}
 
-NODISCARD static constexpr Utf8ValidationEnum validateUtf8(std::string_view sv) noexcept
+// The skipAscii callback returns the length of the ASCII prefix of its argument.
+template<typename SkipAscii>
+NODISCARD static constexpr Utf8ValidationEnum validateUtf8(std::string_view sv,
+                                                           SkipAscii &&skipAscii) noexcept
 {
-    if (is7bit(sv)) {
-        return Utf8ValidationEnum::Valid;
-    }
-
     bool containsInvalidEncodings = false;
     while (!sv.empty()) {
+        sv.remove_prefix(skipAscii(sv));
+        if (sv.empty()) {
+            break;
+        }
         auto opt = conversion::conversion_detail::try_match_utf8(sv);
         if (opt.num_bytes == 0) {
             return Utf8ValidationEnum::ContainsErrors;
@@ -588,6 +565,15 @@ NODISCARD static constexpr Utf8ValidationEnum validateUtf8(std::string_view sv)
                                     : Utf8ValidationEnum::Valid;
 }
 
+NODISCARD static constexpr Utf8ValidationEnum validateUtf8(const std::string_view sv) noexcept
+{
+    return validateUtf8(sv, [](const std::string_view rest) -> size_t {
+        return static_cast<size_t>(
+            std::find_if_not(rest.begin(), rest.end(), [](char c) { return is7bit(c); })
+            - rest.begin());
+    });
+}
+
 NODISCARD static constexpr bool isValidUtf8(std::string_view sv)
 {
     return validateUtf8(sv) == Utf8ValidationEnum::Valid;
@@ -646,7 +632,7 @@ static_assert(hasErrors("\xFF"));                     // not valid anywhere
 
 NODISCARD Utf8ValidationEnum validateUtf8(const std::string_view sv) noexcept
 {
-    return charset_detail::validateUtf8(sv);
+    return charset_detail::validateUtf8(sv, simd_utils::countLeadingAscii);
 }
 
 NODISCARD bool isValidUtf8(const std::string_view sv) noexcept
@@ -900,6 +886,40 @@ NODISCARD OptionalEncodedUtf8Codepoint try_encode_utf8_unchecked(const char32_t
     return conversion_detail::try_encode_utf8_unchecked(codepoint, bytes);
 }
 
+namespace { // anonymous
+// Copies runs of ASCII straight through, and only decodes the bytes between them.
+//
+// An ASCII byte can never be part of a multi-byte codepoint, so splitting the input there
+// doesn't change how invalid sequences are reported.
+template<typename Inserter>
+void utf8ToBasicCharset(std::ostream &os, std::string_view sv)
+{
+    while (!sv.empty()) {
+        if (const size_t len = simd_utils::countLeadingAscii(sv); len != 0) {
+            os.write(sv.data(), static_cast<std::streamsize>(len));
+            sv.remove_prefix(len);
+            continue;
+        }
+        const auto it = std::find_if(std::next(sv.begin()), sv.end(), [](char c) {
+            return isAscii(c);
+        });
+        const auto len = static_cast<size_t>(it - sv.begin());
+        foreach_codepoint_utf8(sv.substr(0, len), Inserter{os});
+        sv.remove_prefix(len);
+    }
+}
+} // namespace
+
+void utf8ToAscii(std::ostream &os, const std::string_view sv)
+{
+    utf8ToBasicCharset<InsertAscii>(os, sv);
+}
+
+void utf8ToLatin1(std::ostream &os, const std::string_view sv)
+{
+    utf8ToBasicCharset<InsertLatin1>(os, sv);
+}
+
 std::string utf8ToAscii(const std::string_view sv)
 {
     assert(isValidUtf8(sv));
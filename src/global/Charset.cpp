@@ -5,6 +5,7 @@
 
 #include "ConfigConsts.h"
 #include "Consts.h"
+#include "SimdUtils.h"
 #include "TextUtils.h"
 #include "entities.h"
 #include "parserutils.h"
@@ -196,6 +197,10 @@ MAYBE_UNUSED NODISCARD static inline constexpr char32_t windows125x_to_unicode(c
 // codepoint if we're converting to Latin-1 or simply filtering unicode.
 NODISCARD static constexpr char16_t simple_unicode_translit(const char16_t input) noexcept
 {
+    if (static_cast<size_t>(input) < NUM_ASCII_CODEPOINTS) {
+        return input;
+    }
+
 #define XCASE(_unicode, _ascii, _name) \
     case (_unicode): \
         return conversion::to_char16(_ascii)
@@ -269,7 +274,7 @@ NODISCARD bool isAscii(const char c) noexcept
 }
 NODISCARD bool isAscii(const std::string_view sv) noexcept
 {
-    return std::all_of(sv.begin(), sv.end(), [](char c) { return isAscii(c); });
+    return simd_utils::countLeadingAscii(sv) == sv.size();
 }
 
 namespace conversion {
@@ -280,10 +285,11 @@ NODISCARD char latin1ToAscii(const char c) noexcept
 
 std::string &latin1ToAsciiInPlace(std::string &str) noexcept
 {
-    for (char &c : str) {
-        if (!charset::isAscii(c)) {
-            c = latin1ToAscii(c);
-        }
+    const size_t len = str.size();
+    for (size_t i = simd_utils::countLeadingAscii(str); i < len;) {
+        str[i] = latin1ToAscii(str[i]);
+        ++i;
+        i += simd_utils::countLeadingAscii(std::string_view{str}.substr(i));
     }
     return str;
 }
@@ -390,13 +396,16 @@ NODISCARD std::string latin1ToAscii(const std::string_view sv)
     return tmp;
 }
 
-void latin1ToAscii(std::ostream &os, const std::string_view sv)
+void latin1ToAscii(std::ostream &os, std::string_view sv)
 {
-    for (char c : sv) {
-        if (!charset::isAscii(c)) {
-            c = latin1ToAscii(c);
+    while (!sv.empty()) {
+        if (const size_t len = simd_utils::countLeadingAscii(sv); len != 0) {
+            os.write(sv.data(), static_cast<std::streamsize>(len));
+            sv.remove_prefix(len);
+            continue;
         }
-        os << c;
+        os.put(latin1ToAscii(sv.front()));
+        sv.remove_prefix(1);
     }
 }
 } // namespace conversion
@@ -1093,6 +1102,32 @@ void testMmqtLatin1()
     }
 }
 
+void testAsciiRuns()
+{
+    using namespace charset::conversion;
+
+    // long enough that the vectorized scan stops partway through a run
+    const std::string pad(40, 'x');
+    const std::string utf8 = pad + "caf\xC3\xA9 " + pad + "\xE2\x80\x94" + pad;
+    TEST_ASSERT(charset::isValidUtf8(utf8));
+    TEST_ASSERT(!charset::isAscii(utf8));
+    TEST_ASSERT(charset::isAscii(pad + pad));
+    TEST_ASSERT(utf8ToLatin1(utf8) == pad + "caf\xE9 " + pad + "-" + pad);
+    TEST_ASSERT(utf8ToAscii(utf8) == pad + "cafe " + pad + "-" + pad);
+    TEST_ASSERT(latin1ToUtf8(pad + "caf\xE9 " + pad) == pad + "caf\xC3\xA9 " + pad);
+    TEST_ASSERT(latin1ToAscii(pad + "\xAB" + pad + "\xFF") == pad + "<" + pad + "y");
+
+    std::string inPlace = pad + "\xBB" + pad;
+    TEST_ASSERT(latin1ToAsciiInPlace(inPlace) == pad + ">" + pad);
+
+    // a truncated codepoint doesn't swallow the ASCII that follows it
+    const std::string truncated = pad + "\xC3" + pad;
+    TEST_ASSERT(charset::validateUtf8(truncated) == charset::Utf8ValidationEnum::ContainsErrors);
+    std::ostringstream oss;
+    utf8ToLatin1(oss, truncated);
+    TEST_ASSERT(oss.str() == pad + "?" + pad);
+}
+
 } // namespace
 
 namespace test {
@@ -1101,6 +1136,7 @@ void testCharset()
     testAsciiCharTypes();
     testStrings();
     testMmqtLatin1();
+    testAsciiRuns();
 
     volatile bool use_extreme_roundtrip_test = false; // (this test is very slow)
     if (use_extreme_roundtrip_test) {
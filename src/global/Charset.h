@@ -679,16 +679,6 @@ using conversion_detail::Latin1StringBuilder;
 using conversion_detail::Latin1StringBuilderUnfriendly;
 using conversion_detail::Utf8StringBuilder;
 
-inline void utf8ToAscii(std::ostream &os, const std::string_view sv)
-{
-    foreach_codepoint_utf8(sv, InsertAscii{os});
-}
-
-inline void utf8ToLatin1(std::ostream &os, const std::string_view sv)
-{
-    foreach_codepoint_utf8(sv, InsertLatin1{os});
-}
-
 NODISCARD std::string utf8ToAscii(std::string_view sv);
 NODISCARD std::string utf8ToLatin1(std::string_view sv);
 } // namespace conversion
@@ -0,0 +1,717 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "JsonView.h"
+
+#include "Charset.h"
+#include "Consts.h"
+#include "tests.h"
+
+#include <cassert>
+#include <limits>
+
+using namespace char_consts;
+
+namespace { // anonymous
+
+// Deeper documents are rejected instead of risking the stack.
+constexpr int MAX_DEPTH = 64;
+
+struct NODISCARD ScannedValue final
+{
+    JsonValueView value;
+    size_t end = 0;
+};
+
+NODISCARD bool isJsonSpace(const char c)
+{
+    return c == C_SPACE || c == C_TAB || c == C_NEWLINE || c == C_CARRIAGE_RETURN;
+}
+
+NODISCARD size_t skipSpace(const std::string_view sv, size_t pos)
+{
+    while (pos < sv.size() && isJsonSpace(sv[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+NODISCARD bool isHexDigit(const char c)
+{
+    return charset::ascii::isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+NODISCARD uint32_t hexValue(const char c)
+{
+    if (charset::ascii::isDigit(c)) {
+        return static_cast<uint32_t>(c - '0');
+    }
+    return static_cast<uint32_t>((c | 0x20) - 'a') + 10u;
+}
+
+// pos is at the opening quote; returns the position after the closing quote.
+NODISCARD std::optional<size_t> skipString(const std::string_view sv, size_t pos)
+{
+    assert(sv[pos] == C_DQUOTE);
+    for (++pos; pos < sv.size(); ++pos) {
+        const char c = sv[pos];
+        if (c == C_DQUOTE) {
+            return pos + 1;
+        } else if (static_cast<uint8_t>(c) < 0x20) {
+            return std::nullopt;
+        } else if (c != C_BACKSLASH) {
+            continue;
+        }
+
+        if (++pos == sv.size()) {
+            return std::nullopt;
+        }
+        switch (sv[pos]) {
+        case C_DQUOTE:
+        case C_BACKSLASH:
+        case C_SLASH:
+        case 'b':
+        case 'f':
+        case 'n':
+        case 'r':
+        case 't':
+            break;
+        case 'u':
+            if (sv.size() - pos <= 4) {
+                return std::nullopt;
+            }
+            for (size_t i = 1; i <= 4; ++i) {
+                if (!isHexDigit(sv[pos + i])) {
+                    return std::nullopt;
+                }
+            }
+            pos += 4;
+            break;
+        default:
+            return std::nullopt;
+        }
+    }
+    return std::nullopt;
+}
+
+NODISCARD size_t skipDigits(const std::string_view sv, size_t pos)
+{
+    while (pos < sv.size() && charset::ascii::isDigit(sv[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+NODISCARD std::optional<size_t> skipNumber(const std::string_view sv, size_t pos)
+{
+    if (sv[pos] == C_MINUS_SIGN) {
+        ++pos;
+    }
+    if (pos == sv.size() || !charset::ascii::isDigit(sv[pos])) {
+        return std::nullopt;
+    }
+    pos = (sv[pos] == '0') ? pos + 1 : skipDigits(sv, pos);
+
+    if (pos < sv.size() && sv[pos] == C_PERIOD) {
+        const size_t start = ++pos;
+        pos = skipDigits(sv, pos);
+        if (pos == start) {
+            return std::nullopt;
+        }
+    }
+    if (pos < sv.size() && (sv[pos] == 'e' || sv[pos] == 'E')) {
+        ++pos;
+        if (pos < sv.size() && (sv[pos] == C_PLUS_SIGN || sv[pos] == C_MINUS_SIGN)) {
+            ++pos;
+        }
+        const size_t start = pos;
+        pos = skipDigits(sv, pos);
+        if (pos == start) {
+            return std::nullopt;
+        }
+    }
+    return pos;
+}
+
+NODISCARD std::optional<size_t> skipLiteral(const std::string_view sv,
+                                            const size_t pos,
+                                            const std::string_view literal)
+{
+    if (sv.substr(pos, literal.size()) != literal) {
+        return std::nullopt;
+    }
+    return pos + literal.size();
+}
+
+NODISCARD std::optional<ScannedValue> scanValue(std::string_view sv, size_t pos, int depth);
+
+// pos is at the opening bracket.
+NODISCARD std::optional<size_t> skipContainer(const std::string_view sv,
+                                              size_t pos,
+                                              const int depth,
+                                              const bool isObject)
+{
+    if (depth >= MAX_DEPTH) {
+        return std::nullopt;
+    }
+    const char close = isObject ? C_CLOSE_CURLY : C_CLOSE_BRACKET;
+
+    pos = skipSpace(sv, pos + 1);
+    if (pos < sv.size() && sv[pos] == close) {
+        return pos + 1;
+    }
+
+    while (pos < sv.size()) {
+        if (isObject) {
+            if (sv[pos] != C_DQUOTE) {
+                return std::nullopt;
+            }
+            const auto keyEnd = skipString(sv, pos);
+            if (!keyEnd) {
+                return std::nullopt;
+            }
+            pos = skipSpace(sv, *keyEnd);
+            if (pos == sv.size() || sv[pos] != C_COLON) {
+                return std::nullopt;
+            }
+            pos = skipSpace(sv, pos + 1);
+        }
+
+        const auto value = scanValue(sv, pos, depth + 1);
+        if (!value) {
+            return std::nullopt;
+        }
+        pos = skipSpace(sv, value->end);
+        if (pos == sv.size()) {
+            break;
+        } else if (sv[pos] == close) {
+            return pos + 1;
+        } else if (sv[pos] != C_COMMA) {
+            return std::nullopt;
+        }
+        pos = skipSpace(sv, pos + 1);
+    }
+    return std::nullopt;
+}
+
+// pos must be at the first character of the value (i.e. after any whitespace).
+NODISCARD std::optional<ScannedValue> scanValue(const std::string_view sv,
+                                                const size_t pos,
+                                                const int depth)
+{
+    if (pos >= sv.size()) {
+        return std::nullopt;
+    }
+
+    std::optional<size_t> end;
+    JsonViewTypeEnum type = JsonViewTypeEnum::Null;
+    switch (sv[pos]) {
+    case C_OPEN_CURLY:
+        end = skipContainer(sv, pos, depth, true);
+        type = JsonViewTypeEnum::Object;
+        break;
+    case C_OPEN_BRACKET:
+        end = skipContainer(sv, pos, depth, false);
+        type = JsonViewTypeEnum::Array;
+        break;
+    case C_DQUOTE:
+        end = skipString(sv, pos);
+        type = JsonViewTypeEnum::String;
+        break;
+    case 't':
+        end = skipLiteral(sv, pos, "true");
+        type = JsonViewTypeEnum::Bool;
+        break;
+    case 'f':
+        end = skipLiteral(sv, pos, "false");
+        type = JsonViewTypeEnum::Bool;
+        break;
+    case 'n':
+        end = skipLiteral(sv, pos, "null");
+        type = JsonViewTypeEnum::Null;
+        break;
+    default:
+        end = skipNumber(sv, pos);
+        type = JsonViewTypeEnum::Number;
+        break;
+    }
+
+    if (!end) {
+        return std::nullopt;
+    }
+    return ScannedValue{JsonValueView{sv.substr(pos, *end - pos), type}, *end};
+}
+
+// Decodes the inside of a string literal that's already known to be well-formed.
+NODISCARD std::string decodeString(const std::string_view inside)
+{
+    static constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFDu;
+    const auto parseHex4 = [&inside](const size_t pos) -> char32_t {
+        uint32_t result = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            result = (result << 4u) | hexValue(inside[pos + i]);
+        }
+        return static_cast<char32_t>(result);
+    };
+    const auto isHighSurrogate = [](const char32_t c) { return c >= 0xD800u && c <= 0xDBFFu; };
+    const auto isLowSurrogate = [](const char32_t c) { return c >= 0xDC00u && c <= 0xDFFFu; };
+
+    std::string result;
+    result.reserve(inside.size());
+    for (size_t pos = 0; pos < inside.size(); ++pos) {
+        const char c = inside[pos];
+        if (c != C_BACKSLASH) {
+            result += c;
+            continue;
+        }
+
+        const char escaped = inside[++pos];
+        switch (escaped) {
+        case 'b':
+            result += C_BACKSPACE;
+            break;
+        case 'f':
+            result += C_FORM_FEED;
+            break;
+        case 'n':
+            result += C_NEWLINE;
+            break;
+        case 'r':
+            result += C_CARRIAGE_RETURN;
+            break;
+        case 't':
+            result += C_TAB;
+            break;
+        case 'u': {
+            char32_t codepoint = parseHex4(pos + 1);
+            pos += 4;
+            if (isHighSurrogate(codepoint) && pos + 6 < inside.size()
+                && inside[pos + 1] == C_BACKSLASH && inside[pos + 2] == 'u') {
+                const char32_t low = parseHex4(pos + 3);
+                if (isLowSurrogate(low)) {
+                    codepoint = 0x10000u + ((codepoint - 0xD800u) << 10u) + (low - 0xDC00u);
+                    pos += 6;
+                }
+            }
+            if (isHighSurrogate(codepoint) || isLowSurrogate(codepoint)) {
+                codepoint = REPLACEMENT_CHARACTER;
+            }
+            if (const auto encoded = charset::conversion::try_encode_utf8(codepoint)) {
+                result += encoded.value();
+            }
+            break;
+        }
+        default:
+            // '"', '\\', and '/'
+            result += escaped;
+            break;
+        }
+    }
+    return result;
+}
+
+// Same rules as QJsonValue::toInt(); raw must be a well-formed number.
+NODISCARD int32_t toInt32(const std::string_view raw)
+{
+    size_t pos = 0;
+    const bool negative = raw[pos] == C_MINUS_SIGN;
+    if (negative) {
+        ++pos;
+    }
+
+    // The significant digits, and the power of 10 they're multiplied by.
+    std::string_view intDigits = raw.substr(pos, skipDigits(raw, pos) - pos);
+    pos += intDigits.size();
+    std::string_view fracDigits;
+    if (pos < raw.size() && raw[pos] == C_PERIOD) {
+        ++pos;
+        fracDigits = raw.substr(pos, skipDigits(raw, pos) - pos);
+        pos += fracDigits.size();
+    }
+    int64_t exponent = 0;
+    if (pos < raw.size()) {
+        assert(raw[pos] == 'e' || raw[pos] == 'E');
+        ++pos;
+        const bool negativeExponent = raw[pos] == C_MINUS_SIGN;
+        if (negativeExponent || raw[pos] == C_PLUS_SIGN) {
+            ++pos;
+        }
+        for (; pos < raw.size(); ++pos) {
+            // anything this large is out of range (or zero) anyway
+            exponent = std::min<int64_t>(exponent * 10 + (raw[pos] - '0'), 1000);
+        }
+        if (negativeExponent) {
+            exponent = -exponent;
+        }
+    }
+
+    while (!fracDigits.empty() && fracDigits.back() == '0') {
+        fracDigits.remove_suffix(1);
+    }
+    exponent -= static_cast<int64_t>(fracDigits.size());
+    while (!intDigits.empty() && intDigits.front() == '0') {
+        intDigits.remove_prefix(1);
+    }
+
+    int64_t value = 0;
+    const auto append = [&value](const char c) -> bool {
+        value = value * 10 + (c - '0');
+        return value <= static_cast<int64_t>(std::numeric_limits<int32_t>::max()) + 1;
+    };
+    for (const char c : intDigits) {
+        if (!append(c)) {
+            return 0;
+        }
+    }
+    for (const char c : fracDigits) {
+        if (!append(c)) {
+            return 0;
+        }
+    }
+    if (value != 0) {
+        for (; exponent < 0; ++exponent) {
+            if (value % 10 != 0) {
+                return 0;
+            }
+            value /= 10;
+        }
+        for (; exponent > 0; --exponent) {
+            if (!append('0')) {
+                return 0;
+            }
+        }
+    }
+
+    if (negative) {
+        value = -value;
+    }
+    if (value > std::numeric_limits<int32_t>::max() || value < std::numeric_limits<int32_t>::min()) {
+        return 0;
+    }
+    return static_cast<int32_t>(value);
+}
+
+} // namespace
+
+std::optional<JsonValueView> JsonValueView::parse(const std::string_view json)
+{
+    const auto scanned = scanValue(json, skipSpace(json, 0), 0);
+    if (!scanned || skipSpace(json, scanned->end) != json.size()) {
+        return std::nullopt;
+    }
+    return scanned->value;
+}
+
+std::optional<bool> JsonValueView::getBool() const
+{
+    if (m_type != JsonViewTypeEnum::Bool) {
+        return std::nullopt;
+    }
+    return m_raw.front() == 't';
+}
+
+std::optional<int32_t> JsonValueView::getInt() const
+{
+    if (m_type != JsonViewTypeEnum::Number) {
+        return std::nullopt;
+    }
+    return toInt32(m_raw);
+}
+
+std::optional<std::string> JsonValueView::getString() const
+{
+    if (m_type != JsonViewTypeEnum::String) {
+        return std::nullopt;
+    }
+    const auto inside = m_raw.substr(1, m_raw.size() - 2);
+    if (inside.find(C_BACKSLASH) == std::string_view::npos) {
+        return std::string{inside};
+    }
+    return decodeString(inside);
+}
+
+std::optional<std::string_view> JsonValueView::getStringView() const
+{
+    if (m_type != JsonViewTypeEnum::String) {
+        return std::nullopt;
+    }
+    const auto inside = m_raw.substr(1, m_raw.size() - 2);
+    if (inside.find(C_BACKSLASH) != std::string_view::npos) {
+        return std::nullopt;
+    }
+    return inside;
+}
+
+std::optional<JsonArrayView> JsonValueView::getArray() const
+{
+    if (m_type != JsonViewTypeEnum::Array) {
+        return std::nullopt;
+    }
+    return JsonArrayView{m_raw};
+}
+
+std::optional<JsonObjView> JsonValueView::getObject() const
+{
+    if (m_type != JsonViewTypeEnum::Object) {
+        return std::nullopt;
+    }
+    return JsonObjView{m_raw};
+}
+
+JsonArrayView::Iterator::Iterator(const std::string_view raw, const size_t pos)
+    : m_raw{raw}
+    , m_pos{raw.size()}
+{
+    if (pos >= raw.size()) {
+        return;
+    }
+    assert(pos == 0 && raw.front() == C_OPEN_BRACKET);
+    const size_t first = skipSpace(raw, 1);
+    if (first < raw.size() && raw[first] != C_CLOSE_BRACKET) {
+        if (const auto scanned = scanValue(raw, first, 0)) {
+            m_pos = first;
+            m_current = scanned->value;
+        }
+    }
+}
+
+JsonArrayView::Iterator &JsonArrayView::Iterator::operator++()
+{
+    const auto &current = m_current.value();
+    size_t pos = skipSpace(m_raw, m_pos + current.getRaw().size());
+    m_pos = m_raw.size();
+    m_current.reset();
+
+    if (pos < m_raw.size() && m_raw[pos] == C_COMMA) {
+        pos = skipSpace(m_raw, pos + 1);
+        if (const auto scanned = scanValue(m_raw, pos, 0)) {
+            m_pos = pos;
+            m_current = scanned->value;
+        }
+    }
+    return *this;
+}
+
+size_t JsonArrayView::size() const
+{
+    size_t result = 0;
+    for (auto it = begin(), last = end(); it != last; ++it) {
+        ++result;
+    }
+    return result;
+}
+
+JsonObjView::Iterator::Iterator(const std::string_view raw, const size_t pos)
+    : m_raw{raw}
+    , m_pos{raw.size()}
+{
+    if (pos >= raw.size()) {
+        return;
+    }
+    assert(pos == 0 && raw.front() == C_OPEN_CURLY);
+
+    // Parse the first member the same way operator++ parses the rest.
+    m_pos = 0;
+    m_key = raw.substr(0, 0);
+    m_value = JsonValueView{raw.substr(1, 0), JsonViewTypeEnum::Null};
+    ++*this;
+}
+
+JsonObjView::Iterator &JsonObjView::Iterator::operator++()
+{
+    // m_pos is at the key's opening quote (or at the opening curly for begin()).
+    const auto &value = m_value.value();
+    const size_t valueEnd = static_cast<size_t>(value.getRaw().data() - m_raw.data())
+                            + value.getRaw().size();
+    const bool isFirst = m_pos == 0;
+
+    size_t pos = skipSpace(m_raw, valueEnd);
+    m_pos = m_raw.size();
+    m_key = {};
+    m_value.reset();
+
+    if (!isFirst) {
+        if (pos == m_raw.size() || m_raw[pos] != C_COMMA) {
+            return *this;
+        }
+        pos = skipSpace(m_raw, pos + 1);
+    }
+    if (pos == m_raw.size() || m_raw[pos] != C_DQUOTE) {
+        return *this;
+    }
+
+    const auto keyEnd = skipString(m_raw, pos);
+    if (!keyEnd) {
+        return *this;
+    }
+    size_t valuePos = skipSpace(m_raw, *keyEnd);
+    if (valuePos == m_raw.size() || m_raw[valuePos] != C_COLON) {
+        return *this;
+    }
+    valuePos = skipSpace(m_raw, valuePos + 1);
+    if (const auto scanned = scanValue(m_raw, valuePos, 0)) {
+        m_pos = pos;
+        m_key = m_raw.substr(pos + 1, *keyEnd - pos - 2);
+        m_value = scanned->value;
+    }
+    return *this;
+}
+
+std::optional<JsonValueView> JsonObjView::get(const std::string_view key) const
+{
+    for (auto it = begin(), last = end(); it != last; ++it) {
+        const std::string_view rawKey = it.rawKey();
+        if (rawKey == key) {
+            return it.value();
+        }
+        if (rawKey.find(C_BACKSLASH) != std::string_view::npos && decodeString(rawKey) == key) {
+            return it.value();
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<JsonArrayView> JsonObjView::getArray(const std::string_view key) const
+{
+    if (const auto value = get(key)) {
+        return value->getArray();
+    }
+    return std::nullopt;
+}
+
+std::optional<bool> JsonObjView::getBool(const std::string_view key) const
+{
+    if (const auto value = get(key)) {
+        return value->getBool();
+    }
+    return std::nullopt;
+}
+
+std::optional<int32_t> JsonObjView::getInt(const std::string_view key) const
+{
+    if (const auto value = get(key)) {
+        return value->getInt();
+    }
+    return std::nullopt;
+}
+
+bool JsonObjView::isNull(const std::string_view key) const
+{
+    const auto value = get(key);
+    return value.has_value() && value->isNull();
+}
+
+std::optional<JsonObjView> JsonObjView::getObject(const std::string_view key) const
+{
+    if (const auto value = get(key)) {
+        return value->getObject();
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string> JsonObjView::getString(const std::string_view key) const
+{
+    if (const auto value = get(key)) {
+        return value->getString();
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string_view> JsonObjView::getStringView(const std::string_view key) const
+{
+    if (const auto value = get(key)) {
+        return value->getStringView();
+    }
+    return std::nullopt;
+}
+
+void test::testJsonView()
+{
+    {
+        TEST_ASSERT(!JsonValueView::parse(""));
+        TEST_ASSERT(!JsonValueView::parse("{"));
+        TEST_ASSERT(!JsonValueView::parse("[1,]"));
+        TEST_ASSERT(!JsonValueView::parse("{\"a\":1,}"));
+        TEST_ASSERT(!JsonValueView::parse("{\"a\" 1}"));
+        TEST_ASSERT(!JsonValueView::parse("01"));
+        TEST_ASSERT(!JsonValueView::parse("1."));
+        TEST_ASSERT(!JsonValueView::parse("\"\\x\""));
+        TEST_ASSERT(!JsonValueView::parse("tru"));
+        TEST_ASSERT(!JsonValueView::parse("1 2"));
+        TEST_ASSERT(!JsonValueView::parse(std::string(MAX_DEPTH + 1, C_OPEN_BRACKET)
+                                          + std::string(MAX_DEPTH + 1, C_CLOSE_BRACKET)));
+        TEST_ASSERT(JsonValueView::parse(std::string(MAX_DEPTH, C_OPEN_BRACKET)
+                                         + std::string(MAX_DEPTH, C_CLOSE_BRACKET)));
+    }
+
+    {
+        // payloads like this arrive several times a second
+        const auto doc = JsonValueView::parse(
+            " {\"hp\":100,\"maxhp\":120, \"fog\":null,\"light\":\"*\",\"mount\":false,"
+            "\"ride\":true,\"exits\":{\"n\":{\"id\":7,\"flags\":[\"road\",\"door\"]}}} ");
+        TEST_ASSERT(doc && doc->getType() == JsonViewTypeEnum::Object);
+        const auto obj = doc->getObject().value();
+        TEST_ASSERT(obj.getInt("hp") == 100);
+        TEST_ASSERT(obj.getInt("maxhp") == 120);
+        TEST_ASSERT(!obj.getInt("fog"));
+        TEST_ASSERT(obj.isNull("fog"));
+        TEST_ASSERT(!obj.isNull("light"));
+        TEST_ASSERT(obj.getStringView("light") == "*");
+        TEST_ASSERT(obj.getBool("mount") == false);
+        TEST_ASSERT(obj.getBool("ride") == true);
+        TEST_ASSERT(!obj.contains("missing"));
+
+        const auto flags = obj.getObject("exits")->getObject("n")->getArray("flags").value();
+        TEST_ASSERT(flags.size() == 2);
+        std::string joined;
+        for (const JsonValueView &flag : flags) {
+            joined += flag.getString().value();
+        }
+        TEST_ASSERT(joined == "roaddoor");
+
+        size_t members = 0;
+        for (auto it = obj.begin(); it != obj.end(); ++it) {
+            ++members;
+        }
+        TEST_ASSERT(members == 7);
+    }
+
+    {
+        const auto empty = JsonValueView::parse("[ ]")->getArray().value();
+        TEST_ASSERT(empty.empty() && empty.size() == 0);
+        TEST_ASSERT(JsonValueView::parse("{}")->getObject()->empty());
+        TEST_ASSERT(JsonValueView::parse("[[],{},\"\"]")->getArray()->size() == 3);
+    }
+
+    {
+        // same results as QJsonValue::toInt()
+        const auto toInt = [](const char *const json) -> int32_t {
+            return JsonValueView::parse(json)->getInt().value();
+        };
+        TEST_ASSERT(toInt("0") == 0);
+        TEST_ASSERT(toInt("-0") == 0);
+        TEST_ASSERT(toInt("42") == 42);
+        TEST_ASSERT(toInt("-42") == -42);
+        TEST_ASSERT(toInt("2147483647") == 2147483647);
+        TEST_ASSERT(toInt("-2147483648") == std::numeric_limits<int32_t>::min());
+        TEST_ASSERT(toInt("2147483648") == 0);
+        TEST_ASSERT(toInt("99999999999999999999") == 0);
+        TEST_ASSERT(toInt("1.0") == 1);
+        TEST_ASSERT(toInt("1.5") == 0);
+        TEST_ASSERT(toInt("1e2") == 100);
+        TEST_ASSERT(toInt("1.25E2") == 125);
+        TEST_ASSERT(toInt("1500e-2") == 15);
+        TEST_ASSERT(toInt("1e-2") == 0);
+        TEST_ASSERT(toInt("0e999") == 0);
+        TEST_ASSERT(toInt("1e999") == 0);
+    }
+
+    {
+        const auto str = JsonValueView::parse(R"("a\"b\\c\/d\n\u00e9\ud83d\udc4d\ud800")").value();
+        TEST_ASSERT(!str.getStringView());
+        TEST_ASSERT(str.getString() == "a\"b\\c/d\n\u00E9\U0001F44D\uFFFD");
+
+        const auto obj = JsonValueView::parse(R"({"na\u006De":"Gandalf"})")->getObject().value();
+        TEST_ASSERT(obj.getStringView("name") == "Gandalf");
+    }
+}
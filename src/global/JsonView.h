@@ -0,0 +1,154 @@
+#pragma once
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "macros.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+class JsonArrayView;
+class JsonObjView;
+
+enum class NODISCARD JsonViewTypeEnum : uint8_t { Null, Bool, Number, String, Array, Object };
+
+// Read-only views of UTF-8 JSON text that never build a document.
+//
+// Objects and arrays are scanned on demand each time they're accessed, so a lookup costs
+// one pass over the members that precede it. That's cheaper than parsing the whole payload
+// for the small GMCP messages that arrive several times a second (e.g. Char.Vitals), and
+// nothing is allocated except when a string containing escapes has to be decoded.
+//
+// CAUTION: Views point into the original text, which must outlive them.
+class NODISCARD JsonValueView final
+{
+private:
+    std::string_view m_raw;
+    JsonViewTypeEnum m_type = JsonViewTypeEnum::Null;
+
+public:
+    JsonValueView() = delete;
+    explicit JsonValueView(const std::string_view raw, const JsonViewTypeEnum type)
+        : m_raw{raw}
+        , m_type{type}
+    {}
+
+public:
+    // Returns nullopt unless the text is exactly one well-formed JSON value,
+    // optionally surrounded by whitespace.
+    NODISCARD static std::optional<JsonValueView> parse(std::string_view json);
+
+public:
+    NODISCARD JsonViewTypeEnum getType() const { return m_type; }
+    NODISCARD std::string_view getRaw() const { return m_raw; }
+    NODISCARD bool isNull() const { return m_type == JsonViewTypeEnum::Null; }
+
+public:
+    NODISCARD std::optional<bool> getBool() const;
+    // Same rules as QJsonValue::toInt(): numbers that aren't integral,
+    // or don't fit in 32 bits, are reported as 0.
+    NODISCARD std::optional<int32_t> getInt() const;
+    // Decoded UTF-8.
+    NODISCARD std::optional<std::string> getString() const;
+    // Returns nullopt for a string with any escape in it (e.g. the JSON string "\""), so only use
+    // it where such a value could never match anyway; see getString().
+    NODISCARD std::optional<std::string_view> getStringView() const;
+    NODISCARD std::optional<JsonArrayView> getArray() const;
+    NODISCARD std::optional<JsonObjView> getObject() const;
+};
+
+class NODISCARD JsonArrayView final
+{
+private:
+    std::string_view m_raw;
+
+public:
+    class NODISCARD Iterator final
+    {
+    private:
+        std::string_view m_raw;
+        size_t m_pos = 0;
+        std::optional<JsonValueView> m_current;
+
+    public:
+        explicit Iterator(std::string_view raw, size_t pos);
+
+    public:
+        NODISCARD const JsonValueView &operator*() const { return m_current.value(); }
+        ALLOW_DISCARD Iterator &operator++();
+        Iterator operator++(int) = delete;
+        NODISCARD bool operator==(const Iterator &other) const { return m_pos == other.m_pos; }
+        NODISCARD bool operator!=(const Iterator &other) const { return !operator==(other); }
+    };
+
+public:
+    // The raw text must be a well-formed array; use JsonValueView::getArray().
+    explicit JsonArrayView(const std::string_view raw)
+        : m_raw{raw}
+    {}
+
+public:
+    NODISCARD Iterator begin() const { return Iterator{m_raw, 0}; }
+    NODISCARD Iterator end() const { return Iterator{m_raw, m_raw.size()}; }
+    NODISCARD bool empty() const { return begin() == end(); }
+    NODISCARD size_t size() const;
+};
+
+class NODISCARD JsonObjView final
+{
+private:
+    std::string_view m_raw;
+
+public:
+    class NODISCARD Iterator final
+    {
+    private:
+        std::string_view m_raw;
+        size_t m_pos = 0;
+        std::string_view m_key;
+        std::optional<JsonValueView> m_value;
+
+    public:
+        explicit Iterator(std::string_view raw, size_t pos);
+
+    public:
+        // The key exactly as it's written, without the quotes (escapes aren't decoded).
+        NODISCARD std::string_view rawKey() const { return m_key; }
+        NODISCARD const JsonValueView &value() const { return m_value.value(); }
+        ALLOW_DISCARD Iterator &operator++();
+        Iterator operator++(int) = delete;
+        NODISCARD bool operator==(const Iterator &other) const { return m_pos == other.m_pos; }
+        NODISCARD bool operator!=(const Iterator &other) const { return !operator==(other); }
+    };
+
+public:
+    // The raw text must be a well-formed object; use JsonValueView::getObject().
+    explicit JsonObjView(const std::string_view raw)
+        : m_raw{raw}
+    {}
+
+public:
+    NODISCARD Iterator begin() const { return Iterator{m_raw, 0}; }
+    NODISCARD Iterator end() const { return Iterator{m_raw, m_raw.size()}; }
+    NODISCARD bool empty() const { return begin() == end(); }
+
+public:
+    // If a key appears more than once, the first one wins.
+    NODISCARD std::optional<JsonValueView> get(std::string_view key) const;
+    NODISCARD bool contains(const std::string_view key) const { return get(key).has_value(); }
+
+    NODISCARD std::optional<JsonArrayView> getArray(std::string_view key) const;
+    NODISCARD std::optional<bool> getBool(std::string_view key) const;
+    NODISCARD std::optional<int32_t> getInt(std::string_view key) const;
+    NODISCARD bool isNull(std::string_view key) const;
+    NODISCARD std::optional<JsonObjView> getObject(std::string_view key) const;
+    NODISCARD std::optional<std::string> getString(std::string_view key) const;
+    NODISCARD std::optional<std::string_view> getStringView(std::string_view key) const;
+};
+
+namespace test {
+extern void testJsonView();
+} // namespace test
@@ -0,0 +1,317 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "PerfStats.h"
+
+#include "AnsiOstream.h"
+#include "AnsiTextUtils.h"
+#include "TextUtils.h"
+#include "tests.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace perf_stats {
+
+namespace { // anonymous
+
+constexpr auto green = getRawAnsi(AnsiColor16Enum::green);
+constexpr auto yellow = getRawAnsi(AnsiColor16Enum::yellow);
+
+std::array<LatencyHistogram, NUM_PERF_STAGES> g_histograms;
+
+NODISCARD LatencyHistogram &getHistogram(const PerfStageEnum stage)
+{
+    return g_histograms[static_cast<size_t>(stage)];
+}
+
+NODISCARD std::string formatUs(const double us)
+{
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(1) << us;
+    return std::move(os).str();
+}
+
+NODISCARD std::string formatBucketName(const size_t bucket)
+{
+    if (bucket == 0) {
+        return "<1 us";
+    }
+    const auto lo = LatencyHistogram::getBucketUpperBoundUs(bucket - 1);
+    if (bucket + 1 == NUM_BUCKETS) {
+        return ">=" + std::to_string(lo) + " us";
+    }
+    const auto hi = LatencyHistogram::getBucketUpperBoundUs(bucket);
+    return std::to_string(lo) + "-" + std::to_string(hi) + " us";
+}
+
+#define X_CASE(_Enum, _key, _description) PerfStageEnum::_Enum,
+constexpr const std::array<PerfStageEnum, NUM_PERF_STAGES> ALL_PERF_STAGES{
+    XFOREACH_PERF_STAGE(X_CASE)};
+#undef X_CASE
+
+} // namespace
+
+uint64_t HistogramSnapshot::getPercentileUpperBoundUs(const double percentile) const
+{
+    if (count == 0) {
+        return 0;
+    }
+    const auto p = std::clamp(percentile, 0.0, 1.0);
+    const auto target = std::max<uint64_t>(1,
+                                           static_cast<uint64_t>(
+                                               std::ceil(p * static_cast<double>(count))));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen >= target) {
+            return LatencyHistogram::getBucketUpperBoundUs(i);
+        }
+    }
+    // Only possible if a sample was recorded while the snapshot was being taken.
+    return LatencyHistogram::getBucketUpperBoundUs(NUM_BUCKETS - 1);
+}
+
+double HistogramSnapshot::getMeanUs() const
+{
+    if (count == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(totalNs) / static_cast<double>(count) * 1e-3;
+}
+
+size_t LatencyHistogram::getBucketIndex(const std::chrono::nanoseconds elapsed) noexcept
+{
+    const auto us = static_cast<uint64_t>(std::max<int64_t>(0, elapsed.count()) / 1000);
+    return std::min(static_cast<size_t>(std::bit_width(us)), NUM_BUCKETS - 1);
+}
+
+uint64_t LatencyHistogram::getBucketUpperBoundUs(const size_t bucket) noexcept
+{
+    return uint64_t{1} << std::min(bucket, NUM_BUCKETS - 1);
+}
+
+void LatencyHistogram::record(const std::chrono::nanoseconds elapsed) noexcept
+{
+    const auto ns = static_cast<uint64_t>(std::max<int64_t>(0, elapsed.count()));
+    m_buckets[getBucketIndex(elapsed)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_totalNs.fetch_add(ns, std::memory_order_relaxed);
+
+    uint64_t prevMax = m_maxNs.load(std::memory_order_relaxed);
+    while (prevMax < ns
+           && !m_maxNs.compare_exchange_weak(prevMax, ns, std::memory_order_relaxed)) {
+    }
+}
+
+HistogramSnapshot LatencyHistogram::getSnapshot() const noexcept
+{
+    // The fields are read individually, so a snapshot taken during a burst of samples can be
+    // off by a few counts; that doesn't matter for a human-readable report.
+    HistogramSnapshot result;
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+        result.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    }
+    result.count = m_count.load(std::memory_order_relaxed);
+    result.totalNs = m_totalNs.load(std::memory_order_relaxed);
+    result.maxNs = m_maxNs.load(std::memory_order_relaxed);
+    return result;
+}
+
+void LatencyHistogram::reset() noexcept
+{
+    for (auto &bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_totalNs.store(0, std::memory_order_relaxed);
+    m_maxNs.store(0, std::memory_order_relaxed);
+}
+
+std::string_view getKey(const PerfStageEnum stage)
+{
+#define X_CASE(_Enum, _key, _description) \
+    case PerfStageEnum::_Enum: \
+        return _key;
+    switch (stage) {
+        XFOREACH_PERF_STAGE(X_CASE)
+    }
+#undef X_CASE
+    return "unknown";
+}
+
+std::string_view getDescription(const PerfStageEnum stage)
+{
+#define X_CASE(_Enum, _key, _description) \
+    case PerfStageEnum::_Enum: \
+        return _description;
+    switch (stage) {
+        XFOREACH_PERF_STAGE(X_CASE)
+    }
+#undef X_CASE
+    return "unknown";
+}
+
+void record(const PerfStageEnum stage, const std::chrono::nanoseconds elapsed) noexcept
+{
+    getHistogram(stage).record(elapsed);
+}
+
+HistogramSnapshot getSnapshot(const PerfStageEnum stage)
+{
+    return getHistogram(stage).getSnapshot();
+}
+
+void reset()
+{
+    for (auto &histogram : g_histograms) {
+        histogram.reset();
+    }
+}
+
+void report(AnsiOstream &aos)
+{
+    aos << "Latency per stage (upper bounds of log2 buckets):\n";
+    for (const PerfStageEnum stage : ALL_PERF_STAGES) {
+        const auto snapshot = getSnapshot(stage);
+        aos << "\n";
+        if (snapshot.count == 0) {
+            aos << ColoredValue{green, getDescription(stage)} << ": (no samples)\n";
+            continue;
+        }
+
+        reportSummary(aos, getDescription(stage), "samples", snapshot);
+
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+            if (const auto n = snapshot.buckets[i]; n != 0) {
+                aos << "  " << formatBucketName(i) << ": " << n << "\n";
+            }
+        }
+    }
+}
+
+void reportSummary(AnsiOstream &aos,
+                   const std::string_view name,
+                   const std::string_view unit,
+                   const HistogramSnapshot &snapshot)
+{
+    const auto totalUs = static_cast<double>(snapshot.totalNs) * 1e-3;
+    const auto maxUs = static_cast<double>(snapshot.maxNs) * 1e-3;
+    aos << ColoredValue{green, name} << ": " << snapshot.count << " " << unit
+        << ", total " << formatUs(totalUs) << " us"
+        << ", mean " << formatUs(snapshot.getMeanUs()) << " us"
+        << ", p50 <= " << snapshot.getPercentileUpperBoundUs(0.50) << " us"
+        << ", p90 <= " << snapshot.getPercentileUpperBoundUs(0.90) << " us"
+        << ", p99 <= " << snapshot.getPercentileUpperBoundUs(0.99) << " us"
+        << ", max " << ColoredValue{yellow, formatUs(maxUs)} << " us\n";
+}
+
+ScopedTimer::~ScopedTimer()
+{
+    const auto total = Clock::now() - m_beg;
+    tl_current = m_parent;
+    if (m_parent != nullptr) {
+        m_parent->m_nested += total;
+    }
+    record(m_stage, std::chrono::duration_cast<std::chrono::nanoseconds>(total - m_nested));
+}
+
+std::string toJson()
+{
+    QJsonArray bounds;
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+        bounds.append(static_cast<qint64>(LatencyHistogram::getBucketUpperBoundUs(i)));
+    }
+
+    QJsonObject stages;
+    for (const PerfStageEnum stage : ALL_PERF_STAGES) {
+        const auto snapshot = getSnapshot(stage);
+
+        QJsonArray buckets;
+        for (const uint64_t n : snapshot.buckets) {
+            buckets.append(static_cast<qint64>(n));
+        }
+
+        QJsonObject obj;
+        obj["description"] = mmqt::toQStringUtf8(getDescription(stage));
+        obj["count"] = static_cast<qint64>(snapshot.count);
+        obj["total_ns"] = static_cast<qint64>(snapshot.totalNs);
+        obj["max_ns"] = static_cast<qint64>(snapshot.maxNs);
+        obj["mean_us"] = snapshot.getMeanUs();
+        obj["p50_us"] = static_cast<qint64>(snapshot.getPercentileUpperBoundUs(0.50));
+        obj["p90_us"] = static_cast<qint64>(snapshot.getPercentileUpperBoundUs(0.90));
+        obj["p99_us"] = static_cast<qint64>(snapshot.getPercentileUpperBoundUs(0.99));
+        obj["buckets"] = buckets;
+
+        stages[mmqt::toQStringUtf8(getKey(stage))] = obj;
+    }
+
+    QJsonObject root;
+    root["bucket_upper_bounds_us"] = bounds;
+    root["stages"] = stages;
+    return QJsonDocument{root}.toJson(QJsonDocument::Indented).toStdString();
+}
+
+} // namespace perf_stats
+
+void test::testPerfStats()
+{
+    using namespace perf_stats;
+    using namespace std::chrono_literals;
+
+    TEST_ASSERT(LatencyHistogram::getBucketIndex(0ns) == 0);
+    TEST_ASSERT(LatencyHistogram::getBucketIndex(999ns) == 0);
+    TEST_ASSERT(LatencyHistogram::getBucketIndex(1us) == 1);
+    TEST_ASSERT(LatencyHistogram::getBucketIndex(3us) == 2);
+    TEST_ASSERT(LatencyHistogram::getBucketIndex(4us) == 3);
+    TEST_ASSERT(LatencyHistogram::getBucketIndex(-5ns) == 0);
+    TEST_ASSERT(LatencyHistogram::getBucketIndex(1h) == NUM_BUCKETS - 1);
+
+    LatencyHistogram histogram;
+    for (int i = 0; i < 98; ++i) {
+        histogram.record(2us);
+    }
+    histogram.record(100us);
+    histogram.record(5ms);
+
+    const auto snapshot = histogram.getSnapshot();
+    TEST_ASSERT(snapshot.count == 100);
+    TEST_ASSERT(snapshot.maxNs == 5'000'000);
+    TEST_ASSERT(snapshot.buckets[2] == 98);
+    TEST_ASSERT(snapshot.getPercentileUpperBoundUs(0.50) == 4);
+    TEST_ASSERT(snapshot.getPercentileUpperBoundUs(0.99) == 128);
+    TEST_ASSERT(snapshot.getPercentileUpperBoundUs(1.0) == 8192);
+
+    histogram.reset();
+    TEST_ASSERT(histogram.getSnapshot().count == 0);
+    TEST_ASSERT(histogram.getSnapshot().getPercentileUpperBoundUs(0.5) == 0);
+
+    perf_stats::reset();
+    {
+        DECL_PERF_TIMER(outer, PathMachine);
+        {
+            DECL_PERF_TIMER(inner, MapChanges);
+            std::this_thread::sleep_for(2ms);
+        }
+    }
+    TEST_ASSERT(getSnapshot(PerfStageEnum::PathMachine).count == 1);
+    TEST_ASSERT(getSnapshot(PerfStageEnum::MapChanges).count == 1);
+    // the outer timer doesn't include the time spent in the inner one
+    TEST_ASSERT(getSnapshot(PerfStageEnum::PathMachine).maxNs
+                < getSnapshot(PerfStageEnum::MapChanges).maxNs);
+
+    const auto json = QJsonDocument::fromJson(QByteArray::fromStdString(toJson()));
+    TEST_ASSERT(json.isObject());
+    const auto stages = json.object().value("stages").toObject();
+    TEST_ASSERT(static_cast<size_t>(stages.size()) == NUM_PERF_STAGES);
+    TEST_ASSERT(stages.value("path_machine").toObject().value("count").toInteger() == 1);
+    perf_stats::reset();
+}
@@ -0,0 +1,126 @@
+#pragma once
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "RuleOf5.h"
+#include "macros.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+class AnsiOstream;
+
+// Per-stage latency histograms for the work done on every move, so input lag
+// can be attributed to the mapper or to the network.
+//
+// Recording is lock-free (relaxed atomic increments), so it's cheap enough to leave enabled,
+// and it may happen on any thread.
+
+// X(_Enum, _key, _description)
+#define XFOREACH_PERF_STAGE(X) \
+    X(TelnetDecode, "telnet_decode", "telnet decode") \
+    X(MudParse, "mud_parse", "XML/GMCP parse") \
+    X(PathMachine, "path_machine", "PathMachine::handleParseEvent") \
+    X(MapChanges, "map_changes", "MapData change application") \
+    X(Remesh, "remesh", "remesh trigger")
+
+#define X_DECL_PERF_STAGE(_Enum, _key, _description) _Enum,
+enum class NODISCARD PerfStageEnum : uint8_t { XFOREACH_PERF_STAGE(X_DECL_PERF_STAGE) };
+#undef X_DECL_PERF_STAGE
+
+#define X_COUNT_PERF_STAGE(_Enum, _key, _description) +1
+static constexpr const size_t NUM_PERF_STAGES = (XFOREACH_PERF_STAGE(X_COUNT_PERF_STAGE));
+#undef X_COUNT_PERF_STAGE
+
+namespace perf_stats {
+
+// Bucket 0 holds samples under 1 us; bucket i holds [2^(i-1), 2^i) us;
+// the last bucket also holds everything slower.
+static constexpr const size_t NUM_BUCKETS = 26;
+
+struct NODISCARD HistogramSnapshot final
+{
+    std::array<uint64_t, NUM_BUCKETS> buckets{};
+    uint64_t count = 0;
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+
+    // Returns the upper bound (in microseconds) of the bucket containing the given percentile.
+    NODISCARD uint64_t getPercentileUpperBoundUs(double percentile) const;
+    NODISCARD double getMeanUs() const;
+};
+
+class NODISCARD LatencyHistogram final
+{
+private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> m_buckets{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_totalNs{0};
+    std::atomic<uint64_t> m_maxNs{0};
+
+public:
+    LatencyHistogram() = default;
+    DELETE_CTORS_AND_ASSIGN_OPS(LatencyHistogram);
+
+public:
+    void record(std::chrono::nanoseconds elapsed) noexcept;
+    NODISCARD HistogramSnapshot getSnapshot() const noexcept;
+    void reset() noexcept;
+
+public:
+    NODISCARD static size_t getBucketIndex(std::chrono::nanoseconds elapsed) noexcept;
+    NODISCARD static uint64_t getBucketUpperBoundUs(size_t bucket) noexcept;
+};
+
+NODISCARD extern std::string_view getKey(PerfStageEnum stage);
+NODISCARD extern std::string_view getDescription(PerfStageEnum stage);
+
+extern void record(PerfStageEnum stage, std::chrono::nanoseconds elapsed) noexcept;
+NODISCARD extern HistogramSnapshot getSnapshot(PerfStageEnum stage);
+extern void reset();
+
+extern void report(AnsiOstream &aos);
+// Writes "<name>: <count> <unit>, total ..., mean ..., p50 ..., max ...\n", with the name and
+// the max highlighted; shared by every latency report so they all read the same.
+extern void reportSummary(AnsiOstream &aos,
+                          std::string_view name,
+                          std::string_view unit,
+                          const HistogramSnapshot &snapshot);
+NODISCARD extern std::string toJson();
+
+// Stages run nested inside each other (e.g. telnet decode synchronously feeds the parser,
+// which feeds the path machine), so a timer only records its own time: anything measured by
+// an inner timer on the same thread is subtracted.
+class NODISCARD ScopedTimer final
+{
+private:
+    using Clock = std::chrono::steady_clock;
+    static inline thread_local ScopedTimer *tl_current = nullptr;
+    Clock::time_point m_beg = Clock::now();
+    Clock::duration m_nested{};
+    ScopedTimer *m_parent = nullptr;
+    PerfStageEnum m_stage;
+
+public:
+    explicit ScopedTimer(const PerfStageEnum stage)
+        : m_parent{std::exchange(tl_current, this)}
+        , m_stage{stage}
+    {}
+    ~ScopedTimer();
+    DELETE_CTORS_AND_ASSIGN_OPS(ScopedTimer);
+};
+
+} // namespace perf_stats
+
+#define DECL_PERF_TIMER(var, stage) \
+    auto var = (perf_stats::ScopedTimer{PerfStageEnum::stage})
+
+namespace test {
+extern void testPerfStats();
+} // namespace test
@@ -0,0 +1,338 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "SimdUtils.h"
+
+#include "Charset.h"
+#include "tests.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if MMAPPER_SIMD_AVX2
+#include <immintrin.h>
+#elif MMAPPER_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace simd_utils {
+
+namespace { // anonymous
+
+#if MMAPPER_SIMD_SSE2
+constexpr size_t VEC_SIZE = 16;
+
+NODISCARD inline __m128i load(const char *const p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+// One bit per byte: set if the byte is a space.
+NODISCARD inline uint32_t spaceMask(const __m128i v)
+{
+    // '\t', '\n', '\v', '\f' and '\r' are the contiguous range [9, 13].
+    const __m128i offset = _mm_sub_epi8(v, _mm_set1_epi8(char_consts::C_TAB));
+    const __m128i inRange = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(4)), offset);
+    const __m128i isSpace = _mm_cmpeq_epi8(v, _mm_set1_epi8(char_consts::C_SPACE));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(inRange, isSpace)));
+}
+
+// One bit per byte: set if the byte's high bit is set.
+NODISCARD inline uint32_t highBitMask(const __m128i v)
+{
+    return static_cast<uint32_t>(_mm_movemask_epi8(v));
+}
+
+// Two bits per UTF-16 unit: set if the unit isn't in [0x21, 0x7E].
+NODISCARD inline uint32_t nonGraphMask(const __m128i v)
+{
+    const __m128i offset = _mm_sub_epi16(v, _mm_set1_epi16(0x21));
+    const __m128i excess = _mm_subs_epu16(offset, _mm_set1_epi16(0x7E - 0x21));
+    const auto inRange = static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi16(excess, _mm_setzero_si128())));
+    return ~inRange & 0xFFFFu;
+}
+
+// One bit per byte: set if the bytes differ.
+NODISCARD inline uint32_t diffMask(const char *const a, const char *const b)
+{
+    const auto eq = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(load(a), load(b))));
+    return ~eq & 0xFFFFu;
+}
+#endif
+
+constexpr uint64_t SWAR_HIGH_BITS = 0x8080808080808080u;
+constexpr uint64_t SWAR16_ONES = 0x0001000100010001u;
+constexpr uint64_t SWAR16_BIT7 = SWAR16_ONES * 0x0080u;
+constexpr uint64_t SWAR16_BIT15 = SWAR16_ONES * 0x8000u;
+constexpr uint64_t SWAR16_LOW7 = SWAR16_ONES * 0x007Fu;
+constexpr uint64_t SWAR16_LOW15 = SWAR16_ONES * 0x7FFFu;
+
+// Sets bit 15 of each 16-bit lane whose unit isn't in [0x21, 0x7E].
+NODISCARD inline uint64_t swarNonGraph16(const uint64_t word)
+{
+    // For 7-bit units, adding 1 (or 0x5F) carries into bit 7 exactly when the unit is
+    // at least 0x7F (or 0x21), and never past it.
+    const uint64_t low7 = word & SWAR16_LOW7;
+    const uint64_t tooBig = (((low7 + SWAR16_ONES) & SWAR16_BIT7) | (word & ~SWAR16_LOW7));
+    const uint64_t tooSmall = ~(low7 + SWAR16_ONES * 0x5Fu) & SWAR16_BIT7;
+    const uint64_t bad = tooBig | tooSmall;
+    return (((bad & SWAR16_LOW15) + SWAR16_LOW15) | bad) & SWAR16_BIT15;
+}
+
+// Index of the first byte with its high bit set, given the word's high bits (nonzero).
+NODISCARD inline size_t firstHighByte(const uint64_t highBits)
+{
+    if constexpr (std::endian::native == std::endian::little) {
+        return static_cast<size_t>(std::countr_zero(highBits)) / 8u;
+    } else {
+        return static_cast<size_t>(std::countl_zero(highBits)) / 8u;
+    }
+}
+
+} // namespace
+
+size_t mismatch(const std::string_view a, const std::string_view b) noexcept
+{
+    const size_t n = std::min(a.size(), b.size());
+    size_t i = 0;
+#if MMAPPER_SIMD_SSE2
+    for (; i + VEC_SIZE <= n; i += VEC_SIZE) {
+        if (const uint32_t diff = diffMask(a.data() + i, b.data() + i); diff != 0) {
+            return i + static_cast<size_t>(std::countr_zero(diff));
+        }
+    }
+#endif
+    while (i < n && a[i] == b[i]) {
+        ++i;
+    }
+    return i;
+}
+
+size_t countMismatches(const std::string_view a, const std::string_view b) noexcept
+{
+    const size_t n = std::min(a.size(), b.size());
+    size_t result = 0;
+    size_t i = 0;
+#if MMAPPER_SIMD_SSE2
+    for (; i + VEC_SIZE <= n; i += VEC_SIZE) {
+        result += static_cast<size_t>(std::popcount(diffMask(a.data() + i, b.data() + i)));
+    }
+#endif
+    for (; i < n; ++i) {
+        result += (a[i] != b[i]) ? 1u : 0u;
+    }
+    return result;
+}
+
+size_t findFirstSpace(const std::string_view sv) noexcept
+{
+    const size_t n = sv.size();
+    size_t i = 0;
+#if MMAPPER_SIMD_SSE2
+    for (; i + VEC_SIZE <= n; i += VEC_SIZE) {
+        if (const uint32_t mask = spaceMask(load(sv.data() + i)); mask != 0) {
+            return i + static_cast<size_t>(std::countr_zero(mask));
+        }
+    }
+#endif
+    while (i < n && !ascii::isSpace(sv[i])) {
+        ++i;
+    }
+    return i;
+}
+
+size_t countNonSpace(const std::string_view sv) noexcept
+{
+    const size_t n = sv.size();
+    size_t result = 0;
+    size_t i = 0;
+#if MMAPPER_SIMD_SSE2
+    for (; i + VEC_SIZE <= n; i += VEC_SIZE) {
+        const auto numSpaces = std::popcount(spaceMask(load(sv.data() + i)));
+        result += VEC_SIZE - static_cast<size_t>(numSpaces);
+    }
+#endif
+    for (; i < n; ++i) {
+        result += ascii::isSpace(sv[i]) ? 0u : 1u;
+    }
+    return result;
+}
+
+size_t countLeadingAscii(const std::string_view sv) noexcept
+{
+    const char *const data = sv.data();
+    const size_t n = sv.size();
+    size_t i = 0;
+#if MMAPPER_SIMD_AVX2
+    for (; i + 32 <= n; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        if (const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(v)); mask != 0) {
+            return i + static_cast<size_t>(std::countr_zero(mask));
+        }
+    }
+#endif
+#if MMAPPER_SIMD_SSE2
+    // two vectors per iteration; MUD output is mostly long runs of ASCII
+    for (; i + 2 * VEC_SIZE <= n; i += 2 * VEC_SIZE) {
+        const __m128i lo = load(data + i);
+        const __m128i hi = load(data + i + VEC_SIZE);
+        if (highBitMask(_mm_or_si128(lo, hi)) != 0) {
+            const uint32_t mask = highBitMask(lo) | (highBitMask(hi) << VEC_SIZE);
+            return i + static_cast<size_t>(std::countr_zero(mask));
+        }
+    }
+    for (; i + VEC_SIZE <= n; i += VEC_SIZE) {
+        if (const uint32_t mask = highBitMask(load(data + i)); mask != 0) {
+            return i + static_cast<size_t>(std::countr_zero(mask));
+        }
+    }
+#endif
+    for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        std::memcpy(&word, data + i, sizeof(word));
+        if (const uint64_t highBits = word & SWAR_HIGH_BITS; highBits != 0) {
+            return i + firstHighByte(highBits);
+        }
+    }
+    while (i < n && static_cast<uint8_t>(data[i]) < 0x80u) {
+        ++i;
+    }
+    return i;
+}
+
+size_t countLeadingGraphAscii(const std::u16string_view sv) noexcept
+{
+    const char16_t *const data = sv.data();
+    const size_t n = sv.size();
+    size_t i = 0;
+#if MMAPPER_SIMD_AVX2
+    for (; i + 16 <= n; i += 16) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        const __m256i offset = _mm256_sub_epi16(v, _mm256_set1_epi16(0x21));
+        const __m256i excess = _mm256_subs_epu16(offset, _mm256_set1_epi16(0x7E - 0x21));
+        const auto inRange = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi16(excess, _mm256_setzero_si256())));
+        if (inRange != ~uint32_t{0}) {
+            return i + static_cast<size_t>(std::countr_one(inRange)) / 2u;
+        }
+    }
+#endif
+#if MMAPPER_SIMD_SSE2
+    for (; i + 8 <= n; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        if (const uint32_t mask = nonGraphMask(v); mask != 0) {
+            return i + static_cast<size_t>(std::countr_zero(mask)) / 2u;
+        }
+    }
+#endif
+    for (; i + 4 <= n; i += 4) {
+        uint64_t word = 0;
+        std::memcpy(&word, data + i, sizeof(word));
+        if (const uint64_t bad = swarNonGraph16(word); bad != 0) {
+            if constexpr (std::endian::native == std::endian::little) {
+                return i + static_cast<size_t>(std::countr_zero(bad)) / 16u;
+            } else {
+                return i + static_cast<size_t>(std::countl_zero(bad)) / 16u;
+            }
+        }
+    }
+    while (i < n && data[i] >= 0x21 && data[i] <= 0x7E) {
+        ++i;
+    }
+    return i;
+}
+
+} // namespace simd_utils
+
+namespace { // anonymous
+NODISCARD size_t scalarMismatch(const std::string_view a, const std::string_view b)
+{
+    const size_t n = std::min(a.size(), b.size());
+    size_t i = 0;
+    while (i < n && a[i] == b[i]) {
+        ++i;
+    }
+    return i;
+}
+} // namespace
+
+void test::testSimdUtils()
+{
+    using namespace simd_utils;
+
+    // every byte value, at every offset within (and past) a vector
+    std::string all;
+    for (int c = 0; c < 256; ++c) {
+        all += static_cast<char>(c);
+    }
+    size_t expectedNonSpace = 0;
+    for (const char c : all) {
+        expectedNonSpace += ascii::isSpace(c) ? 0u : 1u;
+    }
+    TEST_ASSERT(countNonSpace(all) == expectedNonSpace);
+
+    for (size_t len = 0; len < 40; ++len) {
+        for (size_t pos = 0; pos < len; ++pos) {
+            const std::string a(len, 'x');
+            std::string b = a;
+            b[pos] = 'y';
+            TEST_ASSERT(mismatch(a, b) == pos);
+            TEST_ASSERT(mismatch(a, b) == scalarMismatch(a, b));
+            TEST_ASSERT(countMismatches(a, b) == 1);
+            TEST_ASSERT(countMismatches(a, a) == 0);
+
+            for (const char space : {' ', '\t', '\n', '\v', '\f', '\r'}) {
+                std::string s = a;
+                s[pos] = space;
+                TEST_ASSERT(findFirstSpace(s) == pos);
+                TEST_ASSERT(countNonSpace(s) == len - 1);
+            }
+        }
+        const std::string a(len, 'x');
+        TEST_ASSERT(mismatch(a, a) == len);
+        TEST_ASSERT(findFirstSpace(a) == len);
+        TEST_ASSERT(mismatch(a, a + "z") == len);
+        TEST_ASSERT(countMismatches(a, a + "z") == 0);
+    }
+
+    // high bytes must not be mistaken for spaces (unsigned comparison)
+    for (int c = 128; c < 256; ++c) {
+        const std::string s(20, static_cast<char>(c));
+        TEST_ASSERT(findFirstSpace(s) == s.size());
+    }
+    TEST_ASSERT(countMismatches("abcdefghijklmnopqrstuvwxyz", "abcdefghijklmnopQRSTUVWXYZ") == 10);
+
+    // every UTF-16 unit, at every position
+    for (uint32_t u = 0; u < 0x10000u; ++u) {
+        const auto unit = static_cast<char16_t>(u);
+        const bool graph = u >= 0x21 && u <= 0x7E;
+        for (size_t len = 1; len < 20; ++len) {
+            const size_t pos = u % len;
+            std::u16string s(len, u'x');
+            s[pos] = unit;
+            TEST_ASSERT(countLeadingGraphAscii(s) == (graph ? len : pos));
+        }
+    }
+    TEST_ASSERT(countLeadingGraphAscii(u"") == 0);
+    TEST_ASSERT(countLeadingGraphAscii(u"abc\x1B[0m") == 3);
+    TEST_ASSERT(countLeadingGraphAscii(u"You see a cat.\r\n") == 3);
+
+    // every length and position covers the 32-, 16-, 8- and 1-byte loops
+    for (size_t len = 0; len < 80; ++len) {
+        const std::string ascii(len, '\x7F');
+        TEST_ASSERT(countLeadingAscii(ascii) == len);
+        for (size_t pos = 0; pos < len; ++pos) {
+            for (const char high : {'\x80', '\xC3', '\xFF'}) {
+                std::string s = ascii;
+                s[pos] = high;
+                TEST_ASSERT(countLeadingAscii(s) == pos);
+                s.back() = high;
+                TEST_ASSERT(countLeadingAscii(s) == pos);
+            }
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "macros.h"
+
+#include <cstddef>
+#include <string_view>
+
+// SSE2 is part of the x86-64 baseline, so it doesn't need runtime dispatch;
+// other targets use the scalar loops.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MMAPPER_SIMD_SSE2 1
+#else
+#define MMAPPER_SIMD_SSE2 0
+#endif
+
+// AVX2 is only used when the compiler is told it can assume it (e.g. -mavx2 or -march=native).
+#if defined(__AVX2__)
+#define MMAPPER_SIMD_AVX2 1
+#else
+#define MMAPPER_SIMD_AVX2 0
+#endif
+
+// Byte-level helpers for hot text loops; "space" has the same meaning as ascii::isSpace().
+namespace simd_utils {
+
+// Returns the index of the first byte that differs, or the length of the shorter string.
+NODISCARD extern size_t mismatch(std::string_view a, std::string_view b) noexcept;
+
+// Returns the number of positions in [0, min(a.size(), b.size())) where the bytes differ.
+NODISCARD extern size_t countMismatches(std::string_view a, std::string_view b) noexcept;
+
+// Returns the index of the first space, or sv.size() if there is none.
+NODISCARD extern size_t findFirstSpace(std::string_view sv) noexcept;
+
+NODISCARD extern size_t countNonSpace(std::string_view sv) noexcept;
+
+// Returns the index of the first byte with the high bit set, or sv.size() if it's all ASCII.
+// Targets without SSE2 check eight bytes at a time in a 64-bit word.
+NODISCARD extern size_t countLeadingAscii(std::string_view sv) noexcept;
+
+// Returns the number of leading units in U+0021..U+007E (i.e. printable ASCII other than space),
+// so it stops at the first space, newline, ESC, other control code, or non-ASCII unit.
+NODISCARD extern size_t countLeadingGraphAscii(std::u16string_view sv) noexcept;
+
+} // namespace simd_utils
+
+namespace test {
+extern void testSimdUtils();
+} // namespace test
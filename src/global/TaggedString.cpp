@@ -4,6 +4,11 @@
 #include "TaggedString.h"
 
 #include "tests.h"
+#include "utils.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
 
 namespace test {
 
@@ -36,5 +41,13 @@ void testTaggedString()
                 utf8}}.toStdStringUtf8();
         TEST_ASSERT(ignored == utf8);
     }
+    {
+        auto owner = std::make_shared<const std::string>(std::string{"prefix:"} + utf8);
+        const auto view = std::string_view{deref(owner)}.substr(7);
+        const auto shared = TaggedBoxedStringUtf8<FakeTag>::fromSharedStorage(owner, view);
+        owner.reset();
+        TEST_ASSERT(shared.getStdStringViewUtf8() == utf8);
+        TEST_ASSERT(shared == TaggedBoxedStringUtf8<FakeTag>{utf8});
+    }
 }
 } // namespace test
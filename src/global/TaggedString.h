@@ -12,6 +12,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include <QByteArray>
 #include <QString>
@@ -87,7 +88,9 @@ class NODISCARD TaggedBoxedStringUtf8
 
 private:
     using SharedConstCharArray = std::shared_ptr<const std::string>;
-    SharedConstCharArray m_ptr;
+    // Only used to keep the storage behind m_view alive; it's usually a std::string,
+    // but it can also be a shared block of memory (see fromSharedStorage()).
+    std::shared_ptr<const void> m_ptr;
     std::string_view m_view;
 
 public:
@@ -107,9 +110,14 @@ class NODISCARD TaggedBoxedStringUtf8
     }
 
 private:
-    explicit TaggedBoxedStringUtf8(SharedConstCharArray ptr)
-        : m_ptr{std::move(ptr)}
-        , m_view{deref(m_ptr)}
+    explicit TaggedBoxedStringUtf8(const SharedConstCharArray &ptr)
+        : m_ptr{ptr}
+        , m_view{deref(ptr)}
+    {}
+
+    explicit TaggedBoxedStringUtf8(std::shared_ptr<const void> owner, const std::string_view sv)
+        : m_ptr{std::move(owner)}
+        , m_view{sv}
     {
         if (m_ptr == nullptr) {
             throw NullPointerException();
@@ -165,6 +173,19 @@ class NODISCARD TaggedBoxedStringUtf8
         : TaggedBoxedStringUtf8{std::move(s).getStdStringUtf8()}
     {}
 
+public:
+    // The string data is owned by (or kept alive by) the owner, which must not be modified.
+    // This allows many strings to share a single allocation or memory-mapped file.
+    NODISCARD static TaggedBoxedStringUtf8 fromSharedStorage(std::shared_ptr<const void> owner,
+                                                             const std::string_view sv)
+    {
+        check(sv);
+        if (sv.empty()) {
+            return TaggedBoxedStringUtf8{getEmptyString()};
+        }
+        return TaggedBoxedStringUtf8{std::move(owner), sv};
+    }
+
 public:
     NODISCARD std::string_view getStdStringViewUtf8() const & { return m_view; }
     // NODISCARD std::string_view getStdStringViewUtf8() && = delete;
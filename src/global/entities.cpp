@@ -9,10 +9,14 @@
 #include "RuleOf5.h"
 
 #include <cassert>
+#include <cctype>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <optional>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -118,9 +122,11 @@ struct NODISCARD EntityTable final
     std::unordered_map<QString, XmlEntity, MyHash> by_short_name;
     std::unordered_map<QString, XmlEntity, MyHash> by_full_name;
     std::unordered_map<XmlEntityEnum, XmlEntity> by_id;
+    std::unordered_map<std::string, XmlEntityEnum> by_full_name_utf8;
 
     NODISCARD XmlEntityEnum lookup_entity_id_by_short_name(const QString &entity) const;
     NODISCARD XmlEntityEnum lookup_entity_id_by_full_name(const QString &entity) const;
+    NODISCARD XmlEntityEnum lookup_entity_id_by_full_name(std::string_view entity) const;
     NODISCARD OptQByteArray lookup_entity_short_name_by_id(XmlEntityEnum id) const;
     NODISCARD OptQByteArray lookup_entity_full_name_by_id(XmlEntityEnum id) const;
 };
@@ -142,6 +148,7 @@ NODISCARD static EntityTable initEntityTable()
         entityTable.by_short_name[QString::fromUtf8(ent.short_name)] = ent;
         entityTable.by_full_name[QString::fromUtf8(ent.full_name)] = ent;
         entityTable.by_id[ent.id] = ent;
+        entityTable.by_full_name_utf8[ent.full_name.toStdString()] = ent.id;
     }
 
     return entityTable;
@@ -173,6 +180,16 @@ XmlEntityEnum EntityTable::lookup_entity_id_by_full_name(const QString &entity)
     return XmlEntityEnum::INVALID;
 }
 
+XmlEntityEnum EntityTable::lookup_entity_id_by_full_name(const std::string_view entity) const
+{
+    const auto &map = by_full_name_utf8;
+    const auto it = map.find(std::string{entity});
+    if (it != map.end()) {
+        return it->second;
+    }
+    return XmlEntityEnum::INVALID;
+}
+
 OptQByteArray EntityTable::lookup_entity_short_name_by_id(const XmlEntityEnum id) const
 {
     const auto &map = by_id;
@@ -600,6 +617,154 @@ auto entities::decode(const EncodedString &input) -> DecodedString
     return std::move(callback.out);
 }
 
+namespace { // anonymous
+struct NODISCARD Utf8Entity final
+{
+    size_t length = 0;
+    std::optional<char32_t> decoded;
+};
+
+NODISCARD bool isUtf8NameStartChar(const char32_t c)
+{
+    // Anything outside the BMP would have been a surrogate pair, which counts as a name char.
+    return c > 0xFFFFu || entities::isNameStartChar(QChar{static_cast<char16_t>(c)});
+}
+
+NODISCARD bool isUtf8NameChar(const char32_t c)
+{
+    return c > 0xFFFFu || entities::isNameChar(QChar{static_cast<char16_t>(c)});
+}
+
+NODISCARD std::optional<char32_t> tryParseNumber(const std::string_view digits, const uint32_t base)
+{
+    if (digits.empty()) {
+        return std::nullopt;
+    }
+
+    uint32_t val = 0;
+    for (const char c : digits) {
+        val *= base;
+        val += ascii::isDigit(c) ? static_cast<uint32_t>(c - '0')
+                                 : static_cast<uint32_t>((c | 0x20) - 'a') + 10;
+        if (val > MAX_UNICODE_CODEPOINT) {
+            return std::nullopt;
+        }
+    }
+    // Matches decode(), which only produces a single QChar.
+    if (val > std::numeric_limits<uint16_t>::max()) {
+        return std::nullopt;
+    }
+    return static_cast<char32_t>(val);
+}
+
+// Mirrors foreachEntity(); `sv` starts with the '&'.
+NODISCARD std::optional<Utf8Entity> tryMatchUtf8Entity(const std::string_view sv)
+{
+    assert(!sv.empty() && sv.front() == C_AMPERSAND);
+    const auto semicolonAfter = [&sv](const size_t pos) -> bool {
+        return pos < sv.size() && sv[pos] == C_SEMICOLON;
+    };
+
+    if (sv.size() > 2 && sv[1] == C_POUND_SIGN) {
+        if (sv[2] == 'x') {
+            size_t end = 3;
+            while (end < sv.size() && std::isxdigit(static_cast<uint8_t>(sv[end]))) {
+                ++end;
+            }
+            if (semicolonAfter(end)) {
+                return Utf8Entity{end + 1, tryParseNumber(sv.substr(3, end - 3), 16)};
+            }
+        } else if (ascii::isDigit(sv[2])) {
+            size_t end = 3;
+            while (end < sv.size() && ascii::isDigit(sv[end])) {
+                ++end;
+            }
+            if (semicolonAfter(end)) {
+                return Utf8Entity{end + 1, tryParseNumber(sv.substr(2, end - 2), 10)};
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::string_view rest = sv.substr(1);
+    const auto first = charset::conversion::try_pop_utf8(rest);
+    if (!first || !isUtf8NameStartChar(*first)) {
+        return std::nullopt;
+    }
+    while (!rest.empty()) {
+        std::string_view next = rest;
+        const auto c = charset::conversion::try_pop_utf8(next);
+        if (!c || !isUtf8NameChar(*c)) {
+            break;
+        }
+        rest = next;
+    }
+
+    const size_t end = sv.size() - rest.size();
+    if (!semicolonAfter(end)) {
+        return std::nullopt;
+    }
+
+    const size_t len = end + 1;
+    const XmlEntityEnum id = getEntityTable().lookup_entity_id_by_full_name(sv.substr(0, len));
+    if (id == XmlEntityEnum::INVALID) {
+        return Utf8Entity{len, std::nullopt};
+    }
+    return Utf8Entity{len, static_cast<char32_t>(id)};
+}
+} // namespace
+
+void entities::decodeUtf8InPlace(std::string &utf8)
+{
+    static constexpr const char unprintable = C_QUESTION_MARK;
+
+    const char *const beg = utf8.data();
+    const char *const end = beg + utf8.size();
+    const auto findAmpersand = [end](const char *const from) -> const char * {
+        const void *const found = std::memchr(from, C_AMPERSAND, static_cast<size_t>(end - from));
+        return (found == nullptr) ? end : static_cast<const char *>(found);
+    };
+
+    const char *in = findAmpersand(beg);
+    if (in == end) {
+        return;
+    }
+
+    // Only ever behind (or at) `in`, so nothing is overwritten before it's read.
+    char *out = utf8.data() + (in - beg);
+    while (in != end) {
+        if (*in != C_AMPERSAND) {
+            const char *const next = findAmpersand(in);
+            const auto len = static_cast<size_t>(next - in);
+            std::memmove(out, in, len);
+            out += len;
+            in = next;
+            continue;
+        }
+
+        const auto entity = tryMatchUtf8Entity(std::string_view{in, static_cast<size_t>(end - in)});
+        if (!entity) {
+            *out++ = *in++;
+            continue;
+        }
+
+        const auto encoded = entity->decoded
+                                 ? charset::conversion::try_encode_utf8(entity->decoded.value())
+                                 : charset::conversion::OptionalEncodedUtf8Codepoint{};
+        if (encoded) {
+            const std::string_view bytes = encoded.value();
+            assert(bytes.size() <= entity->length);
+            std::memmove(out, bytes.data(), bytes.size());
+            out += bytes.size();
+        } else {
+            *out++ = unprintable;
+        }
+        in += entity->length;
+    }
+
+    utf8.resize(static_cast<size_t>(out - beg));
+}
+
 namespace { // anonymous
 void testEncode(const char *const raw_in, const char *const raw_expect)
 {
@@ -622,6 +787,12 @@ void testDecode(const char *const raw_in, const char *const raw_expect)
     if (out != expected) {
         throw std::runtime_error("test failed");
     }
+
+    std::string utf8 = raw_in;
+    decodeUtf8InPlace(utf8);
+    if (utf8 != outs) {
+        throw std::runtime_error("test failed");
+    }
 }
 } // namespace
 
@@ -701,5 +872,14 @@ void test_entities()
         assert(out.front().unicode() == C_QUESTION_MARK);
         // REVISIT: Consider using U+FFFD replacement character instead?
     }
+
+    testDecode("a &lt;b&gt; c", "a <b> c");
+    testDecode("&lt&lt;", "&lt<");
+    testDecode("&&amp;&", "&&&");
+    testDecode("&#;&#x;", "&#;?");
+    testDecode("&foo; &trade;", "? \u2122");
+    testDecode("caf\u00E9 &amp; cr\u00E8me", "caf\u00E9 & cr\u00E8me");
+    testDecode("&#x10FFFF;", "?");
+    testDecode("trailing &", "trailing &");
 }
 } // namespace test
@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <optional>
+#include <string>
 
 #include <QByteArray>
 #include <QString>
@@ -57,6 +58,9 @@ enum class NODISCARD EncodingEnum { Translit, Lossless };
 NODISCARD extern EncodedString encode(const DecodedString &name,
                                       EncodingEnum encodingType = EncodingEnum::Translit);
 NODISCARD extern DecodedString decode(const EncodedString &input);
+// Same rules as decode(), but for UTF-8 text. A decoded entity is never longer than
+// its encoding, so the string is rewritten in place; text without '&' isn't touched.
+extern void decodeUtf8InPlace(std::string &utf8);
 
 struct NODISCARD EntityCallback
 {
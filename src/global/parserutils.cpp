@@ -21,6 +21,38 @@ QString &removeAnsiMarksInPlace(QString &str)
     return str;
 }
 
+std::string &removeAnsiMarksInPlace(std::string &str)
+{
+    // Same matches as the QRegularExpression above, without leaving UTF-8.
+    const auto isParam = [](const char c) -> bool {
+        return ascii::isDigit(c) || c == char_consts::C_SEMICOLON || c == char_consts::C_COLON;
+    };
+    const auto isFinal = [](const char c) -> bool { return ascii::isLower(c) || ascii::isUpper(c); };
+
+    size_t out = str.find(char_consts::C_ESC);
+    if (out == std::string::npos) {
+        return str;
+    }
+
+    const size_t len = str.size();
+    for (size_t in = out; in < len;) {
+        if (str[in] == char_consts::C_ESC && in + 1 < len
+            && str[in + 1] == char_consts::C_OPEN_BRACKET) {
+            size_t end = in + 2;
+            while (end < len && isParam(str[end])) {
+                ++end;
+            }
+            if (end < len && isFinal(str[end])) {
+                in = end + 1;
+                continue;
+            }
+        }
+        str[out++] = str[in++];
+    }
+    str.resize(out);
+    return str;
+}
+
 NODISCARD bool isWhitespaceNormalized(const std::string_view sv)
 {
     bool last_was_space = false;
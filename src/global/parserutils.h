@@ -14,6 +14,7 @@ class QString;
 
 namespace ParserUtils {
 QString &removeAnsiMarksInPlace(QString &str);
+std::string &removeAnsiMarksInPlace(std::string &str);
 
 NODISCARD bool isWhitespaceNormalized(std::string_view sv);
 NODISCARD std::string normalizeWhitespace(std::string str);
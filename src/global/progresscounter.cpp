@@ -6,6 +6,31 @@
 
 #include <QObject>
 
+#if defined(Q_OS_LINUX) || defined(Q_OS_MAC)
+#include <sys/resource.h>
+#endif
+
+namespace { // anonymous
+NODISCARD std::optional<size_t> getPeakResidentBytes()
+{
+#if defined(Q_OS_LINUX) || defined(Q_OS_MAC)
+    struct rusage usage{};
+    if (::getrusage(RUSAGE_SELF, &usage) != 0 || usage.ru_maxrss <= 0) {
+        return std::nullopt;
+    }
+#ifdef Q_OS_MAC
+    // bytes
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    // kilobytes
+    return static_cast<size_t>(usage.ru_maxrss) * 1024u;
+#endif
+#else
+    return std::nullopt;
+#endif
+}
+} // namespace
+
 ProgressCanceledException::ProgressCanceledException()
     : std::runtime_error("ProgressCanceledException")
 {}
@@ -16,6 +41,7 @@ void ProgressCounter::setNewTask(const ProgressMsg &currentTask, const size_t ne
     checkCancel();
 
     std::lock_guard<std::mutex> lock{m_mutex};
+    beginPhase(currentTask);
     m_status.msg = currentTask;
     m_status.reset(Badge<ProgressCounter>{}, newTotalSteps);
 }
@@ -25,6 +51,7 @@ void ProgressCounter::setCurrentTask(const ProgressMsg &currentTask)
     checkCancel();
 
     std::lock_guard<std::mutex> lock{m_mutex};
+    beginPhase(currentTask);
     m_status.msg = currentTask;
 }
 
@@ -42,6 +69,33 @@ void ProgressCounter::step(const size_t steps)
 
     std::lock_guard<std::mutex> lock{m_mutex};
     m_status.seen += steps;
+    m_phaseSteps += steps;
+}
+
+void ProgressCounter::beginPhase(const ProgressMsg &msg)
+{
+    if (msg == m_status.msg) {
+        return;
+    }
+
+    const auto now = Clock::now();
+    if (!m_status.msg.empty() || m_phaseSteps != 0) {
+        m_phases.emplace_back(Phase{m_status.msg, now - m_phaseStart, m_phaseSteps});
+    }
+    m_phaseStart = now;
+    m_phaseSteps = 0;
+}
+
+void ProgressCounter::addByteCount(const std::string_view what, const size_t bytes)
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+    for (auto &[name, total] : m_byteCounts) {
+        if (name == what) {
+            total += bytes;
+            return;
+        }
+    }
+    m_byteCounts.emplace_back(std::string{what}, bytes);
 }
 
 ProgressMsg ProgressCounter::getCurrentTask() const
@@ -62,6 +116,22 @@ ProgressCounter::Status ProgressCounter::getStatus() const
     return m_status;
 }
 
+ProgressCounter::Report ProgressCounter::getReport() const
+{
+    Report report;
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        report.phases = m_phases;
+        if (!m_status.msg.empty() || m_phaseSteps != 0) {
+            report.phases.emplace_back(
+                Phase{m_status.msg, Clock::now() - m_phaseStart, m_phaseSteps});
+        }
+        report.byteCounts = m_byteCounts;
+    }
+    report.peakResidentBytes = getPeakResidentBytes();
+    return report;
+}
+
 void ProgressCounter::reset()
 {
     std::lock_guard<std::mutex> lock{m_mutex};
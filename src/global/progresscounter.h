@@ -7,8 +7,14 @@
 #include "TaggedString.h"
 #include "macros.h"
 
+#include <chrono>
 #include <cstdint>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace tags {
 struct NODISCARD TagProgressMsg final
@@ -48,11 +54,32 @@ class NODISCARD ProgressCounter final
         }
     };
 
+    using Clock = std::chrono::steady_clock;
+
+    // Each distinct task message is recorded as a phase, so the report shows where time went.
+    struct NODISCARD Phase final
+    {
+        ProgressMsg msg;
+        Clock::duration elapsed{};
+        size_t steps = 0;
+    };
+
+    struct NODISCARD Report final
+    {
+        std::vector<Phase> phases;
+        std::vector<std::pair<std::string, size_t>> byteCounts;
+        std::optional<size_t> peakResidentBytes;
+    };
+
 private:
     // note: Having a mutable member variable effectively means the object is never actually const,
     // but it allows us to keep the distinction between read-only and read-write member functions.
     mutable std::mutex m_mutex;
     Status m_status;
+    std::vector<Phase> m_phases;
+    std::vector<std::pair<std::string, size_t>> m_byteCounts;
+    Clock::time_point m_phaseStart = Clock::now();
+    size_t m_phaseSteps = 0;
     const AllowCancelEnum m_allowCancel = AllowCancelEnum::Allow;
     std::atomic_bool m_requested_cancel{false};
 
@@ -71,6 +98,8 @@ class NODISCARD ProgressCounter final
             throw ProgressCanceledException();
         }
     }
+    // requires the lock
+    void beginPhase(const ProgressMsg &msg);
 
 public:
     void setNewTask(const ProgressMsg &currentTask, size_t newTotalSteps);
@@ -78,6 +107,8 @@ class NODISCARD ProgressCounter final
     void step(size_t steps = 1u);
     void increaseTotalStepsBy(size_t steps);
     void reset();
+    // Accumulates a named byte count (e.g. "bytes read") that is included in the report.
+    void addByteCount(std::string_view what, size_t bytes);
     void requestCancel()
     {
         if (allowCancel() == AllowCancelEnum::Allow) {
@@ -89,6 +120,7 @@ class NODISCARD ProgressCounter final
     NODISCARD ProgressMsg getCurrentTask() const;
     NODISCARD size_t getPercentage() const;
     NODISCARD Status getStatus() const;
+    NODISCARD Report getReport() const;
     NODISCARD AllowCancelEnum allowCancel() const { return m_allowCancel; }
     NODISCARD bool hasRequestedCancel() const { return m_requested_cancel; }
 };
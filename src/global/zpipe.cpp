@@ -10,9 +10,12 @@
 #include "int_cast.h"
 #include "macros.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstring>
 #include <limits>
+#include <ostream>
 #include <stdexcept>
 
 #include <QDebug>
@@ -39,6 +42,20 @@ static_assert(MM_CHUNK >= MM_PAGE_SIZE);
 namespace mmz {
 
 #ifdef MMAPPER_NO_ZLIB
+bool hasZlib()
+{
+    return false;
+}
+struct GzipWriter::Impl final
+{};
+GzipWriter::GzipWriter(std::ostream & /*dest*/, int /*level*/)
+{
+    throw std::runtime_error("unable to gzip (built without zlib)");
+}
+GzipWriter::~GzipWriter() = default;
+void GzipWriter::write(std::string_view /*data*/) {}
+void GzipWriter::flush() {}
+void GzipWriter::finish() {}
 NODISCARD int zpipe_deflate(ProgressCounter & /*pc*/,
                             IFile & /*source*/,
                             IFile & /*dest*/,
@@ -52,6 +69,96 @@ NODISCARD int zpipe_inflate(ProgressCounter & /*pc*/, IFile & /*source*/, IFile
 }
 #else
 
+bool hasZlib()
+{
+    return true;
+}
+
+struct GzipWriter::Impl final
+{
+    std::ostream &dest;
+    z_stream strm{};
+    bool finished = false;
+    std::array<unsigned char, MM_CHUNK> out{};
+
+    explicit Impl(std::ostream &input_dest, const int level)
+        : dest{input_dest}
+    {
+        strm.zalloc = Z_NULL;
+        strm.zfree = Z_NULL;
+        strm.opaque = Z_NULL;
+        /* 16 + MAX_WBITS asks zlib for a gzip header and trailer instead of a zlib wrapper */
+        if (deflateInit2(&strm, level, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY)
+            != Z_OK) {
+            throw std::runtime_error("unable to initialize gzip stream");
+        }
+    }
+    ~Impl() { (void) deflateEnd(&strm); }
+    DELETE_CTORS_AND_ASSIGN_OPS(Impl);
+
+    void deflateInput(const int flush)
+    {
+        if (finished) {
+            throw std::runtime_error("gzip stream is already finished");
+        }
+
+        /* same loop as zpipe_deflate(), except the caller decides when to flush */
+        do {
+            strm.avail_out = MM_CHUNK;
+            strm.next_out = out.data();
+            MAYBE_UNUSED const int ret = deflate(&strm, flush);
+            assert(ret != Z_STREAM_ERROR); /* state not clobbered */
+            const auto have = MM_CHUNK - strm.avail_out;
+            dest.write(reinterpret_cast<const char *>(out.data()),
+                       static_cast<std::streamsize>(have));
+        } while (strm.avail_out == 0);
+        assert(strm.avail_in == 0);
+
+        if (flush == Z_FINISH) {
+            finished = true;
+        }
+    }
+};
+
+GzipWriter::GzipWriter(std::ostream &dest, const int level)
+    : m_impl{std::make_unique<Impl>(dest, level)}
+{}
+
+GzipWriter::~GzipWriter()
+{
+    if (!m_impl->finished) {
+        try {
+            finish();
+        } catch (...) {
+        }
+    }
+}
+
+void GzipWriter::write(const std::string_view data)
+{
+    auto &strm = m_impl->strm;
+    std::string_view rest = data;
+    while (!rest.empty()) {
+        const auto n = std::min<size_t>(rest.size(), std::numeric_limits<uInt>::max());
+        strm.next_in = reinterpret_cast<const Bytef *>(rest.data());
+        strm.avail_in = static_cast<uInt>(n);
+        m_impl->deflateInput(Z_NO_FLUSH);
+        rest.remove_prefix(n);
+    }
+}
+
+void GzipWriter::flush()
+{
+    m_impl->deflateInput(Z_SYNC_FLUSH);
+    m_impl->dest.flush();
+}
+
+void GzipWriter::finish()
+{
+    m_impl->deflateInput(Z_FINISH);
+    m_impl->dest.flush();
+}
+
 /* Compress from file source to file dest until EOF on source.
    def() returns Z_OK on success, Z_MEM_ERROR if memory could not be
    allocated for processing, Z_STREAM_ERROR if an invalid compression
@@ -139,7 +246,8 @@ int zpipe_inflate(ProgressCounter &pc, IFile &source, IFile &dest)
     strm.opaque = Z_NULL;
     strm.avail_in = 0;
     strm.next_in = Z_NULL;
-    ret = inflateInit(&strm);
+    /* 32 + MAX_WBITS accepts either a zlib or a gzip wrapper (e.g. from GzipWriter) */
+    ret = inflateInit2(&strm, 32 + MAX_WBITS);
     pc.step();
     if (ret != Z_OK) {
         return ret;
@@ -2,10 +2,14 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 // Copyright (C) 2024 The MMapper Authors
 
+#include "RuleOf5.h"
 #include "macros.h"
 #include "progresscounter.h"
 
 #include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string_view>
 
 #include <QBuffer>
 #include <QByteArray>
@@ -14,6 +18,7 @@ namespace mmz {
 
 struct IFile;
 NODISCARD int zpipe_deflate(ProgressCounter &pc, IFile &source, IFile &dest, int level);
+// Reads either zlib or gzip data; only the first gzip member is inflated.
 NODISCARD int zpipe_inflate(ProgressCounter &pc, IFile &source, IFile &dest);
 
 struct NODISCARD IFile
@@ -55,6 +60,35 @@ struct NODISCARD IFile
     NODISCARD virtual int virt_fflush() = 0;
     NODISCARD virtual size_t virt_get_bytes_avail_read() = 0;
 };
+
+// Returns false if MMapper was built without zlib.
+NODISCARD extern bool hasZlib();
+
+// Compresses a gzip stream a piece at a time, for output that doesn't exist all at once
+// (unlike zpipe_deflate, which reads its whole source before returning).
+//
+// Throws std::runtime_error if zlib fails, or if MMapper was built without it.
+class NODISCARD GzipWriter final
+{
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+
+public:
+    explicit GzipWriter(std::ostream &dest, int level);
+    // Calls finish() if it hasn't been called yet.
+    ~GzipWriter();
+    DELETE_CTORS_AND_ASSIGN_OPS(GzipWriter);
+
+public:
+    void write(std::string_view data);
+    // Makes everything written so far readable by a decompressor,
+    // at a small cost in compression ratio.
+    void flush();
+    // Writes the gzip trailer; nothing can be written afterwards.
+    void finish();
+};
+
 } // namespace mmz
 
 namespace mmqt {
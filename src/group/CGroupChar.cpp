@@ -5,8 +5,9 @@
 
 #include "CGroupChar.h"
 
-#include "../global/JsonObj.h"
+#include "../global/JsonView.h"
 #include "../global/QuotedQString.h"
+#include "../global/TextUtils.h"
 
 #include <QDebug>
 #include <QMessageLogContext>
@@ -27,7 +28,7 @@ void CGroupChar::reset()
     m_server.reset();
 }
 
-NODISCARD static CharacterPositionEnum toCharacterPosition(const QString &str)
+NODISCARD static CharacterPositionEnum toCharacterPosition(const std::string_view str)
 {
 #define X_CASE2(UPPER_CASE, lower_case, CamelCase, friendly) \
     do { \
@@ -40,7 +41,7 @@ NODISCARD static CharacterPositionEnum toCharacterPosition(const QString &str)
     return CharacterPositionEnum::UNDEFINED;
 }
 
-NODISCARD static CharacterTypeEnum toCharacterType(const QString &str)
+NODISCARD static CharacterTypeEnum toCharacterType(const std::string_view str)
 {
 #define X_CASE2(UPPER_CASE, lower_case, CamelCase, friendly) \
     do { \
@@ -53,7 +54,7 @@ NODISCARD static CharacterTypeEnum toCharacterType(const QString &str)
     return CharacterTypeEnum::UNDEFINED;
 }
 
-bool CGroupChar::updateFromGmcp(const JsonObj &obj)
+bool CGroupChar::updateFromGmcp(const JsonObjView &obj)
 {
     bool updated = false;
 
@@ -76,7 +77,7 @@ bool CGroupChar::updateFromGmcp(const JsonObj &obj)
 
     const auto tryUpdateString = [&obj, &updated](const char *const attr, QString &arr) {
         if (auto optString = obj.getString(attr)) {
-            const auto s = optString.value();
+            const auto s = mmqt::toQStringUtf8(optString.value());
             if (s != arr) {
                 arr = s;
                 updated = true;
@@ -84,18 +85,17 @@ bool CGroupChar::updateFromGmcp(const JsonObj &obj)
         }
     };
 
+    // Only box the strings that actually changed.
     if (auto optString = obj.getString("name")) {
-        const auto name = CharacterName{optString.value()};
-        if (name != m_server.name) {
-            setName(name);
+        if (optString.value() != m_server.name.getStdStringViewUtf8()) {
+            setName(CharacterName{std::move(optString.value())});
             updated = true;
         }
     }
 
     if (auto optString = obj.getString("label")) {
-        const auto label = CharacterLabel{optString.value()};
-        if (label != m_server.label) {
-            setLabel(label);
+        if (optString.value() != m_server.label.getStdStringViewUtf8()) {
+            setLabel(CharacterLabel{std::move(optString.value())});
             updated = true;
         }
     }
@@ -167,9 +167,8 @@ bool CGroupChar::updateFromGmcp(const JsonObj &obj)
     }
 
     if (auto optString = obj.getString("room")) {
-        const auto roomName = CharacterRoomName{optString.value()};
-        if (roomName != m_server.roomName) {
-            setRoomName(roomName);
+        if (optString.value() != m_server.roomName.getStdStringViewUtf8()) {
+            setRoomName(CharacterRoomName{std::move(optString.value())});
             updated = true;
         }
     }
@@ -19,7 +19,7 @@
 
 class CGroupChar;
 using SharedGroupChar = std::shared_ptr<CGroupChar>;
-class JsonObj;
+class JsonObjView;
 
 namespace tags {
 struct NODISCARD GroupIdTag final
@@ -128,7 +128,7 @@ class NODISCARD CGroupChar final : public std::enable_shared_from_this<CGroupCha
     void setColor(QColor col) { m_internal.color = std::move(col); }
     void setServerId(ServerRoomId id) { m_server.serverId = id; }
     NODISCARD const QColor &getColor() const { return m_internal.color; }
-    NODISCARD bool updateFromGmcp(const JsonObj &obj);
+    NODISCARD bool updateFromGmcp(const JsonObjView &obj);
     NODISCARD ServerRoomId getServerId() const { return m_server.serverId; }
     void setType(CharacterTypeEnum type) { m_server.type = type; }
     NODISCARD CharacterTypeEnum getType() const { return m_server.type; }
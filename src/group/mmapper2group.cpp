@@ -8,8 +8,7 @@
 #include "../configuration/configuration.h"
 #include "../global/CaseUtils.h"
 #include "../global/Charset.h"
-#include "../global/JsonArray.h"
-#include "../global/JsonObj.h"
+#include "../global/JsonView.h"
 #include "../global/thread_utils.h"
 #include "../proxy/GmcpMessage.h"
 #include "CGroupChar.h"
@@ -59,22 +58,22 @@ void Mmapper2Group::onReset()
     resetChars();
 }
 
-void Mmapper2Group::parseGmcpCharName(const JsonObj &obj)
+void Mmapper2Group::parseGmcpCharName(const JsonObjView &obj)
 {
     // "Char.Name" "{\"fullname\":\"Gandalf the Grey\",\"name\":\"Gandalf\"}"
     if (auto optName = obj.getString("name")) {
         SharedGroupChar self = getSelf();
-        self->setName(CharacterName{optName.value()});
+        self->setName(CharacterName{std::move(optName.value())});
         emit sig_characterUpdated(self);
     }
 }
 
-void Mmapper2Group::parseGmcpCharStatusVars(const JsonObj &obj)
+void Mmapper2Group::parseGmcpCharStatusVars(const JsonObjView &obj)
 {
     parseGmcpCharName(obj);
 }
 
-void Mmapper2Group::parseGmcpCharVitals(const JsonObj &obj)
+void Mmapper2Group::parseGmcpCharVitals(const JsonObjView &obj)
 {
     // "Char.Vitals {\"hp\":100,\"maxhp\":100,\"mana\":100,\"maxmana\":100,\"mp\":139,\"maxmp\":139}"
     SharedGroupChar self = getSelf();
@@ -84,7 +83,7 @@ void Mmapper2Group::parseGmcpCharVitals(const JsonObj &obj)
     emit sig_characterUpdated(self);
 }
 
-void Mmapper2Group::parseGmcpGroupAdd(const JsonObj &obj)
+void Mmapper2Group::parseGmcpGroupAdd(const JsonObjView &obj)
 {
     const auto id = getGroupId(obj);
     auto sharedCh = addChar(id);
@@ -94,7 +93,7 @@ void Mmapper2Group::parseGmcpGroupAdd(const JsonObj &obj)
     emit sig_characterUpdated(sharedCh);
 }
 
-void Mmapper2Group::parseGmcpGroupUpdate(const JsonObj &obj)
+void Mmapper2Group::parseGmcpGroupUpdate(const JsonObjView &obj)
 {
     const auto id = getGroupId(obj);
     auto sharedCh = getCharById(id);
@@ -107,13 +106,13 @@ void Mmapper2Group::parseGmcpGroupUpdate(const JsonObj &obj)
     emit sig_characterUpdated(sharedCh);
 }
 
-void Mmapper2Group::parseGmcpGroupRemove(const JsonInt n)
+void Mmapper2Group::parseGmcpGroupRemove(const int32_t n)
 {
     const auto id = GroupId{static_cast<uint32_t>(n)};
     removeChar(id);
 }
 
-void Mmapper2Group::parseGmcpGroupSet(const JsonArray &arr)
+void Mmapper2Group::parseGmcpGroupSet(const JsonArrayView &arr)
 {
     // Remove old characters (except self)
     resetChars();
@@ -134,7 +133,7 @@ void Mmapper2Group::parseGmcpGroupSet(const JsonArray &arr)
     }
 }
 
-void Mmapper2Group::parseGmcpRoomInfo(const JsonObj &obj)
+void Mmapper2Group::parseGmcpRoomInfo(const JsonObjView &obj)
 {
     SharedGroupChar self = getSelf();
     bool change = false;
@@ -148,9 +147,8 @@ void Mmapper2Group::parseGmcpRoomInfo(const JsonObj &obj)
         }
     }
     if (auto optString = obj.getString("name")) {
-        const auto name = CharacterRoomName{optString.value()};
-        if (name != self->getRoomName()) {
-            self->setRoomName(name);
+        if (optString.value() != self->getRoomName().getStdStringViewUtf8()) {
+            self->setRoomName(CharacterRoomName{std::move(optString.value())});
             change = true;
         }
     }
@@ -162,7 +160,15 @@ void Mmapper2Group::parseGmcpRoomInfo(const JsonObj &obj)
 
 void Mmapper2Group::slot_parseGmcpInput(const GmcpMessage &msg)
 {
-    if (!msg.getJsonDocument().has_value()) {
+    // Most messages aren't for us, so don't even look at the payload until we know.
+    if (!(msg.isGroupRemove() || msg.isGroupSet() || msg.isCharVitals() || msg.isCharName()
+          || msg.isCharStatusVars() || msg.isGroupAdd() || msg.isGroupUpdate()
+          || msg.isRoomInfo())) {
+        return;
+    }
+
+    const auto optView = msg.getJsonView();
+    if (!optView) {
         return;
     }
 
@@ -174,19 +180,19 @@ void Mmapper2Group::slot_parseGmcpInput(const GmcpMessage &msg)
 
     if (msg.isGroupRemove()) {
         debug();
-        if (auto optInt = msg.getJsonDocument()->getInt()) {
+        if (auto optInt = optView->getInt()) {
             parseGmcpGroupRemove(optInt.value());
         }
         return;
     } else if (msg.isGroupSet()) {
         debug();
-        if (auto optArray = msg.getJsonDocument()->getArray()) {
+        if (auto optArray = optView->getArray()) {
             parseGmcpGroupSet(optArray.value());
         }
         return;
     }
 
-    auto optObj = msg.getJsonDocument()->getObject();
+    auto optObj = optView->getObject();
     if (!optObj) {
         return;
     }
@@ -282,7 +288,7 @@ SharedGroupChar Mmapper2Group::getCharByName(const CharacterName &name) const
     return {};
 }
 
-GroupId Mmapper2Group::getGroupId(const JsonObj &obj)
+GroupId Mmapper2Group::getGroupId(const JsonObjView &obj)
 {
     auto optId = obj.getInt("id");
     if (!optId) {
@@ -291,7 +297,7 @@ GroupId Mmapper2Group::getGroupId(const JsonObj &obj)
     return GroupId{static_cast<uint32_t>(optId.value())};
 }
 
-bool Mmapper2Group::updateChar(SharedGroupChar sharedCh, const JsonObj &obj)
+bool Mmapper2Group::updateChar(SharedGroupChar sharedCh, const JsonObjView &obj)
 {
     CGroupChar &ch = deref(sharedCh);
 
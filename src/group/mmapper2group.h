@@ -4,7 +4,7 @@
 // Author: Dmitrijs Barbarins <lachupe@gmail.com> (Azazello)
 // Author: Nils Schimmelmann <nschimme@gmail.com> (Jahara)
 
-#include "../global/JsonValue.h"
+#include "../global/JsonView.h"
 #include "CGroupChar.h"
 #include "ColorGenerator.h"
 #include "GroupManagerApi.h"
@@ -51,25 +51,25 @@ class NODISCARD_QOBJECT Mmapper2Group final : public QObject
     void characterChanged();
 
 private:
-    void parseGmcpCharName(const JsonObj &obj);
-    void parseGmcpCharStatusVars(const JsonObj &obj);
-    void parseGmcpCharVitals(const JsonObj &obj);
-    void parseGmcpGroupAdd(const JsonObj &obj);
-    void parseGmcpGroupUpdate(const JsonObj &obj);
-    void parseGmcpGroupRemove(const JsonInt i);
-    void parseGmcpGroupSet(const JsonArray &arr);
-    void parseGmcpRoomInfo(const JsonObj &obj);
+    void parseGmcpCharName(const JsonObjView &obj);
+    void parseGmcpCharStatusVars(const JsonObjView &obj);
+    void parseGmcpCharVitals(const JsonObjView &obj);
+    void parseGmcpGroupAdd(const JsonObjView &obj);
+    void parseGmcpGroupUpdate(const JsonObjView &obj);
+    void parseGmcpGroupRemove(int32_t i);
+    void parseGmcpGroupSet(const JsonArrayView &arr);
+    void parseGmcpRoomInfo(const JsonObjView &obj);
 
 private:
     NODISCARD SharedGroupChar getSelf();
     NODISCARD SharedGroupChar addChar(const GroupId id);
     void removeChar(const GroupId id);
     NODISCARD bool updateChar(SharedGroupChar sharedCh,
-                              const JsonObj &json); // updates given char from GMCP
+                              const JsonObjView &json); // updates given char from GMCP
 
 private:
-    NODISCARD CharacterTypeEnum getCharacterType(const JsonObj &json);
-    NODISCARD GroupId getGroupId(const JsonObj &json);
+    NODISCARD CharacterTypeEnum getCharacterType(const JsonObjView &json);
+    NODISCARD GroupId getGroupId(const JsonObjView &json);
 
 public:
     NODISCARD SharedGroupChar getCharById(const GroupId id) const;
@@ -0,0 +1,385 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "asynclogwriter.h"
+
+#include "../global/TextUtils.h"
+#include "../global/utils.h"
+#include "../global/zpipe.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+
+#include <QDate>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QObject>
+#include <QStringList>
+
+namespace { // anonymous
+
+// Output is held back from the disk for about this long at most,
+// so the log on disk is never far behind the session.
+constexpr auto FLUSH_DELAY = std::chrono::milliseconds{500};
+// Anything bigger is written right away.
+constexpr size_t WRITE_BUFFER_BYTES = 64 * 1024;
+
+constexpr int GZIP_LEVEL = 6;
+
+} // namespace
+
+struct NODISCARD AsyncLogWriter::Output final
+{
+    Settings settings;
+    QString path;
+    std::ofstream file;
+    std::unique_ptr<mmz::GzipWriter> gzip;
+    std::string buffer;
+    bool unflushed = false;
+    std::chrono::steady_clock::time_point lastFlush;
+    int64_t curBytes = 0;
+    int curFile = 0;
+};
+
+AsyncLogWriter::AsyncLogWriter(QObject &receiver, std::string runId, Callbacks callbacks)
+    : m_receiver{receiver}
+    , m_runId{std::move(runId)}
+    , m_callbacks{std::move(callbacks)}
+    , m_output{std::make_unique<Output>()}
+    , m_thread{[this]() { run(); }}
+{}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_stopping = true;
+    }
+    m_cv.notify_one();
+    m_thread.join();
+}
+
+void AsyncLogWriter::enqueue(Command cmd)
+{
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_queue.emplace_back(std::move(cmd));
+    }
+    m_cv.notify_one();
+}
+
+void AsyncLogWriter::open(const Settings &settings)
+{
+    enqueue(OpenCmd{settings});
+}
+
+void AsyncLogWriter::write(std::string text)
+{
+    if (text.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if (m_queuedBytes + text.size() > MAX_QUEUED_BYTES) {
+            m_droppedBytes += text.size();
+            return;
+        }
+        if (m_droppedBytes != 0) {
+            std::ostringstream os;
+            os << "\n[MMapper: " << std::exchange(m_droppedBytes, 0)
+               << " bytes of output were not logged because the disk couldn't keep up.]\n";
+            m_queue.emplace_back(WriteCmd{std::move(os).str()});
+        }
+        m_queuedBytes += text.size();
+        m_queue.emplace_back(WriteCmd{std::move(text)});
+    }
+    m_cv.notify_one();
+}
+
+void AsyncLogWriter::cleanup(const Settings &settings)
+{
+    enqueue(CleanupCmd{settings});
+}
+
+void AsyncLogWriter::deleteLogs(const QFileInfoList &files)
+{
+    enqueue(DeleteCmd{files});
+}
+
+void AsyncLogWriter::post(std::function<void()> fn)
+{
+    if (fn) {
+        QMetaObject::invokeMethod(&m_receiver, std::move(fn), Qt::QueuedConnection);
+    }
+}
+
+void AsyncLogWriter::run()
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    while (true) {
+        const auto ready = [this]() { return m_stopping || !m_queue.empty(); };
+        if (!hasUnwrittenOutput()) {
+            m_cv.wait(lock, ready);
+        } else if (!m_cv.wait_for(lock, FLUSH_DELAY, ready)) {
+            // Nothing else arrived in time, so this is as big as the batch will get.
+            lock.unlock();
+            writeBuffered(true);
+            lock.lock();
+            continue;
+        }
+
+        if (m_queue.empty()) {
+            assert(m_stopping);
+            break;
+        }
+
+        // The lock is only held long enough to take everything that's queued.
+        std::deque<Command> batch = std::exchange(m_queue, {});
+        m_queuedBytes = 0;
+        lock.unlock();
+
+        for (Command &cmd : batch) {
+            process(cmd);
+        }
+        if (hasUnwrittenOutput()
+            && std::chrono::steady_clock::now() - m_output->lastFlush >= FLUSH_DELAY) {
+            // Output that keeps trickling in would otherwise never be idle long enough.
+            writeBuffered(true);
+        }
+
+        lock.lock();
+    }
+    lock.unlock();
+
+    closeFile();
+}
+
+void AsyncLogWriter::process(Command &cmd)
+{
+    std::visit(
+        [this](auto &c) {
+            using T = std::decay_t<decltype(c)>;
+            if constexpr (std::is_same_v<T, OpenCmd>) {
+                processOpen(c.settings);
+            } else if constexpr (std::is_same_v<T, WriteCmd>) {
+                processWrite(c.text);
+            } else if constexpr (std::is_same_v<T, CleanupCmd>) {
+                processCleanup(c.settings);
+            } else if constexpr (std::is_same_v<T, DeleteCmd>) {
+                processDelete(c.files);
+            }
+        },
+        cmd);
+}
+
+bool AsyncLogWriter::hasUnwrittenOutput() const
+{
+    return !m_output->buffer.empty() || m_output->unflushed;
+}
+
+void AsyncLogWriter::processOpen(const Settings &settings)
+{
+    m_output->settings = settings;
+    if (!createFile()) {
+        post(m_callbacks.onCreateFailed);
+    }
+}
+
+void AsyncLogWriter::processWrite(const std::string_view text)
+{
+    auto &out = *m_output;
+    if (!out.file.is_open()) {
+        return;
+    }
+
+    if (out.curBytes > out.settings.rotateWhenLogsReachBytes) {
+        if (!createFile()) {
+            post(m_callbacks.onCreateFailed);
+            return;
+        }
+    }
+
+    out.buffer.append(text);
+    out.curBytes += static_cast<int64_t>(text.size());
+    if (out.buffer.size() >= WRITE_BUFFER_BYTES) {
+        writeBuffered(false);
+    }
+}
+
+void AsyncLogWriter::writeBuffered(const bool flush)
+{
+    auto &out = *m_output;
+    if (!out.buffer.empty() && out.file.is_open()) {
+        try {
+            if (out.gzip != nullptr) {
+                out.gzip->write(out.buffer);
+            } else {
+                out.file.write(out.buffer.data(), static_cast<std::streamsize>(out.buffer.size()));
+            }
+        } catch (const std::exception &ex) {
+            qWarning() << "Unable to write to log file:" << ex.what();
+        }
+        out.unflushed = true;
+    }
+    out.buffer.clear();
+
+    if (flush && out.unflushed) {
+        if (out.gzip != nullptr) {
+            out.gzip->flush();
+        } else {
+            out.file.flush();
+        }
+        out.unflushed = false;
+        out.lastFlush = std::chrono::steady_clock::now();
+    }
+}
+
+void AsyncLogWriter::closeFile()
+{
+    auto &out = *m_output;
+    writeBuffered(true);
+    if (out.gzip != nullptr) {
+        try {
+            out.gzip->finish();
+        } catch (const std::exception &ex) {
+            qWarning() << "Unable to finish compressed log file:" << ex.what();
+        }
+        out.gzip.reset();
+    }
+    if (out.file.is_open()) {
+        out.file.close();
+    }
+    out.path.clear();
+}
+
+bool AsyncLogWriter::createFile()
+{
+    closeFile();
+
+    auto &out = *m_output;
+    const auto &settings = out.settings;
+
+    const auto &path = settings.autoLogDirectory;
+    QDir dir;
+    if (dir.mkpath(path)) {
+        dir.setPath(path);
+    } else {
+        return false;
+    }
+
+    const bool compress = settings.compressLogs && mmz::hasZlib();
+    QString fileName = QString("MMapper_Log_%1_%2_%3.txt%4")
+                           .arg(QDate::currentDate().toString("yyyy_MM_dd"))
+                           .arg(QString::number(out.curFile))
+                           .arg(mmqt::toQStringUtf8(m_runId))
+                           .arg(compress ? ".gz" : "");
+    const QString filePath = dir.absoluteFilePath(fileName);
+    out.file.open(mmqt::toStdStringUtf8(filePath),
+                  std::fstream::out | std::fstream::binary | std::fstream::app);
+    if (!out.file.is_open()) { // Could not create file.
+        return false;
+    }
+
+    if (compress) {
+        try {
+            // If the file already existed, this appends another gzip member,
+            // which gunzip reads as a continuation of the first one.
+            out.gzip = std::make_unique<mmz::GzipWriter>(out.file, GZIP_LEVEL);
+        } catch (const std::exception &ex) {
+            qWarning() << "Unable to compress log file:" << ex.what();
+            out.file.close();
+            return false;
+        }
+    }
+
+    out.path = filePath;
+    out.curBytes = 0;
+    ++out.curFile;
+
+    return true;
+}
+
+void AsyncLogWriter::processCleanup(const Settings &conf)
+{
+    if (conf.cleanupStrategy == AutoLoggerEnum::KeepForever) {
+        return;
+    }
+
+    auto fileInfoList = QDir(conf.autoLogDirectory)
+                            .entryInfoList(QStringList{"MMapper_Log_*.txt", "MMapper_Log_*.txt.gz"},
+                                           QDir::Files);
+    if (fileInfoList.empty()) {
+        return;
+    }
+
+    // Sort files so we can delete the oldest
+    std::sort(fileInfoList.begin(), fileInfoList.end(), [](const auto &a, const auto &b) {
+        return a.birthTime() < b.birthTime();
+    });
+
+    qint64 totalFileSize = 0, deleteFileSize = 0;
+    QFileInfoList filesToDelete;
+    const QDate &today = QDate::currentDate();
+    for (const auto &fileInfo : fileInfoList) {
+        totalFileSize += fileInfo.size();
+        if (fileInfo.absoluteFilePath() == m_output->path) {
+            // never delete the log that's being written
+            continue;
+        }
+        bool deleteFile = false;
+        switch (conf.cleanupStrategy) {
+        case AutoLoggerEnum::DeleteDays:
+            if (fileInfo.birthTime().date().daysTo(today) >= conf.deleteWhenLogsReachDays) {
+                deleteFile = true;
+            }
+            break;
+        case AutoLoggerEnum::DeleteSize:
+            if (totalFileSize >= conf.deleteWhenLogsReachBytes) {
+                deleteFile = true;
+            }
+            break;
+        case AutoLoggerEnum::KeepForever:
+            break;
+        default:
+            abort();
+        }
+        if (deleteFile) {
+            deleteFileSize += fileInfo.size();
+            filesToDelete.append(fileInfo);
+        }
+    }
+
+    if (filesToDelete.empty()) {
+        return;
+    }
+
+    if (conf.askDelete) {
+        if (const auto &onOldLogsFound = m_callbacks.onOldLogsFound) {
+            post([onOldLogsFound, filesToDelete, deleteFileSize]() {
+                onOldLogsFound(filesToDelete, deleteFileSize);
+            });
+        }
+    } else {
+        processDelete(filesToDelete);
+    }
+}
+
+void AsyncLogWriter::processDelete(const QFileInfoList &files)
+{
+    for (const auto &fileInfo : files) {
+        const QString filepath = fileInfo.absoluteFilePath();
+        if (filepath == m_output->path) {
+            continue;
+        }
+        QDir{}.remove(filepath);
+        qDebug() << "Deleted log " + filepath + ".";
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "../configuration/configuration.h"
+#include "../global/RuleOf5.h"
+#include "../global/macros.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <variant>
+
+#include <QFileInfoList>
+
+class QObject;
+
+// Does all of the AutoLogger's disk I/O on a background thread, so a slow disk
+// (e.g. a network home directory) never stalls the GUI thread during a session.
+//
+// Output is queued and written in large batches. If the queue fills up because the disk
+// can't keep up, new output is dropped (and a note saying so is logged) rather than
+// blocking the caller.
+//
+// The callbacks are invoked on the receiver's thread.
+class NODISCARD AsyncLogWriter final
+{
+public:
+    using Settings = Configuration::AutoLogSettings;
+    struct NODISCARD Callbacks final
+    {
+        std::function<void()> onCreateFailed;
+        // Only when the settings ask before deleting; call deleteLogs() to go ahead.
+        std::function<void(const QFileInfoList &files, qint64 totalBytes)> onOldLogsFound;
+    };
+
+    // The most output that can wait for the disk before new output is dropped.
+    static constexpr size_t MAX_QUEUED_BYTES = 8 * 1024 * 1024;
+
+private:
+    struct NODISCARD OpenCmd final
+    {
+        Settings settings;
+    };
+    struct NODISCARD WriteCmd final
+    {
+        std::string text;
+    };
+    struct NODISCARD CleanupCmd final
+    {
+        Settings settings;
+    };
+    struct NODISCARD DeleteCmd final
+    {
+        QFileInfoList files;
+    };
+    using Command = std::variant<OpenCmd, WriteCmd, CleanupCmd, DeleteCmd>;
+
+    struct NODISCARD Output;
+
+private:
+    QObject &m_receiver;
+    const std::string m_runId;
+    const Callbacks m_callbacks;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Command> m_queue;
+    size_t m_queuedBytes = 0;
+    uint64_t m_droppedBytes = 0;
+    bool m_stopping = false;
+
+    // only used by the writer thread
+    std::unique_ptr<Output> m_output;
+
+    std::thread m_thread;
+
+public:
+    explicit AsyncLogWriter(QObject &receiver, std::string runId, Callbacks callbacks);
+    // Writes everything that's still queued before returning.
+    ~AsyncLogWriter();
+    DELETE_CTORS_AND_ASSIGN_OPS(AsyncLogWriter);
+
+public:
+    // Starts a new log file.
+    void open(const Settings &settings);
+    void write(std::string text);
+    // Finds the old logs that the settings say should be deleted.
+    void cleanup(const Settings &settings);
+    void deleteLogs(const QFileInfoList &files);
+
+private:
+    void enqueue(Command cmd);
+    void post(std::function<void()> fn);
+    void run();
+    void process(Command &cmd);
+    void processOpen(const Settings &settings);
+    void processWrite(std::string_view text);
+    void processCleanup(const Settings &settings);
+    void processDelete(const QFileInfoList &files);
+    NODISCARD bool createFile();
+    NODISCARD bool hasUnwrittenOutput() const;
+    void writeBuffered(bool flush);
+    void closeFile();
+};
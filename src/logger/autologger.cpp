@@ -7,13 +7,12 @@
 #include "../configuration/configuration.h"
 #include "../global/TextUtils.h"
 #include "../global/random.h"
+#include "../global/utils.h"
+#include "asynclogwriter.h"
 
-#include <algorithm>
 #include <sstream>
 #include <tuple>
 
-#include <QDebug>
-#include <QFileInfo>
 #include <QMessageBox>
 #include <QStringList>
 
@@ -29,46 +28,16 @@ NODISCARD static std::string generateRunId()
 
 AutoLogger::AutoLogger(QObject *const parent)
     : QObject(parent)
-    , m_runId{generateRunId()}
-{}
-
-AutoLogger::~AutoLogger()
 {
-    m_logFile.flush();
-    m_logFile.close();
+    AsyncLogWriter::Callbacks callbacks;
+    callbacks.onCreateFailed = [this]() { onCreateFailed(); };
+    callbacks.onOldLogsFound = [this](const QFileInfoList &files, const qint64 totalBytes) {
+        onOldLogsFound(files, totalBytes);
+    };
+    m_writer = std::make_unique<AsyncLogWriter>(*this, generateRunId(), std::move(callbacks));
 }
 
-bool AutoLogger::createFile()
-{
-    if (m_logFile.is_open()) {
-        m_logFile.close();
-    }
-
-    const auto &settings = getConfig().autoLog;
-
-    const auto &path = settings.autoLogDirectory;
-    QDir dir;
-    if (dir.mkpath(path)) {
-        dir.setPath(path);
-    } else {
-        return false;
-    }
-
-    QString fileName = QString("MMapper_Log_%1_%2_%3.txt")
-                           .arg(QDate::currentDate().toString("yyyy_MM_dd"))
-                           .arg(QString::number(m_curFile))
-                           .arg(mmqt::toQStringUtf8(m_runId));
-    m_logFile.open(mmqt::toStdStringUtf8(dir.absoluteFilePath(fileName)),
-                   std::fstream::out | std::fstream::binary | std::fstream::app);
-    if (!m_logFile.is_open()) { // Could not create file.
-        return false;
-    }
-
-    m_curBytes = 0;
-    ++m_curFile;
-
-    return true;
-}
+AutoLogger::~AutoLogger() = default;
 
 bool AutoLogger::writeLine(const QString &str)
 {
@@ -76,119 +45,48 @@ bool AutoLogger::writeLine(const QString &str)
         return false;
     }
 
-    bool created = true;
-    if (!m_logFile.is_open()) {
-        created = createFile();
-
-    } else if (m_curBytes > getConfig().autoLog.rotateWhenLogsReachBytes) {
-        m_logFile.close();
-        created = createFile();
-    }
-    if (!created) {
-        setConfig().autoLog.autoLog = false;
-        QMessageBox::warning(checked_dynamic_downcast<QWidget *>(parent()), // MainWindow
-                             "MMapper AutoLogger",
-                             "Unable to create log file.\n\nLogging has been disabled.");
-        return false;
+    auto &writer = deref(m_writer);
+    if (!m_isOpen) {
+        writer.open(getConfig().autoLog);
+        m_isOpen = true;
     }
 
     // ANSI marks removed upstream by GameObserver
-    const auto &line = mmqt::toStdStringUtf8(str);
-
-    m_logFile << line;
-    m_logFile.flush();
-    m_curBytes += static_cast<int>(line.length());
-
+    writer.write(mmqt::toStdStringUtf8(str));
     return true;
 }
 
-void AutoLogger::deleteOldLogs()
+void AutoLogger::onCreateFailed()
 {
-    auto &conf = getConfig().autoLog;
-
-    if (conf.cleanupStrategy == AutoLoggerEnum::KeepForever) {
+    m_isOpen = false;
+    if (!getConfig().autoLog.autoLog) {
         return;
     }
 
-    auto fileInfoList = QDir(conf.autoLogDirectory)
-                            .entryInfoList(QStringList("MMapper_Log_*.txt"), QDir::Files);
-    if (fileInfoList.empty()) {
-        return;
-    }
-
-    // Sort files so we can delete the oldest
-    std::sort(fileInfoList.begin(), fileInfoList.end(), [](const auto &a, const auto &b) {
-        return a.birthTime() < b.birthTime();
-    });
-
-    qint64 totalFileSize = 0, deleteFileSize = 0;
-    QList<QFileInfo> filesToDelete;
-    const QDate &today = QDate::currentDate();
-    for (const auto &fileInfo : fileInfoList) {
-        totalFileSize += fileInfo.size();
-        bool deleteFile = false;
-        switch (conf.cleanupStrategy) {
-        case AutoLoggerEnum::DeleteDays:
-            if (fileInfo.birthTime().date().daysTo(today) >= conf.deleteWhenLogsReachDays) {
-                deleteFile = true;
-            }
-            break;
-        case AutoLoggerEnum::DeleteSize:
-            if (totalFileSize >= conf.deleteWhenLogsReachBytes) {
-                deleteFile = true;
-            }
-            break;
-        case AutoLoggerEnum::KeepForever:
-            break;
-        default:
-            abort();
-        }
-        if (deleteFile) {
-            deleteFileSize += fileInfo.size();
-            filesToDelete.append(fileInfo);
-        }
-    }
-
-    if (filesToDelete.empty()) {
-        return;
-    }
-
-    auto doDelete = [filesToDelete]() {
-        QFileInfoList fileList(filesToDelete);
-        deleteLogs(fileList);
-    };
-
-    if (conf.askDelete) {
-        QString unit = "KB";
-        QStringList list = {"MB", "GB", "TB"};
-        QStringListIterator it(list);
-        auto num = static_cast<double>(deleteFileSize / 1024);
-        while (num > 1024.0 && it.hasNext()) {
-            unit = it.next();
-            num /= 1024.0;
-        }
-        showDeleteDialog(QString("There are %1 %2 of old logs.\n\nDo you want to delete them?")
-                             .arg(QString::number(num, 'f', 1))
-                             .arg(unit),
-                         [doDelete](bool accepted) {
-                             if (accepted) {
-                                 doDelete();
-                             }
-                         });
-    } else {
-        doDelete();
-    }
+    setConfig().autoLog.autoLog = false;
+    QMessageBox::warning(checked_dynamic_downcast<QWidget *>(parent()), // MainWindow
+                         "MMapper AutoLogger",
+                         "Unable to create log file.\n\nLogging has been disabled.");
 }
 
-void AutoLogger::deleteLogs(const QFileInfoList &files)
+void AutoLogger::onOldLogsFound(const QFileInfoList &files, const qint64 totalBytes)
 {
-    for (const auto &fileInfo : files) {
-        QString filepath = fileInfo.absoluteFilePath();
-        QDir deletefile;
-        deletefile.setPath(filepath);
-        deletefile.remove(filepath);
-        qDebug() << "Deleted log " + filepath + ".";
+    QString unit = "KB";
+    QStringList list = {"MB", "GB", "TB"};
+    QStringListIterator it(list);
+    auto num = static_cast<double>(totalBytes / 1024);
+    while (num > 1024.0 && it.hasNext()) {
+        unit = it.next();
+        num /= 1024.0;
     }
+    showDeleteDialog(QString("There are %1 %2 of old logs.\n\nDo you want to delete them?")
+                         .arg(QString::number(num, 'f', 1))
+                         .arg(unit),
+                     [this, files](bool accepted) {
+                         if (accepted) {
+                             deref(m_writer).deleteLogs(files);
+                         }
+                     });
 }
 
 void AutoLogger::showDeleteDialog(QString message, std::function<void(bool)> callback)
@@ -218,13 +116,13 @@ void AutoLogger::slot_shouldLog(bool echo)
 
 void AutoLogger::slot_onConnected()
 {
+    auto &writer = deref(m_writer);
     if (getConfig().autoLog.cleanupStrategy != AutoLoggerEnum::KeepForever) {
-        deleteOldLogs();
+        writer.cleanup(getConfig().autoLog);
     }
 
     if (getConfig().autoLog.autoLog) {
-        if (!createFile()) {
-            qWarning() << "Unable to create log file for autologger.";
-        }
+        writer.open(getConfig().autoLog);
+        m_isOpen = true;
     }
 }
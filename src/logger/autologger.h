@@ -5,22 +5,23 @@
 
 #include "../global/macros.h"
 
-#include <fstream>
 #include <functional>
-#include <string>
+#include <memory>
 
 #include <QFileInfoList>
 #include <QObject>
 
+class AsyncLogWriter;
+
+// Decides what gets logged; the files themselves are written by an AsyncLogWriter,
+// so none of the disk I/O happens on the GUI thread.
 class NODISCARD_QOBJECT AutoLogger final : public QObject
 {
     Q_OBJECT
 
 private:
-    const std::string m_runId;
-    std::fstream m_logFile;
-    int m_curBytes = 0;
-    int m_curFile = 0;
+    std::unique_ptr<AsyncLogWriter> m_writer;
+    bool m_isOpen = false;
     bool m_shouldLog = true;
 
 public:
@@ -29,10 +30,9 @@ class NODISCARD_QOBJECT AutoLogger final : public QObject
 
 private:
     NODISCARD bool writeLine(const QString &str);
-    void deleteOldLogs();
-    static void deleteLogs(const QFileInfoList &files);
+    void onCreateFailed();
+    void onOldLogsFound(const QFileInfoList &files, qint64 totalBytes);
     void showDeleteDialog(QString message, std::function<void(bool)> callback);
-    NODISCARD bool createFile();
 
 public slots:
     void slot_writeToLog(const QString &str);
@@ -125,13 +125,27 @@ struct NODISCARD TasksPanel::ListItem final : public QWidget
                 return QString("%1... (%2%)").arg(tmp).arg(pct);
             });
 
-            return QString("Task #%1: %2 (%3) [elapsed: %4]\nStatus: %5")
+            const auto report = std::invoke([&pc]() -> QString {
+                std::ostringstream oss;
+                {
+                    AnsiOstream aos{oss};
+                    async_tasks::formatReport(aos, pc.getReport());
+                }
+                auto tmp = mmqt::toQStringUtf8(strip_ansi(oss.str()));
+                if (tmp.endsWith('\n')) {
+                    tmp.chop(1);
+                }
+                return tmp;
+            });
+
+            return QString("Task #%1: %2 (%3) [elapsed: %4]\nStatus: %5\n%6")
                 .arg(m_task.getId())
                 .arg(mmqt::toQStringUtf8(m_task.getName()))
                 .arg((m_task.getCanCancel() == AllowCancelEnum::Allow) ? "cancelable"
                                                                        : "non-cancelable")
                 .arg(elapsed)
-                .arg(statusMsg);
+                .arg(statusMsg)
+                .arg(report);
         });
 
         deref(m_label).setText(desc);
@@ -4,6 +4,7 @@
 #include "mainwindow-async.h"
 
 #include "../client/ClientWidget.h"
+#include "../configuration/configuration.h"
 #include "../display/MapCanvasData.h"
 #include "../display/mapcanvas.h"
 #include "../display/mapwindow.h"
@@ -16,6 +17,7 @@
 #include "../mapstorage/MapDestination.h"
 #include "../mapstorage/MmpMapStorage.h"
 #include "../mapstorage/PandoraMapStorage.h"
+#include "../mapstorage/RoomTextBlob.h"
 #include "../mapstorage/XmlMapStorage.h"
 #include "../mapstorage/jsonmapstorage.h"
 #include "../mapstorage/mapstorage.h"
@@ -31,6 +33,7 @@
 #include <optional>
 #include <sstream>
 #include <stdexcept>
+#include <tuple>
 
 #include <QString>
 #include <QXmlStreamReader>
@@ -217,6 +220,10 @@ NODISCARD std::optional<MapLoadData> load_map_data(AbstractMapStorage &storage)
     auto &data = opt_data.value();
     pc.reset();
 
+    if (getConfig().general.mapRoomTextOnDisk) {
+        std::ignore = room_text_blob::moveToMappedFile(pc, data.rooms);
+    }
+
     pc.setCurrentTask(ProgressMsg{/*"phase 2: "*/ "construct map from raw rooms and infomarks"});
     auto mapPair = Map::fromRooms(pc,
                                   std::exchange(data.rooms, {}),
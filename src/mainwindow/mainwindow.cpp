@@ -200,9 +200,14 @@ MainWindow::MainWindow()
         roomManager->setObjectName("RoomManager");
 
         deref(m_gameObserver)
-            .sig2_sentToUserGmcp.connect(m_lifetime, [this](const GmcpMessage &gmcp) {
-                deref(m_roomManager).slot_parseGmcpInput(gmcp);
-            });
+            .sentToUserGmcp.subscribe({GmcpMessageTypeEnum::ROOM_CHARS_ADD,
+                                       GmcpMessageTypeEnum::ROOM_CHARS_REMOVE,
+                                       GmcpMessageTypeEnum::ROOM_CHARS_SET,
+                                       GmcpMessageTypeEnum::ROOM_CHARS_UPDATE},
+                                      m_lifetime,
+                                      [this](const GmcpMessage &gmcp) {
+                                          deref(m_roomManager).slot_parseGmcpInput(gmcp);
+                                      });
 
         m_roomManager = roomManager;
     });
@@ -5,7 +5,16 @@
 #include "RawRoom.h"
 #include "room.h"
 
+#include <optional>
+
 NODISCARD extern ComparisonResultEnum compare(const RawRoom &,
                                               const ParseEvent &event,
                                               int tolerance);
 NODISCARD extern ComparisonResultEnum compareWeakProps(const RawRoom &, const ParseEvent &event);
+
+// Fast path for a room that was found by the event's server id: since server ids are unique,
+// only the cheap properties are checked, and exact string equality decides between EQUAL and
+// TOLERANCE (i.e. whether the room needs an update). Returns std::nullopt if the ids differ
+// or the weak properties disagree; callers should then fall back to compare().
+NODISCARD extern std::optional<ComparisonResultEnum> compareByServerId(const RawRoom &,
+                                                                       const ParseEvent &event);
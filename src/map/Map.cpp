@@ -19,7 +19,9 @@
 #include "World.h"
 #include "WorldBuilder.h"
 #include "enums.h"
+#include "room.h"
 
+#include <algorithm>
 #include <chrono>
 #include <map>
 #include <memory>
@@ -2014,6 +2016,34 @@ void testDoorVsExitFlags()
     check(ExpectDoorEnum::None);
 }
 
+void testSimilarDescKeys()
+{
+    const std::string desc
+        = "The narrow path winds between tall old trees here. To the north you can see a\n"
+          "small clearing, and the sound of running water comes from somewhere to the east.\n"
+          "Moss covers the ground and the air smells of pine and damp earth.\n";
+    const std::string edited
+        = "The narrow path winds between tall old trees here. To the north you can see a\n"
+          "tiny clearing, and the sound of running water comes from somewhere to the east.\n"
+          "Moss covers the ground and the air smells of pine and damp earth.\n";
+    const std::string other = "A dark cave opens up before you. Water drips from the ceiling\n"
+                              "and the floor is slick with mud.\n";
+
+    const auto keys = getSimilarDescKeys(desc);
+    TEST_ASSERT(keys.size() == NUM_SIMILAR_DESC_BANDS);
+    TEST_ASSERT(getSimilarDescKeys(desc) == keys);
+    TEST_ASSERT(getSimilarDescKeys("").empty());
+    TEST_ASSERT(getSimilarDescKeys(" \n").empty());
+
+    const auto countShared = [&keys](const std::vector<uint64_t> &otherKeys) -> size_t {
+        return static_cast<size_t>(std::count_if(keys.begin(), keys.end(), [&otherKeys](auto k) {
+            return std::find(otherKeys.begin(), otherKeys.end(), k) != otherKeys.end();
+        }));
+    };
+    TEST_ASSERT(countShared(getSimilarDescKeys(edited)) > 0);
+    TEST_ASSERT(countShared(getSimilarDescKeys(other)) == 0);
+}
+
 } // namespace
 
 namespace test {
@@ -2027,6 +2057,8 @@ void testMap()
     testAddingInvalidEnums();
     testConstructingInvalidEnums();
     testDoorVsExitFlags();
+    testSimilarDescKeys();
+    test::testCompareStrings();
     test::test_mmapper2room();
 }
 } // namespace test
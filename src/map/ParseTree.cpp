@@ -9,33 +9,180 @@
 #include "../global/PrintUtils.h"
 #include "../global/Timer.h"
 #include "../global/logging.h"
+#include "../global/progresscounter.h"
+#include "../global/thread_utils.h"
 #include "Compare.h"
 #include "Map.h"
 #include "World.h"
 
+#include <algorithm>
+#include <array>
 #include <deque>
 #include <optional>
 #include <string_view>
+#include <vector>
+
+// A parse key usually matches a handful of rooms; only resyncing in a repetitive area
+// (e.g. a maze of identical tunnels) yields hundreds. Each candidate costs a room lookup
+// plus a tolerant compare, and the parallel path also has to merge the per-thread match
+// lists, so it only pays off for those large sets.
+static constexpr size_t MIN_PARALLEL_CANDIDATES = 512;
+
+namespace { // anonymous
+
+// 32 MinHash values grouped into 8 bands of 4 rows: two descriptions sharing 90% of their
+// words end up in a common bucket with probability ~0.9998, while descriptions sharing only
+// 30% of their words do so with probability ~0.06.
+constexpr size_t SIMILAR_DESC_ROWS_PER_BAND = 4;
+constexpr size_t NUM_SIMILAR_DESC_HASHES = NUM_SIMILAR_DESC_BANDS * SIMILAR_DESC_ROWS_PER_BAND;
+
+// splitmix64 finalizer
+NODISCARD constexpr uint64_t mix64(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+// FNV-1a
+NODISCARD constexpr uint64_t hashWord(const std::string_view word)
+{
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (const char c : word) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
+
+NODISCARD constexpr bool isWordSeparator(const char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+} // namespace
+
+std::vector<uint64_t> getSimilarDescKeys(const std::string_view desc)
+{
+    std::array<uint64_t, NUM_SIMILAR_DESC_HASHES> minHashes;
+    minHashes.fill(~uint64_t{0});
+
+    bool hasWords = false;
+    size_t pos = 0;
+    while (pos < desc.size()) {
+        if (isWordSeparator(desc[pos])) {
+            ++pos;
+            continue;
+        }
+        const size_t begin = pos;
+        while (pos < desc.size() && !isWordSeparator(desc[pos])) {
+            ++pos;
+        }
+
+        hasWords = true;
+        const uint64_t h = hashWord(desc.substr(begin, pos - begin));
+        for (size_t i = 0; i < NUM_SIMILAR_DESC_HASHES; ++i) {
+            minHashes[i] = std::min(minHashes[i], mix64(h + (i + 1) * 0x9E3779B97F4A7C15ull));
+        }
+    }
+
+    if (!hasWords) {
+        return {};
+    }
+
+    std::vector<uint64_t> keys;
+    keys.reserve(NUM_SIMILAR_DESC_BANDS);
+    for (size_t band = 0; band < NUM_SIMILAR_DESC_BANDS; ++band) {
+        uint64_t key = mix64(band + 1);
+        for (size_t row = 0; row < SIMILAR_DESC_ROWS_PER_BAND; ++row) {
+            key = mix64(key ^ minHashes[band * SIMILAR_DESC_ROWS_PER_BAND + row]);
+        }
+        keys.push_back(key);
+    }
+    return keys;
+}
 
 RoomIdSet getRooms(const Map &map, const ParseTree &tree, const ParseEvent &event)
 {
     DECL_TIMER(t0, "overall");
 
+    static volatile bool fallbackToSimilarDesc = true;
     static volatile bool fallbackToCurrentArea = true;
     static volatile bool fallbackToRemainder = true;
     static volatile bool fallbackToWholeMap = true;
 
-    const auto *const pSet = std::invoke([&map, &event, &tree]() -> const ImmUnorderedRoomIdSet * {
-        DECL_TIMER(t1, "part0. lookup rooms in areas");
-        const World &world = map.getWorld();
-        const RoomArea &areaName = event.getRoomArea();
+    const RoomName &name = event.getRoomName();
+    const RoomDesc &desc = event.getRoomDesc();
+    const bool hasName = !name.empty();
+    const bool hasDesc = !desc.empty();
 
-        const RoomName &name = event.getRoomName();
-        const RoomDesc &desc = event.getRoomDesc();
+    const auto filterCandidates = [&map, &event](std::vector<RoomId> candidates) -> RoomIdSet {
+        DECL_TIMER(t2, "part2. for(...) tryReport() ");
 
-        const bool hasName = !name.empty();
-        const bool hasDesc = !desc.empty();
+        const int tolerance = getConfig().pathMachine.matchingTolerance;
+        auto tryReport = [&event, tolerance](const RoomHandle &room) {
+            if (::compare(room.getRaw(), event, tolerance) == ComparisonResultEnum::DIFFERENT) {
+                return false;
+            }
+            return true;
+        };
+
+        MMLOG() << "[getRooms] Found " << candidates.size() << " potential match(es).";
 
+        // Comparing a candidate is pure, so large sets (e.g. thousands of identical tunnels
+        // when resyncing) are scored in parallel; the matches are merged serially.
+        struct NODISCARD ThreadLocals final
+        {
+            std::vector<RoomId> matches;
+        };
+        const auto scoreRange =
+            [&map, &tryReport](ThreadLocals &tl, const auto chunkBegin, const auto chunkEnd) {
+                for (auto it = chunkBegin; it != chunkEnd; ++it) {
+                    const auto optRoom = map.findRoomHandle(*it);
+                    if (optRoom && tryReport(optRoom)) {
+                        tl.matches.push_back(*it);
+                    }
+                }
+            };
+
+        std::vector<RoomId> matches;
+        if (candidates.size() < MIN_PARALLEL_CANDIDATES) {
+            ThreadLocals tl;
+            scoreRange(tl, candidates.begin(), candidates.end());
+            matches = std::move(tl.matches);
+        } else {
+            ProgressCounter dummyPc;
+            thread_utils::parallel_for_each_tl_range<ThreadLocals>(
+                candidates, dummyPc, scoreRange, [&matches](auto &thread_locals) {
+                    for (auto &tl : thread_locals) {
+                        matches.insert(matches.end(), tl.matches.begin(), tl.matches.end());
+                    }
+                });
+        }
+
+        RoomIdSet results;
+        for (const RoomId id : matches) {
+            results.insert(id);
+        }
+        const size_t numReported = matches.size();
+
+        MMLOG() << "[getRooms] Reported " << numReported << " potential match(es).";
+        return results;
+    };
+
+    const auto filterRoomsByEvent = [&filterCandidates](const auto &set) -> RoomIdSet {
+        std::vector<RoomId> candidates;
+        candidates.reserve(set.size());
+        set.for_each([&candidates](const RoomId id) { candidates.push_back(id); });
+        return filterCandidates(std::move(candidates));
+    };
+
+    const auto *const pExact = std::invoke([&tree, &name, &desc, hasName, hasDesc]()
+                                               -> const ImmUnorderedRoomIdSet * {
+        DECL_TIMER(t1, "part0. lookup rooms by name and desc");
         if (hasName && hasDesc) {
             if (auto set = tree.name_desc.find(NameDesc{name, desc})) {
                 return set;
@@ -55,6 +202,44 @@ RoomIdSet getRooms(const Map &map, const ParseTree &tree, const ParseEvent &even
                 return ptr;
             }
         }
+        return nullptr;
+    });
+
+    if (pExact != nullptr) {
+        return filterRoomsByEvent(*pExact);
+    }
+
+    if (fallbackToSimilarDesc && hasDesc) {
+        DECL_TIMER(t1, "part0. lookup rooms with similar desc");
+        MMLOG() << "[getRooms] Falling back to rooms with a similar desc...";
+
+        std::vector<RoomId> candidates;
+        {
+            RoomIdSet seen;
+            for (const uint64_t key : getSimilarDescKeys(desc.getStdStringViewUtf8())) {
+                if (const auto *const set = tree.desc_similar.find(key)) {
+                    set->for_each([&seen, &candidates](const RoomId id) {
+                        if (!seen.contains(id)) {
+                            seen.insert(id);
+                            candidates.push_back(id);
+                        }
+                    });
+                }
+            }
+        }
+
+        if (!candidates.empty()) {
+            auto results = filterCandidates(std::move(candidates));
+            if (!results.empty()) {
+                return results;
+            }
+        }
+    }
+
+    const auto *const pSet = std::invoke([&map, &event]() -> const ImmUnorderedRoomIdSet * {
+        DECL_TIMER(t1, "part0. lookup rooms in areas");
+        const World &world = map.getWorld();
+        const RoomArea &areaName = event.getRoomArea();
 
         if (fallbackToCurrentArea) {
             MMLOG() << "[getRooms] Falling back to the current area!";
@@ -83,34 +268,6 @@ RoomIdSet getRooms(const Map &map, const ParseTree &tree, const ParseEvent &even
         return nullptr;
     });
 
-    const auto filterRoomsByEvent = [&map, &event](const auto &set) -> RoomIdSet {
-        DECL_TIMER(t2, "part2. for(...) tryReport() ");
-
-        const int tolerance = getConfig().pathMachine.matchingTolerance;
-        auto tryReport = [&event, tolerance](const RoomHandle &room) {
-            if (::compare(room.getRaw(), event, tolerance) == ComparisonResultEnum::DIFFERENT) {
-                return false;
-            }
-            return true;
-        };
-
-        MMLOG() << "[getRooms] Found " << set.size() << " potential match(es).";
-
-        RoomIdSet results;
-        size_t numReported = 0;
-        set.for_each([&map, &numReported, &results, &tryReport](const RoomId id) {
-            if (const auto optRoom = map.findRoomHandle(id)) {
-                if (tryReport(optRoom)) {
-                    results.insert(id);
-                    ++numReported;
-                }
-            }
-        });
-
-        MMLOG() << "[getRooms] Reported " << numReported << " potential match(es).";
-        return results;
-    };
-
     if (pSet == nullptr) {
         DECL_TIMER(t2, "part1. fallback to whole map");
         if (fallbackToWholeMap) {
@@ -155,6 +312,7 @@ void ParseTree::printStats(ProgressCounter & /*pc*/, AnsiOstream &os) const
         os << "Total name combinations:              " << C(total_name) << ".\n";
         os << "Total desc combinations:              " << C(total_desc) << ".\n";
         os << "Total name+desc combinations:         " << C(total_name_desc) << ".\n";
+        os << "Total similar-desc buckets:           " << C(desc_similar.size()) << ".\n";
 
         const auto countUnique = [](const auto &map) -> size_t {
             return static_cast<size_t>(std::count_if(std::begin(map), std::end(map), [](auto &kv) {
@@ -8,8 +8,11 @@
 #include "RoomIdSet.h"
 #include "mmapper2room.h"
 
+#include <cstdint>
 #include <ostream>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 class AnsiOstream;
 class Map;
@@ -61,11 +64,20 @@ DEFINE_FLAGS_BITOP_OR(ParseKeyFlags)
 static constexpr const ParseKeyFlags ALL_PARSE_KEY_FLAGS = ~ParseKeyFlags{};
 static_assert(ALL_PARSE_KEY_FLAGS == (ParseKeyEnum::Name | ParseKeyEnum::Desc));
 
+static constexpr const size_t NUM_SIMILAR_DESC_BANDS = 8;
+
+// Locality-sensitive (MinHash) bucket keys for the set of words in a room description.
+// Descriptions that differ by only a few words share at least one key with high probability,
+// so these are used to find candidates for a tolerant match without scanning the whole map.
+// Returns an empty vector for an empty description.
+NODISCARD extern std::vector<uint64_t> getSimilarDescKeys(std::string_view desc);
+
 struct NODISCARD ParseTreeInitializer final
 {
     std::unordered_map<RoomName, ImmUnorderedRoomIdSet> name_only;
     std::unordered_map<RoomDesc, ImmUnorderedRoomIdSet> desc_only;
     std::unordered_map<NameDesc, ImmUnorderedRoomIdSet> name_desc;
+    std::unordered_map<uint64_t, ImmUnorderedRoomIdSet> desc_similar;
 };
 
 struct NODISCARD ParseTree final
@@ -73,18 +85,21 @@ struct NODISCARD ParseTree final
     ImmUnorderedMap<RoomName, ImmUnorderedRoomIdSet> name_only;
     ImmUnorderedMap<RoomDesc, ImmUnorderedRoomIdSet> desc_only;
     ImmUnorderedMap<NameDesc, ImmUnorderedRoomIdSet> name_desc;
+    // see getSimilarDescKeys()
+    ImmUnorderedMap<uint64_t, ImmUnorderedRoomIdSet> desc_similar;
 
     void init(const ParseTreeInitializer &input)
     {
         name_only.init(input.name_only);
         desc_only.init(input.desc_only);
         name_desc.init(input.name_desc);
+        desc_similar.init(input.desc_similar);
     }
 
     NODISCARD bool operator==(const ParseTree &rhs) const
     {
         return name_only == rhs.name_only && desc_only == rhs.desc_only
-               && name_desc == rhs.name_desc;
+               && name_desc == rhs.name_desc && desc_similar == rhs.desc_similar;
     }
     NODISCARD bool operator!=(const ParseTree &rhs) const { return !(rhs == *this); }
 
@@ -308,6 +308,9 @@ void World::insertParse(const RoomId id, const ParseKeyFlags parseKeys)
     }
     if (parseKeys.contains(ParseKeyEnum::Desc)) {
         insertId(m_parseTree.desc_only, desc, id);
+        for (const uint64_t key : getSimilarDescKeys(desc.getStdStringViewUtf8())) {
+            insertId(m_parseTree.desc_similar, key, id);
+        }
     }
     if (parseKeys.contains(ParseKeyEnum::Name) || parseKeys.contains(ParseKeyEnum::Desc)) {
         const NameDesc nameDesc{name, desc};
@@ -328,6 +331,9 @@ void World::removeParse(const RoomId id, const ParseKeyFlags parseKeys)
     }
     if (parseKeys.contains(ParseKeyEnum::Desc)) {
         removeId(m_parseTree.desc_only, desc, id);
+        for (const uint64_t key : getSimilarDescKeys(desc.getStdStringViewUtf8())) {
+            removeId(m_parseTree.desc_similar, key, id);
+        }
     }
     if (parseKeys.contains(ParseKeyEnum::Name) || parseKeys.contains(ParseKeyEnum::Desc)) {
         const NameDesc nameDesc{name, desc};
@@ -665,6 +671,13 @@ void World::checkConsistency(ProgressCounter &counter) const
             throw MapConsistencyError("unable to find room desc only");
         }
 
+        for (const uint64_t key : getSimilarDescKeys(desc.getStdStringViewUtf8())) {
+            if (auto set = m_parseTree.desc_similar.find(key);
+                set == nullptr || !set->contains(id)) {
+                throw MapConsistencyError("unable to find room similar desc");
+            }
+        }
+
         {
             const NameDesc nameDesc{name, desc};
             if (auto set = m_parseTree.name_desc.find(nameDesc);
@@ -1234,6 +1247,14 @@ World World::init(ProgressCounter &counter,
                     tmp.name_desc[nameDesc].insert(room.id);
                     counter.step();
                 }
+                // The similarity keys only depend on the desc, so they're computed once
+                // per distinct desc.
+                for (const auto &[desc, ids] : tmp.desc_only) {
+                    for (const uint64_t key : getSimilarDescKeys(desc.getStdStringViewUtf8())) {
+                        auto &bucket = tmp.desc_similar[key];
+                        ids.for_each([&bucket](const RoomId id) { bucket.insert(id); });
+                    }
+                }
                 return tmp;
             });
 
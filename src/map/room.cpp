@@ -5,11 +5,15 @@
 
 #include "room.h"
 
+#include "../global/Charset.h"
+#include "../global/SimdUtils.h"
 #include "../global/StringView.h"
+#include "../global/tests.h"
 #include "Compare.h"
 #include "RoomHandle.h"
 #include "parseevent.h"
 
+#include <algorithm>
 #include <sstream>
 #include <vector>
 
@@ -31,47 +35,104 @@ void RoomModificationTracker::notifyModified(const RoomUpdateFlags updateFlags)
     virt_onNotifyModified(updateFlags);
 }
 
-NODISCARD static int wordDifference(StringView a, StringView b)
+namespace { // anonymous
+
+NODISCARD std::string_view trimLeft(std::string_view sv) noexcept
+{
+    while (!sv.empty() && ascii::isSpace(sv.front())) {
+        sv.remove_prefix(1);
+    }
+    return sv;
+}
+
+NODISCARD std::string_view trim(std::string_view sv) noexcept
+{
+    sv = trimLeft(sv);
+    while (!sv.empty() && ascii::isSpace(sv.back())) {
+        sv.remove_suffix(1);
+    }
+    return sv;
+}
+
+// Same as StringView::takeFirstWord(): removes the first word and any spaces that follow it.
+NODISCARD std::string_view takeFirstWord(std::string_view &sv) noexcept
+{
+    const auto len = simd_utils::findFirstSpace(sv);
+    const auto word = sv.substr(0, len);
+    sv = trimLeft(sv.substr(len));
+    return word;
+}
+
+NODISCARD int wordDifference(const std::string_view a, const std::string_view b) noexcept
 {
-    size_t diff = 0;
-    while (!a.isEmpty() && !b.isEmpty()) {
-        if (a.takeFirstLetter() != b.takeFirstLetter()) {
-            ++diff;
+    const auto common = std::min(a.size(), b.size());
+    const auto diff = simd_utils::countMismatches(a, b) + (a.size() - common) + (b.size() - common);
+    return static_cast<int>(diff);
+}
+
+NODISCARD bool isWordBoundary(const std::string_view sv, const size_t pos) noexcept
+{
+    return pos == sv.size() || ascii::isSpace(sv[pos]);
+}
+
+// Removes the leading words that are byte-for-byte identical in both strings;
+// the word-by-word loop would count them as zero difference anyway.
+void skipCommonWords(std::string_view &a, std::string_view &b) noexcept
+{
+    auto pos = simd_utils::mismatch(a, b);
+    if (pos == 0) {
+        return;
+    }
+    if (!isWordBoundary(a, pos) || !isWordBoundary(b, pos)) {
+        // back up to the start of the word that differs
+        while (pos > 0 && !ascii::isSpace(a[pos - 1])) {
+            --pos;
+        }
+        if (pos == 0) {
+            return;
         }
     }
-    return static_cast<int>(diff + a.size() + b.size());
+    a = trimLeft(a.substr(pos));
+    b = trimLeft(b.substr(pos));
 }
 
+} // namespace
+
 ComparisonResultEnum compareStrings(const std::string_view room,
                                     const std::string_view event,
                                     int prevTolerance,
                                     const bool upToDate)
 {
+    if (room == event) {
+        return ComparisonResultEnum::EQUAL;
+    }
+
     prevTolerance = utils::clampNonNegative(prevTolerance);
     prevTolerance *= static_cast<int>(room.size());
     prevTolerance /= 100;
     int tolerance = prevTolerance;
 
-    auto descWords = StringView{room}.trim();
-    auto eventWords = StringView{event}.trim();
+    auto descWords = trim(room);
+    auto eventWords = trim(event);
 
-    if (!eventWords.isEmpty()) {
+    if (!eventWords.empty()) {
         // if event is empty we don't compare (due to blindness)
         while (tolerance >= 0) {
-            if (descWords.isEmpty()) {
+            skipCommonWords(descWords, eventWords);
+            if (descWords.empty()) {
                 if (upToDate) {
                     // the desc is allowed to be shorter than the event
-                    tolerance -= eventWords.countNonSpaceChars();
+                    tolerance -= static_cast<int>(simd_utils::countNonSpace(eventWords));
                 }
                 break;
             }
-            if (eventWords.isEmpty()) {
+            if (eventWords.empty()) {
                 // if we get here the event isn't empty
-                tolerance -= descWords.countNonSpaceChars();
+                tolerance -= static_cast<int>(simd_utils::countNonSpace(descWords));
                 break;
             }
 
-            tolerance -= wordDifference(eventWords.takeFirstWord(), descWords.takeFirstWord());
+            tolerance -= wordDifference(takeFirstWord(eventWords), takeFirstWord(descWords));
         }
     }
 
@@ -167,6 +228,24 @@ ComparisonResultEnum compare(const RawRoom &room, const ParseEvent &event, const
     return ComparisonResultEnum::TOLERANCE;
 }
 
+std::optional<ComparisonResultEnum> compareByServerId(const RawRoom &room, const ParseEvent &event)
+{
+    if (!event.hasServerId() || room.getServerId() != event.getServerId()) {
+        return std::nullopt;
+    }
+
+    if (room.getTerrainType() != event.getTerrainType()
+        || compareWeakProps(room, event) != ComparisonResultEnum::EQUAL) {
+        return std::nullopt;
+    }
+
+    if (room.getName() == event.getRoomName() && room.getDescription() == event.getRoomDesc()
+        && room.getArea() == event.getRoomArea()) {
+        return ComparisonResultEnum::EQUAL;
+    }
+    return ComparisonResultEnum::TOLERANCE;
+}
+
 ComparisonResultEnum compareWeakProps(const RawRoom &room, const ParseEvent &event)
 {
     bool exitsValid = true;
@@ -327,3 +406,124 @@ ComparisonResultEnum compareWeakProps(const RawRoom &room, const ParseEvent &eve
     }
     return ComparisonResultEnum::EQUAL;
 }
+
+namespace { // anonymous
+
+// The word-by-word implementation that compareStrings() replaced; kept as the oracle.
+NODISCARD ComparisonResultEnum referenceCompareStrings(const std::string_view room,
+                                                       const std::string_view event,
+                                                       int prevTolerance,
+                                                       const bool upToDate)
+{
+    auto wordDiff = [](StringView a, StringView b) -> int {
+        size_t diff = 0;
+        while (!a.isEmpty() && !b.isEmpty()) {
+            if (a.takeFirstLetter() != b.takeFirstLetter()) {
+                ++diff;
+            }
+        }
+        return static_cast<int>(diff + a.size() + b.size());
+    };
+
+    prevTolerance = utils::clampNonNegative(prevTolerance);
+    prevTolerance *= static_cast<int>(room.size());
+    prevTolerance /= 100;
+    int tolerance = prevTolerance;
+
+    auto descWords = StringView{room}.trim();
+    auto eventWords = StringView{event}.trim();
+
+    if (!eventWords.isEmpty()) {
+        while (tolerance >= 0) {
+            if (descWords.isEmpty()) {
+                if (upToDate) {
+                    tolerance -= eventWords.countNonSpaceChars();
+                }
+                break;
+            }
+            if (eventWords.isEmpty()) {
+                tolerance -= descWords.countNonSpaceChars();
+                break;
+            }
+            tolerance -= wordDiff(eventWords.takeFirstWord(), descWords.takeFirstWord());
+        }
+    }
+
+    if (tolerance < 0) {
+        return ComparisonResultEnum::DIFFERENT;
+    } else if (prevTolerance != tolerance) {
+        return ComparisonResultEnum::TOLERANCE;
+    } else if (event.size() != room.size()) {
+        return ComparisonResultEnum::TOLERANCE;
+    }
+    return ComparisonResultEnum::EQUAL;
+}
+
+} // namespace
+
+void test::testCompareStrings()
+{
+    const std::vector<std::string> descs{
+        "",
+        "The Prancing Pony",
+        "You are standing in the common room of the Prancing Pony. Tables and benches\n"
+        "are scattered about, and a large fire crackles in the hearth to the east.\n"
+        "A door leads out to the yard, and a passage leads north into the inn.\n",
+        "This narrow road winds its way between the hills. The grass grows tall on\n"
+        "either side, and here and there a lonely tree stands against the sky.\n",
+        "   Leading\tspaces and\r\nodd   whitespace   \n",
+        "A tiny clearing.",
+    };
+
+    // deterministic edits: substitutions, insertions, deletions, whitespace changes,
+    // and words being split or merged
+    uint32_t seed = 12345;
+    auto next = [&seed](const size_t n) -> size_t {
+        seed = seed * 1103515245u + 12345u;
+        return n == 0 ? 0 : static_cast<size_t>((seed >> 8) % n);
+    };
+    auto edit = [&next](std::string s) -> std::string {
+        const auto numEdits = next(4);
+        for (size_t k = 0; k < numEdits && !s.empty(); ++k) {
+            const auto pos = next(s.size());
+            switch (next(6)) {
+            case 0:
+                s[pos] = static_cast<char>('a' + next(26));
+                break;
+            case 1:
+                s.insert(pos, 1, static_cast<char>('a' + next(26)));
+                break;
+            case 2:
+                s.erase(pos, 1);
+                break;
+            case 3:
+                s.insert(pos, 1, next(2) == 0 ? ' ' : '\n');
+                break;
+            case 4:
+                if (ascii::isSpace(s[pos])) {
+                    s.erase(pos, 1);
+                }
+                break;
+            default:
+                s.insert(pos, "x");
+                break;
+            }
+        }
+        return s;
+    };
+
+    for (const auto &desc : descs) {
+        for (int round = 0; round < 200; ++round) {
+            const auto a = edit(desc);
+            const auto b = edit(desc);
+            for (int tolerance = 0; tolerance <= 20; tolerance += 5) {
+                for (const bool upToDate : {true, false}) {
+                    TEST_ASSERT(compareStrings(a, b, tolerance, upToDate)
+                                == referenceCompareStrings(a, b, tolerance, upToDate));
+                    TEST_ASSERT(compareStrings(b, a, tolerance, upToDate)
+                                == referenceCompareStrings(b, a, tolerance, upToDate));
+                }
+            }
+        }
+    }
+}
@@ -101,3 +101,7 @@ NODISCARD extern ComparisonResultEnum compareStrings(std::string_view room,
                                                      std::string_view event,
                                                      int prevTolerance,
                                                      bool upToDate = true);
+
+namespace test {
+extern void testCompareStrings();
+} // namespace test
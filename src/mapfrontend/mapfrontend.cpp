@@ -6,6 +6,7 @@
 
 #include "mapfrontend.h"
 
+#include "../global/PerfStats.h"
 #include "../global/SendToUser.h"
 #include "../global/Timer.h"
 #include "../global/logging.h"
@@ -240,6 +241,8 @@ bool MapFrontend::applyChangesInternal(
     ProgressCounter &pc,
     const std::function<MapApplyResult(Map &, ProgressCounter &)> &applyFunction)
 {
+    DECL_PERF_TIMER(t, MapChanges);
+
     Map previous = m_current.map;
 
     MapApplyResult result;
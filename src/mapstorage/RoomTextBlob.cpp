@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "RoomTextBlob.h"
+
+#include "../global/RuleOf5.h"
+#include "../global/logging.h"
+#include "../global/progresscounter.h"
+#include "../global/utils.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include <QDir>
+#include <QStandardPaths>
+#include <QTemporaryFile>
+
+namespace { // anonymous
+
+struct NODISCARD Span final
+{
+    size_t offset = 0;
+    size_t length = 0;
+};
+
+struct NODISCARD RoomSpans final
+{
+    Span desc;
+    Span contents;
+};
+
+// Owns the cache file and its mapping; the file is removed when this is destroyed.
+class NODISCARD MappedFile final
+{
+private:
+    QTemporaryFile m_file;
+    uchar *m_data = nullptr;
+
+public:
+    MappedFile() = default;
+    ~MappedFile()
+    {
+        if (m_data != nullptr) {
+            std::ignore = m_file.unmap(m_data);
+        }
+    }
+    DELETE_CTORS_AND_ASSIGN_OPS(MappedFile);
+
+public:
+    NODISCARD bool create(const std::string &bytes)
+    {
+        // Not QDir::tempPath(): /tmp is often a tmpfs, which would keep the text in RAM.
+        const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+        if (dir.isEmpty() || !QDir{}.mkpath(dir)) {
+            return false;
+        }
+
+        m_file.setFileTemplate(dir + "/roomtext-XXXXXX");
+        if (!m_file.open()) {
+            return false;
+        }
+
+        const auto size = static_cast<qint64>(bytes.size());
+        if (m_file.write(bytes.data(), size) != size || !m_file.flush()) {
+            return false;
+        }
+
+        m_data = m_file.map(0, size);
+        return m_data != nullptr;
+    }
+
+    NODISCARD std::string_view view(const Span &span) const
+    {
+        return std::string_view{reinterpret_cast<const char *>(m_data) + span.offset, span.length};
+    }
+};
+
+} // namespace
+
+namespace room_text_blob {
+
+bool moveToMappedFile(ProgressCounter &counter, std::vector<ExternalRawRoom> &rooms)
+{
+    counter.setCurrentTask(ProgressMsg{"moving room text to disk"});
+    counter.increaseTotalStepsBy(rooms.size() * 2);
+
+    // The keys view strings owned by the rooms, so they must not be modified in this pass.
+    std::string blob;
+    std::vector<RoomSpans> spans;
+    spans.reserve(rooms.size());
+    {
+        std::unordered_map<std::string_view, size_t> offsets;
+        auto intern = [&blob, &offsets](const std::string_view sv) -> Span {
+            if (sv.empty()) {
+                return Span{};
+            }
+            const auto [it, inserted] = offsets.emplace(sv, blob.size());
+            if (inserted) {
+                blob.append(sv);
+            }
+            return Span{it->second, sv.size()};
+        };
+
+        for (const ExternalRawRoom &room : rooms) {
+            const RoomFields &fields = room.fields;
+            RoomSpans &s = spans.emplace_back();
+            s.desc = intern(fields.Description.getStdStringViewUtf8());
+            s.contents = intern(fields.Contents.getStdStringViewUtf8());
+            counter.step();
+        }
+    }
+
+    if (blob.empty()) {
+        return false;
+    }
+
+    auto file = std::make_shared<MappedFile>();
+    if (!deref(file).create(blob)) {
+        MMLOG_WARNING() << "Unable to map room text to a cache file; keeping it in memory.";
+        return false;
+    }
+
+    const std::shared_ptr<const void> owner = file;
+    const MappedFile &mapped = deref(file);
+    const size_t count = rooms.size();
+    for (size_t i = 0; i < count; ++i) {
+        RoomFields &fields = rooms[i].fields;
+        const RoomSpans &s = spans[i];
+        fields.Description = RoomDesc::fromSharedStorage(owner, mapped.view(s.desc));
+        fields.Contents = RoomContents::fromSharedStorage(owner, mapped.view(s.contents));
+        counter.step();
+    }
+
+    MMLOG() << "Moved " << blob.size() << " bytes of room text to a memory-mapped file.";
+    return true;
+}
+
+} // namespace room_text_blob
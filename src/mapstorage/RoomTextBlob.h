@@ -0,0 +1,28 @@
+#pragma once
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "../global/macros.h"
+#include "../map/RawRoom.h"
+
+#include <vector>
+
+class ProgressCounter;
+
+/*! \brief Moves room descriptions and contents into a memory-mapped cache file.
+ *
+ * Identical strings are only stored once, and each room's RoomDesc and RoomContents
+ * become views into the mapping; the mapping stays alive as long as any of them does.
+ * Since the pages are backed by a file in the user's cache directory (not the temp
+ * directory, which is often RAM-backed), the OS can drop them under memory pressure
+ * and fault them back in when a room's text is actually read.
+ *
+ * Enabled by "Keep room text on disk" in the General preferences.
+ *
+ * Returns false (and leaves the rooms untouched) if the file can't be created or mapped,
+ * e.g. on platforms that don't support memory-mapped files.
+ */
+namespace room_text_blob {
+NODISCARD extern bool moveToMappedFile(ProgressCounter &counter,
+                                       std::vector<ExternalRawRoom> &rooms);
+} // namespace room_text_blob
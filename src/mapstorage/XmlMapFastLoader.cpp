@@ -0,0 +1,887 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "XmlMapFastLoader.h"
+
+#include "../global/Charset.h"
+#include "../global/progresscounter.h"
+#include "../global/thread_utils.h"
+#include "../map/DoorFlags.h"
+#include "../map/ExitDirection.h"
+#include "../map/ExitFieldVariant.h"
+#include "../map/ExitFlags.h"
+#include "../map/coordinate.h"
+#include "../map/infomark.h"
+#include "../map/mmapper2room.h"
+#include "../map/room.h"
+#include "../map/roomid.h"
+
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <initializer_list>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace { // anonymous
+
+// Thrown when the input uses something the fast path doesn't understand.
+// It never escapes tryLoad(); the caller falls back to QXmlStreamReader instead.
+struct NODISCARD UnsupportedXmlError final : public std::runtime_error
+{
+    UnsupportedXmlError()
+        : std::runtime_error("unsupported xml")
+    {}
+};
+
+NORETURN void unsupported()
+{
+    throw UnsupportedXmlError();
+}
+
+// ---------------------------- PerfectHashTable ---------------------------------
+// Perfect hash over a small fixed set of names: the seed (and table size) are chosen at
+// construction so that every name lands in its own slot, so a lookup is one hash and one compare.
+class NODISCARD PerfectHashTable final
+{
+public:
+    using Entry = std::pair<std::string_view, uint32_t>;
+
+private:
+    struct NODISCARD Slot final
+    {
+        std::string_view name;
+        uint32_t value = 0;
+    };
+
+    std::vector<Slot> m_slots;
+    uint32_t m_seed = 0;
+    uint32_t m_mask = 0;
+
+private:
+    NODISCARD static uint32_t hash(const std::string_view sv, const uint32_t seed) noexcept
+    {
+        // FNV-1a
+        uint32_t h = 2166136261u ^ seed;
+        for (const char c : sv) {
+            h ^= static_cast<uint8_t>(c);
+            h *= 16777619u;
+        }
+        return h ^ (h >> 15u);
+    }
+
+    NODISCARD bool tryBuild(const std::vector<Entry> &entries,
+                            const size_t size,
+                            const uint32_t seed)
+    {
+        std::vector<Slot> slots(size);
+        const auto mask = static_cast<uint32_t>(size - 1);
+        for (const auto &[name, value] : entries) {
+            Slot &slot = slots[hash(name, seed) & mask];
+            if (!slot.name.empty()) {
+                return false;
+            }
+            slot.name = name;
+            slot.value = value;
+        }
+        m_slots = std::move(slots);
+        m_seed = seed;
+        m_mask = mask;
+        return true;
+    }
+
+public:
+    explicit PerfectHashTable(const std::vector<Entry> &entries)
+    {
+        size_t size = 1;
+        while (size < 2 * entries.size()) {
+            size <<= 1u;
+        }
+        for (; size <= (1u << 16u); size <<= 1u) {
+            for (uint32_t seed = 0; seed < 1024; ++seed) {
+                if (tryBuild(entries, size, seed)) {
+                    return;
+                }
+            }
+        }
+        throw std::logic_error("unable to build perfect hash table");
+    }
+
+public:
+    NODISCARD std::optional<uint32_t> lookup(const std::string_view sv) const noexcept
+    {
+        const Slot &slot = m_slots[hash(sv, m_seed) & m_mask];
+        if (slot.name.empty() || slot.name != sv) {
+            return std::nullopt;
+        }
+        return slot.value;
+    }
+};
+
+// Must match XmlMapStorage's Converter: "UNDEFINED" is never saved,
+// and the EXIT flag is saved inverted as "NO_EXIT".
+NODISCARD PerfectHashTable makeEnumTable(const std::initializer_list<std::string_view> names)
+{
+    std::vector<PerfectHashTable::Entry> entries;
+    uint32_t val = 0;
+    for (const std::string_view name : names) {
+        if (name != "UNDEFINED") {
+            entries.emplace_back(name == "EXIT" ? std::string_view{"NO_EXIT"} : name, val);
+        }
+        ++val;
+    }
+    return PerfectHashTable{entries};
+}
+
+#define X_NAME(X) #X,
+#define X_NAME2(X, ...) #X,
+#define DEFINE_ENUM_TABLE(_Enum, _Names) \
+    NODISCARD const PerfectHashTable &getEnumTable(_Enum) \
+    { \
+        static const PerfectHashTable g_table = makeEnumTable({_Names}); \
+        return g_table; \
+    }
+DEFINE_ENUM_TABLE(RoomAlignEnum, XFOREACH_RoomAlignEnum(X_NAME))
+DEFINE_ENUM_TABLE(DoorFlagEnum, XFOREACH_DOOR_FLAG(X_NAME2))
+DEFINE_ENUM_TABLE(ExitFlagEnum, XFOREACH_EXIT_FLAG(X_NAME2))
+DEFINE_ENUM_TABLE(RoomLightEnum, XFOREACH_RoomLightEnum(X_NAME))
+DEFINE_ENUM_TABLE(RoomLoadFlagEnum, XFOREACH_ROOM_LOAD_FLAG(X_NAME))
+DEFINE_ENUM_TABLE(InfomarkClassEnum, XFOREACH_INFOMARK_CLASS(X_NAME))
+DEFINE_ENUM_TABLE(InfomarkTypeEnum, XFOREACH_INFOMARK_TYPE(X_NAME))
+DEFINE_ENUM_TABLE(RoomMobFlagEnum, XFOREACH_ROOM_MOB_FLAG(X_NAME))
+DEFINE_ENUM_TABLE(RoomPortableEnum, XFOREACH_RoomPortableEnum(X_NAME))
+DEFINE_ENUM_TABLE(RoomRidableEnum, XFOREACH_RoomRidableEnum(X_NAME))
+DEFINE_ENUM_TABLE(RoomSundeathEnum, XFOREACH_RoomSundeathEnum(X_NAME))
+DEFINE_ENUM_TABLE(RoomTerrainEnum, XFOREACH_RoomTerrainEnum(X_NAME))
+#undef DEFINE_ENUM_TABLE
+#undef X_NAME2
+#undef X_NAME
+
+template<typename ENUM>
+NODISCARD ENUM toEnum(const std::string_view sv)
+{
+    if (const auto opt = getEnumTable(ENUM{}).lookup(sv)) {
+        return static_cast<ENUM>(opt.value());
+    }
+    unsupported();
+}
+
+#define XFOREACH_ROOM_ELEMENT(X) \
+    X(area) \
+    X(align) \
+    X(contents) \
+    X(coord) \
+    X(description) \
+    X(exit) \
+    X(light) \
+    X(loadflag) \
+    X(mobflag) \
+    X(note) \
+    X(portable) \
+    X(ridable) \
+    X(sundeath) \
+    X(terrain)
+
+enum class NODISCARD RoomElementEnum : uint8_t {
+#define X_DECL(X) X,
+    XFOREACH_ROOM_ELEMENT(X_DECL)
+#undef X_DECL
+};
+
+NODISCARD RoomElementEnum toRoomElement(const std::string_view name)
+{
+    static const PerfectHashTable g_table = makeEnumTable({
+#define X_NAME(X) #X,
+        XFOREACH_ROOM_ELEMENT(X_NAME)
+#undef X_NAME
+    });
+    if (const auto opt = g_table.lookup(name)) {
+        return static_cast<RoomElementEnum>(opt.value());
+    }
+    unsupported();
+}
+
+NODISCARD ExitDirEnum directionForLowercase(const std::string_view lowcase)
+{
+    for (const ExitDirEnum dir : ALL_EXITS_NESWUD) {
+        if (lowcase == lowercaseDirection(dir)) {
+            return dir;
+        }
+    }
+    return ExitDirEnum::UNKNOWN;
+}
+
+// ---------------------------- Cursor ---------------------------------------------
+struct NODISCARD Attribute final
+{
+    std::string_view name;
+    std::string_view rawValue;
+};
+
+struct NODISCARD StartTag final
+{
+    static constexpr size_t MAX_ATTRIBUTES = 8;
+
+    std::string_view name;
+    std::array<Attribute, MAX_ATTRIBUTES> attrs{};
+    size_t numAttrs = 0;
+    bool selfClosing = false;
+
+    NODISCARD std::optional<std::string_view> findRaw(const std::string_view attrName) const
+    {
+        for (size_t i = 0; i < numAttrs; ++i) {
+            if (attrs[i].name == attrName) {
+                return attrs[i].rawValue;
+            }
+        }
+        return std::nullopt;
+    }
+};
+
+NODISCARD bool isNameStartChar(const char c)
+{
+    return ascii::isLower(c) || ascii::isUpper(c) || c == '_';
+}
+
+NODISCARD bool isNameChar(const char c)
+{
+    return isNameStartChar(c) || ascii::isDigit(c) || c == '-' || c == '.' || c == ':';
+}
+
+void appendCodepoint(std::string &out, const std::string_view digits, const int base)
+{
+    uint32_t codepoint = 0;
+    const auto [ptr, ec] = std::from_chars(digits.data(),
+                                           digits.data() + digits.size(),
+                                           codepoint,
+                                           base);
+    if (digits.empty() || ec != std::errc{} || ptr != digits.data() + digits.size()
+        || codepoint == 0) {
+        unsupported();
+    }
+    const auto encoded = charset::conversion::try_encode_utf8(static_cast<char32_t>(codepoint));
+    if (!encoded) {
+        unsupported();
+    }
+    out += encoded.value();
+}
+
+// Decodes the five predefined entities and numeric character references.
+// Raw carriage returns (and raw tabs/newlines in attributes) would be normalized by
+// a conforming parser, so those are left to the fallback.
+NODISCARD std::string decode(const std::string_view raw, const bool isAttribute)
+{
+    const auto isSpecial = [isAttribute](const char c) {
+        return c == '&' || c == '\r' || (isAttribute && (c == '\t' || c == '\n'));
+    };
+
+    std::string out;
+    out.reserve(raw.size());
+    size_t pos = 0;
+    while (pos < raw.size()) {
+        size_t next = pos;
+        while (next < raw.size() && !isSpecial(raw[next])) {
+            ++next;
+        }
+        out.append(raw.substr(pos, next - pos));
+        if (next == raw.size()) {
+            break;
+        }
+        if (raw[next] != '&') {
+            unsupported();
+        }
+        const size_t semi = raw.find(';', next);
+        if (semi == std::string_view::npos) {
+            unsupported();
+        }
+        const std::string_view entity = raw.substr(next + 1, semi - next - 1);
+        if (entity == "lt") {
+            out += '<';
+        } else if (entity == "gt") {
+            out += '>';
+        } else if (entity == "amp") {
+            out += '&';
+        } else if (entity == "quot") {
+            out += '"';
+        } else if (entity == "apos") {
+            out += '\'';
+        } else if (entity.size() > 2 && entity[0] == '#' && entity[1] == 'x') {
+            appendCodepoint(out, entity.substr(2), 16);
+        } else if (entity.size() > 1 && entity[0] == '#') {
+            appendCodepoint(out, entity.substr(1), 10);
+        } else {
+            unsupported();
+        }
+        pos = semi + 1;
+    }
+    return out;
+}
+
+// Only accepts the canonical representation, like XmlMapStorage::loadExternalRoomId().
+NODISCARD uint32_t toCanonicalUint32(const std::string_view sv)
+{
+    if (sv.empty() || (sv.size() > 1 && sv.front() == '0')) {
+        unsupported();
+    }
+    uint32_t result = 0;
+    const auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), result);
+    if (ec != std::errc{} || ptr != sv.data() + sv.size()) {
+        unsupported();
+    }
+    return result;
+}
+
+NODISCARD int toInt(const std::string_view sv)
+{
+    int result = 0;
+    const auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), result);
+    if (sv.empty() || ec != std::errc{} || ptr != sv.data() + sv.size()) {
+        unsupported();
+    }
+    return result;
+}
+
+class NODISCARD Cursor final
+{
+private:
+    std::string_view m_sv;
+    size_t m_pos = 0;
+
+public:
+    explicit Cursor(const std::string_view sv)
+        : m_sv{sv}
+    {}
+
+public:
+    NODISCARD bool atEnd() const { return m_pos == m_sv.size(); }
+    NODISCARD size_t pos() const { return m_pos; }
+    NODISCARD std::string_view rest() const { return m_sv.substr(m_pos); }
+    void seek(const size_t pos) { m_pos = pos; }
+
+    void skipSpace()
+    {
+        while (m_pos < m_sv.size()) {
+            const char c = m_sv[m_pos];
+            if (c == ' ' || c == '\t' || c == '\n') {
+                ++m_pos;
+            } else if (c == '\r') {
+                unsupported();
+            } else {
+                break;
+            }
+        }
+    }
+
+    NODISCARD bool tryConsume(const std::string_view lit)
+    {
+        if (rest().substr(0, lit.size()) != lit) {
+            return false;
+        }
+        m_pos += lit.size();
+        return true;
+    }
+
+    void expect(const std::string_view lit)
+    {
+        if (!tryConsume(lit)) {
+            unsupported();
+        }
+    }
+
+    NODISCARD std::string_view readName()
+    {
+        const size_t begin = m_pos;
+        while (m_pos < m_sv.size() && isNameChar(m_sv[m_pos])) {
+            ++m_pos;
+        }
+        if (m_pos == begin || !isNameStartChar(m_sv[begin])) {
+            unsupported();
+        }
+        return m_sv.substr(begin, m_pos - begin);
+    }
+
+    // Reads attributes up to (but not including) the closing "/>", ">" or "?>".
+    void readAttributes(StartTag &tag)
+    {
+        while (true) {
+            const size_t before = m_pos;
+            skipSpace();
+            if (atEnd()) {
+                unsupported();
+            }
+            const char c = m_sv[m_pos];
+            if (c == '/' || c == '>' || c == '?') {
+                return;
+            }
+            if (m_pos == before || tag.numAttrs == StartTag::MAX_ATTRIBUTES) {
+                unsupported();
+            }
+            Attribute &attr = tag.attrs[tag.numAttrs];
+            attr.name = readName();
+            if (tag.findRaw(attr.name)) {
+                unsupported(); // duplicate attribute
+            }
+            skipSpace();
+            expect("=");
+            skipSpace();
+            if (atEnd() || (m_sv[m_pos] != '"' && m_sv[m_pos] != '\'')) {
+                unsupported();
+            }
+            const char quote = m_sv[m_pos++];
+            const size_t end = m_sv.find(quote, m_pos);
+            if (end == std::string_view::npos) {
+                unsupported();
+            }
+            attr.rawValue = m_sv.substr(m_pos, end - m_pos);
+            if (attr.rawValue.find('<') != std::string_view::npos) {
+                unsupported();
+            }
+            m_pos = end + 1;
+            ++tag.numAttrs;
+        }
+    }
+
+    NODISCARD StartTag readStartTag()
+    {
+        StartTag tag;
+        expect("<");
+        tag.name = readName();
+        readAttributes(tag);
+        if (tryConsume("/>")) {
+            tag.selfClosing = true;
+        } else {
+            expect(">");
+        }
+        return tag;
+    }
+
+    void readEndTag(const std::string_view name)
+    {
+        expect("</");
+        expect(name);
+        skipSpace();
+        expect(">");
+    }
+
+    // Text-only element content: <name>text</name>.
+    // Empty elements are rejected, like XmlMapStorage::loadStringView().
+    NODISCARD std::string readText(const StartTag &tag)
+    {
+        if (tag.selfClosing || tag.numAttrs != 0) {
+            unsupported();
+        }
+        const size_t end = m_sv.find('<', m_pos);
+        if (end == std::string_view::npos || end == m_pos) {
+            unsupported();
+        }
+        const std::string_view raw = m_sv.substr(m_pos, end - m_pos);
+        m_pos = end;
+        readEndTag(tag.name);
+        return decode(raw, false);
+    }
+
+    // Elements that only carry attributes: <name .../> or <name ...></name>.
+    void finishEmpty(const StartTag &tag)
+    {
+        if (!tag.selfClosing) {
+            skipSpace();
+            readEndTag(tag.name);
+        }
+    }
+};
+
+NODISCARD std::string getAttr(const StartTag &tag, const std::string_view name)
+{
+    if (const auto raw = tag.findRaw(name)) {
+        return decode(raw.value(), true);
+    }
+    return std::string{};
+}
+
+NODISCARD Coordinate readCoordinate(Cursor &cursor, const StartTag &tag)
+{
+    const auto x = tag.findRaw("x");
+    const auto y = tag.findRaw("y");
+    const auto z = tag.findRaw("z");
+    if (!x || !y || !z) {
+        unsupported();
+    }
+    cursor.finishEmpty(tag);
+    return Coordinate{toInt(x.value()), toInt(y.value()), toInt(z.value())};
+}
+
+// Parses the next sibling start tag inside the current element,
+// or returns std::nullopt after consuming the current element's end tag.
+NODISCARD std::optional<StartTag> nextChild(Cursor &cursor, const std::string_view parentName)
+{
+    cursor.skipSpace();
+    if (cursor.rest().substr(0, 2) == "</") {
+        cursor.readEndTag(parentName);
+        return std::nullopt;
+    }
+    return cursor.readStartTag();
+}
+
+void readExit(Cursor &cursor, const StartTag &tag, ExternalRawRoom::Exits &exitList)
+{
+    const ExitDirEnum dir = directionForLowercase(getAttr(tag, "dir"));
+    DoorFlags doorFlags;
+    ExitFlags exitFlags;
+    ExternalRawExit &exit = exitList[dir];
+    exit.setDoorName(makeDoorName(getAttr(tag, "doorname")));
+
+    if (!tag.selfClosing) {
+        while (const auto child = nextChild(cursor, tag.name)) {
+            const std::string_view name = child->name;
+            if (name == "to") {
+                exit.outgoing.insert(ExternalRoomId{toCanonicalUint32(cursor.readText(*child))});
+            } else if (name == "doorflag") {
+                doorFlags |= toEnum<DoorFlagEnum>(cursor.readText(*child));
+            } else if (name == "exitflag") {
+                exitFlags |= toEnum<ExitFlagEnum>(cursor.readText(*child));
+            } else {
+                unsupported();
+            }
+        }
+    }
+    exit.setDoorFlags(doorFlags);
+    // EXIT flag is almost always set, thus we save it inverted.
+    exit.setExitFlags(exitFlags ^ ExitFlagEnum::EXIT);
+}
+
+NODISCARD ExternalRawRoom parseRoom(const std::string_view chunk)
+{
+    if (!isValidUtf8(chunk)) {
+        unsupported();
+    }
+
+    Cursor cursor{chunk};
+    const StartTag tag = cursor.readStartTag();
+    if (tag.name != "room" || tag.selfClosing) {
+        unsupported();
+    }
+
+    ExternalRawRoom room{};
+    room.status = RoomStatusEnum::Permanent;
+    room.setId(ExternalRoomId{toCanonicalUint32(getAttr(tag, "id"))});
+    {
+        const std::string serverIdStr = getAttr(tag, "server_id");
+        room.setServerId(serverIdStr.empty() ? INVALID_SERVER_ROOMID
+                                             : ServerRoomId{toCanonicalUint32(serverIdStr)});
+    }
+    room.setName(makeRoomName(getAttr(tag, "name")));
+
+    auto &exitList = room.exits;
+    RoomLoadFlags loadFlags;
+    RoomMobFlags mobFlags;
+    uint32_t found = 0;
+    const auto checkDuplicate = [&found](const RoomElementEnum elt) {
+        const uint32_t bit = 1u << static_cast<uint32_t>(elt);
+        if ((found & bit) != 0) {
+            unsupported();
+        }
+        found |= bit;
+    };
+
+    while (const auto child = nextChild(cursor, tag.name)) {
+        const RoomElementEnum elt = toRoomElement(child->name);
+        switch (elt) {
+        case RoomElementEnum::exit:
+            readExit(cursor, *child, exitList);
+            continue;
+        case RoomElementEnum::loadflag:
+            loadFlags |= toEnum<RoomLoadFlagEnum>(cursor.readText(*child));
+            continue;
+        case RoomElementEnum::mobflag:
+            mobFlags |= toEnum<RoomMobFlagEnum>(cursor.readText(*child));
+            continue;
+        default:
+            break;
+        }
+
+        checkDuplicate(elt);
+        switch (elt) {
+        case RoomElementEnum::area:
+            room.setArea(makeRoomArea(cursor.readText(*child)));
+            break;
+        case RoomElementEnum::align:
+            room.setAlignType(toEnum<RoomAlignEnum>(cursor.readText(*child)));
+            break;
+        case RoomElementEnum::contents:
+            room.setContents(makeRoomContents(cursor.readText(*child)));
+            break;
+        case RoomElementEnum::coord:
+            room.setPosition(readCoordinate(cursor, *child));
+            break;
+        case RoomElementEnum::description:
+            room.setDescription(makeRoomDesc(cursor.readText(*child)));
+            break;
+        case RoomElementEnum::light:
+            room.setLightType(toEnum<RoomLightEnum>(cursor.readText(*child)));
+            break;
+        case RoomElementEnum::note:
+            room.setNote(makeRoomNote(cursor.readText(*child)));
+            break;
+        case RoomElementEnum::portable:
+            room.setPortableType(toEnum<RoomPortableEnum>(cursor.readText(*child)));
+            break;
+        case RoomElementEnum::ridable:
+            room.setRidableType(toEnum<RoomRidableEnum>(cursor.readText(*child)));
+            break;
+        case RoomElementEnum::sundeath:
+            room.setSundeathType(toEnum<RoomSundeathEnum>(cursor.readText(*child)));
+            break;
+        case RoomElementEnum::terrain:
+            room.setTerrainType(toEnum<RoomTerrainEnum>(cursor.readText(*child)));
+            break;
+        case RoomElementEnum::exit:
+        case RoomElementEnum::loadflag:
+        case RoomElementEnum::mobflag:
+            break;
+        }
+    }
+
+    if (!cursor.atEnd()) {
+        unsupported();
+    }
+
+    room.setLoadFlags(loadFlags);
+    room.setMobFlags(mobFlags);
+    return room;
+}
+
+NODISCARD RawInfomark parseMarker(const std::string_view chunk)
+{
+    if (!isValidUtf8(chunk)) {
+        unsupported();
+    }
+
+    Cursor cursor{chunk};
+    const StartTag tag = cursor.readStartTag();
+    if (tag.name != "marker" || tag.selfClosing) {
+        unsupported();
+    }
+
+    const auto type = toEnum<InfomarkTypeEnum>(getAttr(tag, "type"));
+    const auto clas = toEnum<InfomarkClassEnum>(getAttr(tag, "class"));
+    int angle = 0;
+    if (const auto anglestr = tag.findRaw("angle")) {
+        angle = toInt(anglestr.value());
+    }
+
+    RawInfomark marker{};
+    size_t foundPos1 = 0;
+    size_t foundPos2 = 0;
+
+    marker.setType(type);
+    marker.setClass(clas);
+    marker.setRotationAngle(angle);
+
+    while (const auto child = nextChild(cursor, tag.name)) {
+        const std::string_view name = child->name;
+        if (name == "pos1") {
+            marker.setPosition1(readCoordinate(cursor, *child));
+            ++foundPos1;
+        } else if (name == "pos2") {
+            marker.setPosition2(readCoordinate(cursor, *child));
+            ++foundPos2;
+        } else if (name == "text") {
+            std::string text = cursor.readText(*child);
+            if (type == InfomarkTypeEnum::TEXT) {
+                marker.setText(makeInfomarkText(std::move(text)));
+            }
+        } else {
+            unsupported();
+        }
+    }
+
+    if (!cursor.atEnd() || foundPos1 != 1 || foundPos2 > 1) {
+        unsupported();
+    }
+    if (foundPos2 == 0) {
+        // saveMarker() omits pos2 when it's equal to pos1
+        marker.setPosition2(marker.getPosition1());
+    }
+    if (type == InfomarkTypeEnum::TEXT && marker.getText().isEmpty()) {
+        marker.setText(makeInfomarkText("New Marker"));
+    }
+    return marker;
+}
+
+// Returns the index one past the end tag of the element starting at begin.
+NODISCARD size_t findElementEnd(const std::string_view doc,
+                                const size_t begin,
+                                const std::string_view endTag)
+{
+    const size_t end = doc.find(endTag, begin);
+    if (end == std::string_view::npos) {
+        unsupported();
+    }
+    return end + endTag.size();
+}
+
+struct NODISCARD Chunks final
+{
+    std::vector<std::string_view> rooms;
+    std::vector<std::string_view> markers;
+    Coordinate position;
+};
+
+// Serial pass: validates the prolog and the <map> element, and splits its children into chunks.
+NODISCARD Chunks splitDocument(const std::string_view doc)
+{
+    Cursor cursor{doc};
+    std::ignore = cursor.tryConsume("\xEF\xBB\xBF"); // UTF-8 BOM
+
+    if (cursor.tryConsume("<?xml")) {
+        StartTag decl;
+        cursor.readAttributes(decl);
+        cursor.expect("?>");
+        if (const auto encoding = decl.findRaw("encoding")) {
+            const std::string_view enc = encoding.value();
+            if (enc != "UTF-8" && enc != "utf-8") {
+                unsupported();
+            }
+        }
+    }
+
+    cursor.skipSpace();
+    const StartTag map = cursor.readStartTag();
+    if (map.name != "map" || map.selfClosing || getAttr(map, "type") != "mmapper2xml") {
+        unsupported();
+    }
+    {
+        const std::string version = getAttr(map, "version");
+        if (version != "1" && version.rfind("1.", 0) != 0) {
+            unsupported();
+        }
+    }
+
+    Chunks chunks;
+    while (true) {
+        cursor.skipSpace();
+        if (cursor.tryConsume("</map")) {
+            cursor.skipSpace();
+            cursor.expect(">");
+            break;
+        }
+
+        const size_t begin = cursor.pos();
+        if (cursor.tryConsume("<room ")) {
+            const size_t end = findElementEnd(doc, begin, "</room>");
+            chunks.rooms.emplace_back(doc.substr(begin, end - begin));
+            cursor.seek(end);
+        } else if (cursor.tryConsume("<marker ")) {
+            const size_t end = findElementEnd(doc, begin, "</marker>");
+            chunks.markers.emplace_back(doc.substr(begin, end - begin));
+            cursor.seek(end);
+        } else {
+            const StartTag tag = cursor.readStartTag();
+            if (tag.name != "position") {
+                unsupported();
+            }
+            chunks.position = readCoordinate(cursor, tag);
+        }
+    }
+
+    cursor.skipSpace();
+    if (!cursor.atEnd()) {
+        unsupported();
+    }
+    return chunks;
+}
+
+NODISCARD bool hasDuplicateIds(const std::vector<ExternalRawRoom> &rooms)
+{
+    std::unordered_set<ExternalRoomId> externalIds;
+    std::unordered_set<ServerRoomId> serverIds;
+    externalIds.reserve(rooms.size());
+    serverIds.reserve(rooms.size());
+    for (const ExternalRawRoom &room : rooms) {
+        if (!externalIds.emplace(room.getId()).second) {
+            return true;
+        }
+        const ServerRoomId serverId = room.getServerId();
+        if (serverId != INVALID_SERVER_ROOMID && !serverIds.emplace(serverId).second) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+namespace xml_fast_loader {
+
+std::optional<RawMapLoadData> tryLoad(const std::string_view doc, ProgressCounter &counter)
+{
+    Chunks chunks;
+    try {
+        chunks = splitDocument(doc);
+    } catch (const std::exception &) {
+        return std::nullopt;
+    }
+
+    counter.reset();
+    counter.increaseTotalStepsBy(chunks.rooms.size() + chunks.markers.size());
+
+    RawMapLoadData result;
+    result.position = chunks.position;
+    result.rooms.reserve(chunks.rooms.size());
+
+    struct NODISCARD ThreadLocals final
+    {
+        std::vector<ExternalRawRoom> rooms;
+    };
+
+    // Workers never throw; the first one to fail tells the others to stop early.
+    std::atomic_bool failed{false};
+    thread_utils::parallel_for_each_tl<ThreadLocals>(
+        chunks.rooms,
+        counter,
+        [&failed](ThreadLocals &tl, const std::string_view chunk) {
+            if (failed) {
+                return;
+            }
+            try {
+                tl.rooms.emplace_back(parseRoom(chunk));
+            } catch (const std::exception &) {
+                failed = true;
+            }
+        },
+        // chunks are assigned to threads in order, so this preserves document order
+        [&result](auto &thread_locals) {
+            for (ThreadLocals &tl : thread_locals) {
+                for (ExternalRawRoom &room : tl.rooms) {
+                    result.rooms.emplace_back(std::move(room));
+                }
+            }
+        });
+
+    if (failed || hasDuplicateIds(result.rooms)) {
+        return std::nullopt;
+    }
+
+    try {
+        result.markers.reserve(chunks.markers.size());
+        for (const std::string_view chunk : chunks.markers) {
+            result.markers.emplace_back(parseMarker(chunk));
+            counter.step();
+        }
+    } catch (const std::exception &) {
+        // Anything the fast path can't handle is left to the generic reader,
+        // which reports a proper error if the data really is bad.
+        return std::nullopt;
+    }
+
+    return result;
+}
+
+} // namespace xml_fast_loader
@@ -0,0 +1,24 @@
+#pragma once
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "../global/macros.h"
+#include "RawMapData.h"
+
+#include <optional>
+#include <string_view>
+
+class ProgressCounter;
+
+/*! \brief Byte-level fast path for loading MM2 XML maps.
+ *
+ * The document is split at <room> boundaries, and the room chunks are parsed on
+ * worker threads. Only the subset of XML written by XmlMapStorage is understood;
+ * for anything else (comments, CDATA, other encodings, duplicate ids, malformed data)
+ * this returns std::nullopt and the caller should fall back to QXmlStreamReader,
+ * which also reports a proper error message.
+ */
+namespace xml_fast_loader {
+NODISCARD extern std::optional<RawMapLoadData> tryLoad(std::string_view doc,
+                                                       ProgressCounter &counter);
+} // namespace xml_fast_loader
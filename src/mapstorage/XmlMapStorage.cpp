@@ -20,6 +20,7 @@
 #include "../map/room.h"
 #include "../map/roomid.h"
 #include "../mapdata/mapdata.h"
+#include "XmlMapFastLoader.h"
 #include "abstractmapstorage.h"
 
 #include <cassert>
@@ -30,6 +31,7 @@
 #include <type_traits>
 #include <vector>
 
+#include <QByteArray>
 #include <QHash>
 #include <QMessageBox>
 #include <QString>
@@ -280,15 +282,22 @@ std::optional<RawMapLoadData> XmlMapStorage::virt_loadData()
     try {
         log("Loading data ...");
         QIODevice &device = getDevice();
-        QXmlStreamReader stream(&device);
+        const QByteArray data = device.readAll();
+        getProgressCounter().addByteCount("bytes read", static_cast<size_t>(data.size()));
 
         m_loading = std::make_unique<Loading>();
+        if (auto fast = xml_fast_loader::tryLoad(mmqt::toStdStringViewRaw(data),
+                                                 getProgressCounter())) {
+            m_loading->result = std::move(fast.value());
+        } else {
+            log("Using the generic XML reader ...");
+            QXmlStreamReader stream(data);
+            m_loading->loadProgressDivisor = static_cast<uint64_t>(
+                std::max<int64_t>(1, data.size() / LOAD_PROGRESS_MAX));
+            loadWorld(stream);
+        }
         m_loading->result.filename = getFilename();
         m_loading->result.readonly = !device.isWritable();
-        m_loading->loadProgressDivisor = static_cast<uint64_t>(
-            std::max<int64_t>(1, device.size() / LOAD_PROGRESS_MAX));
-
-        loadWorld(stream);
         log("Finished loading.");
         return std::exchange(m_loading->result, {});
 
@@ -9,10 +9,12 @@
 #include "../global/Charset.h"
 #include "../global/parserutils.h"
 #include "../global/progresscounter.h"
+#include "../global/thread_utils.h"
 #include "../global/utils.h"
 #include "../map/DoorFlags.h"
 #include "../map/ExitDirection.h"
 #include "../map/ExitFlags.h"
+#include "../map/Map.h"
 #include "../map/coordinate.h"
 #include "../map/exit.h"
 #include "../map/mmapper2room.h"
@@ -23,8 +25,17 @@
 
 #include <cassert>
 #include <cstddef>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <QString>
 
@@ -74,6 +85,14 @@ class NODISCARD WebHasher final
     void reset() { m_hash.reset(); }
 };
 
+NODISCARD static QByteArray getWebHash(WebHasher &hasher, const RoomHandle &room)
+{
+    hasher.add(room.getName(), room.getDescription());
+    QByteArray result = hasher.result().toHex();
+    hasher.reset();
+    return result;
+}
+
 // Lets the webclient locate and load the useful zones only, not the whole
 // world at once.
 class NODISCARD RoomHashIndex final
@@ -83,14 +102,11 @@ class NODISCARD RoomHashIndex final
 
 private:
     Index m_index;
-    WebHasher m_hasher;
 
 public:
-    void addRoom(const RoomHandle &room)
+    void addRoom(const QByteArray &webHash, const Coordinate &position)
     {
-        m_hasher.add(room.getName(), room.getDescription());
-        m_index.insert(m_hasher.result().toHex(), room.getPosition());
-        m_hasher.reset();
+        m_index.insert(webHash, position);
     }
 
     NODISCARD const Index &index() const { return m_index; }
@@ -139,78 +155,274 @@ class NODISCARD ZoneIndex final
     NODISCARD const Index &index() const { return m_index; }
 };
 
-template<typename JsonT>
-static void writeJson(const QString &filePath, JsonT &json, const QString &what)
+// Minimal streaming JSON writer.
+//
+// Output is indented the same way as QJsonDocument::toJson(), and object keys are written
+// in the order given by the caller, so callers should list them alphabetically to match
+// what QJsonObject would produce.
+class NODISCARD JsonWriter final
+{
+private:
+    std::string m_buf;
+    // one entry per open object/array: true until the first element is written
+    std::vector<bool> m_first;
+    bool m_afterKey = false;
+
+private:
+    void indent(const size_t depth) { m_buf.append(4 * depth, ' '); }
+
+    void separate()
+    {
+        if (m_afterKey) {
+            m_afterKey = false;
+            return;
+        }
+        if (!m_first.empty()) {
+            if (!m_first.back()) {
+                m_buf += ',';
+                m_buf += '\n';
+            }
+            m_first.back() = false;
+            indent(m_first.size());
+        }
+    }
+
+    void begin(const char open)
+    {
+        separate();
+        m_buf += open;
+        m_buf += '\n';
+        m_first.push_back(true);
+    }
+
+    void end(const char close)
+    {
+        assert(!m_first.empty() && !m_afterKey);
+        const bool empty = m_first.back();
+        m_first.pop_back();
+        if (!empty) {
+            m_buf += '\n';
+        }
+        indent(m_first.size());
+        m_buf += close;
+        if (m_first.empty()) {
+            m_buf += '\n';
+        }
+    }
+
+    void writeString(const std::string_view sv)
+    {
+        static constexpr const char *const hex = "0123456789abcdef";
+        m_buf += '"';
+        for (const char c : sv) {
+            switch (c) {
+            case '"':
+                m_buf += "\\\"";
+                break;
+            case '\\':
+                m_buf += "\\\\";
+                break;
+            case '\b':
+                m_buf += "\\b";
+                break;
+            case '\f':
+                m_buf += "\\f";
+                break;
+            case '\n':
+                m_buf += "\\n";
+                break;
+            case '\r':
+                m_buf += "\\r";
+                break;
+            case '\t':
+                m_buf += "\\t";
+                break;
+            default:
+                if (static_cast<uint8_t>(c) < 0x20) {
+                    m_buf += "\\u00";
+                    m_buf += hex[static_cast<uint8_t>(c) >> 4u];
+                    m_buf += hex[static_cast<uint8_t>(c) & 0xFu];
+                } else {
+                    m_buf += c; // UTF-8 is passed through unchanged
+                }
+                break;
+            }
+        }
+        m_buf += '"';
+    }
+
+public:
+    void beginObject() { begin('{'); }
+    void endObject() { end('}'); }
+    void beginArray() { begin('['); }
+    void endArray() { end(']'); }
+    void key(const std::string_view name)
+    {
+        separate();
+        writeString(name);
+        m_buf += ": ";
+        m_afterKey = true;
+    }
+    void value(const std::string_view sv)
+    {
+        separate();
+        writeString(sv);
+    }
+    void value(const int64_t n)
+    {
+        separate();
+        m_buf += std::to_string(n);
+    }
+
+    template<typename T>
+    void field(const std::string_view name, const T &val)
+    {
+        key(name);
+        if constexpr (std::is_integral_v<T>) {
+            value(static_cast<int64_t>(val));
+        } else {
+            value(std::string_view{val});
+        }
+    }
+
+    NODISCARD std::string steal()
+    {
+        assert(m_first.empty());
+        return std::exchange(m_buf, {});
+    }
+};
+
+NODISCARD static QByteArray hashBytes(const QByteArrayView data)
+{
+    return QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex();
+}
+
+NODISCARD static QByteArray hashBytes(const std::string &data)
+{
+    return hashBytes(QByteArrayView{data.data(), static_cast<qsizetype>(data.size())});
+}
+
+static void writeFile(const QString &filePath, const std::string &data, const QString &what)
 {
-    static_assert(std::is_same_v<JsonT, QJsonObject> || std::is_same_v<JsonT, QJsonArray>);
     QFile file(filePath);
-    if (!file.open(QIODevice::WriteOnly)) {
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
         QString msg(
             QString("error opening %1 to %2: %3").arg(what).arg(filePath).arg(file.errorString()));
         throw std::runtime_error(mmqt::toStdStringUtf8(msg));
     }
 
-    QJsonDocument doc(json);
-    QTextStream stream(&file);
-    stream << doc.toJson();
-    stream.flush();
-    if (!file.flush() || stream.status() != QTextStream::Ok) {
+    const auto size = static_cast<qint64>(data.size());
+    if (file.write(data.data(), size) != size || !file.flush()) {
         QString msg(
             QString("error writing %1 to %2: %3").arg(what).arg(filePath).arg(file.errorString()));
         throw std::runtime_error(mmqt::toStdStringUtf8(msg));
     }
 }
 
-class NODISCARD RoomIndexStore final
+// Remembers the content hash of every file written by the previous export,
+// so files whose content didn't change are not rewritten.
+//
+// The manifest is only saved after every other file has been written successfully,
+// so an interrupted export simply rewrites the affected files next time.
+class NODISCARD ExportManifest final
 {
-    const QDir m_dir;
-    QJsonObject m_hashes;
-    QByteArray m_prefix;
+private:
+    static constexpr const auto FILENAME = "manifest.json";
 
-public:
-    RoomIndexStore() = delete;
+    const QDir m_dir;
+    QByteArray m_previousHash;
+    std::unordered_map<std::string, QByteArray> m_previous;
+    std::mutex m_mutex;
+    std::map<std::string, QByteArray> m_current;
+    size_t m_written = 0;
 
 public:
-    explicit RoomIndexStore(const QDir &dir)
+    ExportManifest() = delete;
+    explicit ExportManifest(const QDir &dir)
         : m_dir(dir)
-    {}
+    {
+        QFile file(m_dir.filePath(FILENAME));
+        if (!file.open(QIODevice::ReadOnly)) {
+            return;
+        }
+        const QByteArray bytes = file.readAll();
+        m_previousHash = hashBytes(bytes);
+        const QJsonObject files = QJsonDocument::fromJson(bytes)
+                                      .object()
+                                      .value("files")
+                                      .toObject();
+        for (auto it = files.constBegin(); it != files.constEnd(); ++it) {
+            m_previous.emplace(mmqt::toStdStringUtf8(it.key()), it.value().toString().toUtf8());
+        }
+    }
 
-    void add(const QByteArray &hash, Coordinate coords)
+public:
+    // Thread-safe.
+    void writeIfChanged(const std::string &relPath, const std::string &data, const QString &what)
     {
-        QByteArray prefix = hash.left(c_roomIndexFileNameSize);
-        if (m_prefix != prefix) {
-            close();
-            m_prefix = prefix;
-        }
-
-        QJsonArray jCoords;
-        jCoords.push_back(coords.x);
-        jCoords.push_back(coords.y * -1);
-        jCoords.push_back(coords.z);
-
-        QJsonObject::iterator collision = m_hashes.find(hash);
-        if (collision == m_hashes.end()) {
-            QJsonArray array;
-            array.push_back(jCoords);
-            m_hashes.insert(hash, array);
-        } else {
-            collision->toArray().push_back(jCoords);
+        const QByteArray hash = hashBytes(data);
+        const QString filePath = m_dir.filePath(mmqt::toQStringUtf8(relPath));
+        const auto it = m_previous.find(relPath);
+        const bool unchanged = it != m_previous.end() && it->second == hash
+                               && QFileInfo::exists(filePath);
+        if (!unchanged) {
+            writeFile(filePath, data, what);
+        }
+
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_current.emplace(relPath, hash);
+        if (!unchanged) {
+            ++m_written;
         }
     }
 
-    void close()
+    // Thread-safe. Keeps the previous export's copy of a file that the caller knows is
+    // unchanged; returns false if there is no such copy, so the caller must write it.
+    NODISCARD bool tryKeep(const std::string &relPath)
     {
-        if (m_hashes.isEmpty()) {
-            return;
+        const auto it = m_previous.find(relPath);
+        if (it == m_previous.end()
+            || !QFileInfo::exists(m_dir.filePath(mmqt::toQStringUtf8(relPath)))) {
+            return false;
         }
 
-        assert(!m_prefix.isEmpty());
-        QString filePath = m_dir.filePath(QString::fromLocal8Bit(m_prefix) + ".json");
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_current.emplace(relPath, it->second);
+        return true;
+    }
 
-        writeJson(filePath, m_hashes, "room index");
+    // Empty if there was no manifest.
+    NODISCARD const QByteArray &getPreviousHash() const { return m_previousHash; }
+    NODISCARD size_t getWrittenCount() const { return m_written; }
+    NODISCARD size_t getFileCount() const { return m_current.size(); }
+
+    // Removes files from the previous export that are no longer produced (e.g. empty zones).
+    void removeStale()
+    {
+        for (const auto &kv : m_previous) {
+            if (m_current.find(kv.first) == m_current.end()) {
+                QFile::remove(m_dir.filePath(mmqt::toQStringUtf8(kv.first)));
+            }
+        }
+    }
 
-        m_hashes = QJsonObject();
-        m_prefix = QByteArray();
+    // Returns the hash of the saved manifest.
+    NODISCARD QByteArray save()
+    {
+        JsonWriter w;
+        w.beginObject();
+        w.key("files");
+        w.beginObject();
+        for (const auto &[relPath, hash] : m_current) {
+            w.key(relPath);
+            w.value(std::string_view{hash.constData(), static_cast<size_t>(hash.size())});
+        }
+        w.endObject();
+        w.field("version", 1);
+        w.endObject();
+        const std::string data = w.steal();
+        writeFile(m_dir.filePath(FILENAME), data, "manifest");
+        return hashBytes(data);
     }
 };
 
@@ -225,7 +437,12 @@ class NODISCARD JsonRoomIdsCache final
 
 public:
     JsonRoomIdsCache();
-    void addRoom(const ExternalRoomId mm2RoomId) { m_cache[mm2RoomId] = m_nextJsonId++; }
+    JsonRoomId addRoom(const ExternalRoomId mm2RoomId)
+    {
+        const JsonRoomId jsonId = m_nextJsonId++;
+        m_cache[mm2RoomId] = jsonId;
+        return jsonId;
+    }
     NODISCARD JsonRoomId operator[](ExternalRoomId roomId) const;
     NODISCARD uint32_t size() const;
 };
@@ -244,39 +461,228 @@ uint32_t JsonRoomIdsCache::size() const
     return m_nextJsonId;
 }
 
+using JsonRoomIds = std::unordered_map<RoomId, JsonRoomId>;
+using WebHashes = std::unordered_map<RoomId, QByteArray>;
+
+// What the last successful export wrote, so the next export to the same directory
+// can tell which zones and room index files have to be serialized again.
+struct NODISCARD PreviousExport final
+{
+    QString dirPath;
+    // Hash of the manifest it saved; if the manifest on disk differs, nothing is reused.
+    QByteArray manifestHash;
+    Map map;
+    JsonRoomIds jsonIds;
+    WebHashes webHashes;
+};
+
+// Only the most recent export is remembered. It's taken out while an export runs,
+// so an export that fails leaves nothing behind and the next one starts from scratch.
+class NODISCARD PreviousExportCache final
+{
+private:
+    std::mutex m_mutex;
+    std::optional<PreviousExport> m_previous;
+
+public:
+    NODISCARD std::optional<PreviousExport> take(const QString &dirPath)
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        auto result = std::exchange(m_previous, std::nullopt);
+        if (result.has_value() && result->dirPath != dirPath) {
+            result.reset();
+        }
+        return result;
+    }
+
+    void put(PreviousExport prev)
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_previous = std::move(prev);
+    }
+};
+
+NODISCARD static PreviousExportCache &getPreviousExportCache()
+{
+    static PreviousExportCache cache;
+    return cache;
+}
+
+// Zones and room index files that have to be serialized again.
+class NODISCARD DirtyFiles final
+{
+private:
+    bool m_everything = true;
+    std::unordered_set<std::string> m_zones;
+    std::unordered_set<std::string> m_roomIndexPrefixes;
+
+public:
+    void markEverything() { m_everything = true; }
+    void markNothing()
+    {
+        m_everything = false;
+        m_zones.clear();
+        m_roomIndexPrefixes.clear();
+    }
+    void markZone(const Coordinate &position) { m_zones.emplace(getZoneKey(position)); }
+    void markRoomIndex(const QByteArray &webHash)
+    {
+        m_roomIndexPrefixes.emplace(webHash.left(c_roomIndexFileNameSize).toStdString());
+    }
+
+public:
+    NODISCARD bool isZoneDirty(const std::string &zoneKey) const
+    {
+        return m_everything || m_zones.find(zoneKey) != m_zones.end();
+    }
+    NODISCARD bool isRoomIndexDirty(const std::string &prefix) const
+    {
+        return m_everything || m_roomIndexPrefixes.find(prefix) != m_roomIndexPrefixes.end();
+    }
+};
+
 // Expects that a RoomSaver locks the Rooms for the lifetime of this object!
 class NODISCARD JsonWorld final
 {
     JsonRoomIdsCache m_jRoomIds;
+    JsonRoomIds m_jsonIds;
+    WebHashes m_webHashes;
     RoomHashIndex m_roomHashIndex;
     ZoneIndex m_zoneIndex;
+    DirtyFiles m_dirty;
 
-    void addRoom(QJsonArray &jRooms, const ExternalRawRoom &room) const;
-    void addExits(const ExternalRawRoom &room, QJsonObject &jr) const;
+    void markChanges(const ConstRoomList &roomList, const PreviousExport &prev);
+    void writeRoom(JsonWriter &w, const ExternalRawRoom &room) const;
+    void writeExits(JsonWriter &w, const ExternalRawRoom &room) const;
 
 public:
     JsonWorld();
     ~JsonWorld();
-    void addRooms(const ConstRoomList &roomList, ProgressCounter &progressCounter);
-    void writeMetadata(const QFileInfo &path, const Bounds &bounds) const;
-    void writeRoomIndex(const QDir &dir) const;
-    void writeZones(const QDir &dir, ProgressCounter &progressCounter) const;
+    void addRooms(const ConstRoomList &roomList,
+                  const PreviousExport *prev,
+                  ProgressCounter &progressCounter);
+    void markEverythingDirty() { m_dirty.markEverything(); }
+    void writeMetadata(ExportManifest &manifest, const Bounds &bounds) const;
+    void writeRoomIndex(ExportManifest &manifest) const;
+    void writeZones(ExportManifest &manifest, ProgressCounter &progressCounter) const;
+    NODISCARD PreviousExport release(const QString &dirPath,
+                                     const QByteArray &manifestHash,
+                                     const Map &map);
 };
 
 JsonWorld::JsonWorld() = default;
 
 JsonWorld::~JsonWorld() = default;
 
-void JsonWorld::addRooms(const ConstRoomList &roomList, ProgressCounter &progressCounter)
+// Web hashes are only recomputed for rooms that changed since the previous export.
+void JsonWorld::addRooms(const ConstRoomList &roomList,
+                         const PreviousExport *const prev,
+                         ProgressCounter &progressCounter)
 {
+    m_jsonIds.reserve(roomList.size());
+    for (const auto &room : roomList) {
+        m_jsonIds.emplace(room.getId(), m_jRoomIds.addRoom(room.getIdExternal()));
+    }
+
+    WebHasher hasher;
+    m_webHashes.reserve(roomList.size());
     for (const auto &room : roomList) {
         progressCounter.step();
-        m_jRoomIds.addRoom(room.getIdExternal());
-        m_roomHashIndex.addRoom(room);
+        QByteArray webHash;
+        if (prev != nullptr) {
+            const RoomHandle old = prev->map.findRoomHandle(room.getId());
+            const auto it = prev->webHashes.find(room.getId());
+            if (old && it != prev->webHashes.end() && old.getRaw() == room.getRaw()) {
+                webHash = it->second;
+            }
+        }
+        if (webHash.isEmpty()) {
+            webHash = getWebHash(hasher, room);
+        }
+        m_roomHashIndex.addRoom(webHash, room.getPosition());
         m_zoneIndex.addRoom(room);
+        m_webHashes.emplace(room.getId(), std::move(webHash));
+    }
+
+    if (prev != nullptr) {
+        markChanges(roomList, *prev);
+    }
+}
+
+// Like MapCanvas, this diffs the persistent map snapshots rather than listening to
+// the map's change notifications, because those don't say which rooms changed.
+void JsonWorld::markChanges(const ConstRoomList &roomList, const PreviousExport &prev)
+{
+    m_dirty.markNothing();
+
+    const auto jsonIdChanged = [this, &prev](const RoomId id) -> bool {
+        const auto it = m_jsonIds.find(id);
+        const auto oldIt = prev.jsonIds.find(id);
+        if (it == m_jsonIds.end() || oldIt == prev.jsonIds.end()) {
+            return (it == m_jsonIds.end()) != (oldIt == prev.jsonIds.end());
+        }
+        return it->second != oldIt->second;
+    };
+    const auto anyJsonIdChanged = [&jsonIdChanged](const auto &set) -> bool {
+        for (const RoomId id : set) {
+            if (jsonIdChanged(id)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    for (const auto &room : roomList) {
+        const RoomId id = room.getId();
+        const RoomHandle old = prev.map.findRoomHandle(id);
+        const bool existed = old && prev.jsonIds.find(id) != prev.jsonIds.end();
+
+        // Exits are written with JSON IDs, so renumbering a neighbour changes this room too.
+        bool changed = !existed || old.getRaw() != room.getRaw() || jsonIdChanged(id);
+        if (!changed) {
+            for (const RawExit &e : room.getExits()) {
+                if (anyJsonIdChanged(e.getIncomingSet()) || anyJsonIdChanged(e.getOutgoingSet())) {
+                    changed = true;
+                    break;
+                }
+            }
+        }
+        if (!changed) {
+            continue;
+        }
+
+        m_dirty.markZone(room.getPosition());
+        m_dirty.markRoomIndex(m_webHashes.at(id));
+        if (existed) {
+            m_dirty.markZone(old.getPosition());
+            m_dirty.markRoomIndex(prev.webHashes.at(id));
+        }
+    }
+
+    // Rooms that were removed, or became temporary, since the previous export.
+    for (const auto &kv : prev.jsonIds) {
+        const RoomId id = kv.first;
+        if (m_jsonIds.find(id) != m_jsonIds.end()) {
+            continue;
+        }
+        if (const RoomHandle old = prev.map.findRoomHandle(id)) {
+            m_dirty.markZone(old.getPosition());
+        }
+        m_dirty.markRoomIndex(prev.webHashes.at(id));
     }
 }
 
+PreviousExport JsonWorld::release(const QString &dirPath,
+                                  const QByteArray &manifestHash,
+                                  const Map &map)
+{
+    return PreviousExport{dirPath,
+                          manifestHash,
+                          map,
+                          std::exchange(m_jsonIds, {}),
+                          std::exchange(m_webHashes, {})};
+}
+
 NODISCARD static constexpr const char *getNameUpper(const ExitDirEnum dir)
 {
 #define CASE(x) \
@@ -300,50 +706,71 @@ NODISCARD static constexpr const char *getNameUpper(const ExitDirEnum dir)
 #undef CASE
 }
 
-void JsonWorld::writeMetadata(const QFileInfo &path, const Bounds &bounds) const
+void JsonWorld::writeMetadata(ExportManifest &manifest, const Bounds &bounds) const
 {
     // This can give bogus data if the bounds aren't set.
     const Coordinate min = bounds.min;
     const Coordinate max = bounds.max;
 
-    QJsonObject meta;
-    meta["roomsCount"] = static_cast<qint64>(m_jRoomIds.size());
-    meta["minX"] = min.x;
-    meta["minY"] = std::min(-min.y, -max.y);
-    meta["minZ"] = min.z;
-    meta["maxX"] = max.x;
-    meta["maxY"] = std::max(-min.y, -max.y);
-    meta["maxZ"] = max.z;
-
-    // note: assignment implicitly converts the returned QJsonArray to QJsonValue
-    meta["directions"] = std::invoke([]() -> QJsonArray {
-        QJsonArray arr;
-        // why is there no QJsonArray::resize()?
-        for (size_t i = 0; i <= NUM_EXITS; ++i) {
-            arr.push_back(QString{});
-        }
-        for (size_t i = 0; i <= NUM_EXITS; ++i) {
-            arr[static_cast<int>(i)] = getNameUpper(static_cast<ExitDirEnum>(i));
-        }
-        return arr;
-    });
-
-    writeJson(path.filePath(), meta, "metadata");
+    JsonWriter w;
+    w.beginObject();
+    w.key("directions");
+    w.beginArray();
+    for (size_t i = 0; i <= NUM_EXITS; ++i) {
+        w.value(getNameUpper(static_cast<ExitDirEnum>(i)));
+    }
+    w.endArray();
+    w.field("maxX", max.x);
+    w.field("maxY", std::max(-min.y, -max.y));
+    w.field("maxZ", max.z);
+    w.field("minX", min.x);
+    w.field("minY", std::min(-min.y, -max.y));
+    w.field("minZ", min.z);
+    w.field("roomsCount", m_jRoomIds.size());
+    w.endObject();
+
+    manifest.writeIfChanged("arda.json", w.steal(), "metadata");
 }
 
-void JsonWorld::writeRoomIndex(const QDir &dir) const
+// Rooms are grouped into files by the first bytes of their hash.
+void JsonWorld::writeRoomIndex(ExportManifest &manifest) const
 {
-    using IterT = RoomHashIndex::Index::const_iterator;
     const RoomHashIndex::Index &index = m_roomHashIndex.index();
 
-    RoomIndexStore store(dir);
-    for (IterT iter = index.cbegin(); iter != index.cend(); ++iter) {
-        store.add(iter.key(), iter.value());
+    auto it = index.cbegin();
+    while (it != index.cend()) {
+        const QByteArray prefix = it.key().left(c_roomIndexFileNameSize);
+        const std::string relPath = "roomindex/" + prefix.toStdString() + ".json";
+        if (!m_dirty.isRoomIndexDirty(prefix.toStdString()) && manifest.tryKeep(relPath)) {
+            while (it != index.cend() && it.key().startsWith(prefix)) {
+                ++it;
+            }
+            continue;
+        }
+
+        JsonWriter w;
+        w.beginObject();
+        while (it != index.cend() && it.key().startsWith(prefix)) {
+            const QByteArray &hash = it.key();
+            w.key(std::string_view{hash.constData(), static_cast<size_t>(hash.size())});
+            w.beginArray();
+            for (; it != index.cend() && it.key() == hash; ++it) {
+                const Coordinate &coords = it.value();
+                w.beginArray();
+                w.value(coords.x);
+                w.value(coords.y * -1);
+                w.value(coords.z);
+                w.endArray();
+            }
+            w.endArray();
+        }
+        w.endObject();
+
+        manifest.writeIfChanged(relPath, w.steal(), "room index");
     }
-    store.close();
 }
 
-void JsonWorld::addRoom(QJsonArray &jRooms, const ExternalRawRoom &room) const
+void JsonWorld::writeRoom(JsonWriter &w, const ExternalRawRoom &room) const
 {
     /*
           x: 5, y: 5, z: 0,
@@ -355,71 +782,88 @@ void JsonWorld::addRoom(QJsonArray &jRooms, const ExternalRawRoom &room) const
     */
 
     const Coordinate pos = room.getPosition();
-    QJsonObject jr;
-    jr["x"] = pos.x;
-    jr["y"] = -pos.y;
-    jr["z"] = pos.z;
-
     const uint32_t jsonId = m_jRoomIds[room.getId()];
-    jr["id"] = QString::number(jsonId);
-    jr["name"] = room.getName().toQString();
-    jr["desc"] = room.getDescription().toQString();
-    jr["sector"] = static_cast<uint8_t>(room.getTerrainType());
-    jr["light"] = static_cast<uint8_t>(room.getLightType());
-    jr["portable"] = static_cast<uint8_t>(room.getPortableType());
-    jr["rideable"] = static_cast<uint8_t>(room.getRidableType());
-    jr["sundeath"] = static_cast<uint8_t>(room.getSundeathType());
-    jr["mobflags"] = static_cast<qint64>(room.getMobFlags().asUint32());
-    jr["loadflags"] = static_cast<qint64>(room.getLoadFlags().asUint32());
-
-    addExits(room, jr);
-
-    jRooms.push_back(jr);
+
+    w.beginObject();
+    w.field("desc", room.getDescription().getStdStringViewUtf8());
+    writeExits(w, room);
+    w.field("id", std::to_string(jsonId));
+    w.field("light", static_cast<uint8_t>(room.getLightType()));
+    w.field("loadflags", room.getLoadFlags().asUint32());
+    w.field("mobflags", room.getMobFlags().asUint32());
+    w.field("name", room.getName().getStdStringViewUtf8());
+    w.field("portable", static_cast<uint8_t>(room.getPortableType()));
+    w.field("rideable", static_cast<uint8_t>(room.getRidableType()));
+    w.field("sector", static_cast<uint8_t>(room.getTerrainType()));
+    w.field("sundeath", static_cast<uint8_t>(room.getSundeathType()));
+    w.field("x", pos.x);
+    w.field("y", -pos.y);
+    w.field("z", pos.z);
+    w.endObject();
 }
 
-void JsonWorld::addExits(const ExternalRawRoom &room, QJsonObject &jr) const
+void JsonWorld::writeExits(JsonWriter &w, const ExternalRawRoom &room) const
 {
-    QJsonArray jExits; // Direction-indexed
-    for (const ExternalRawExit &e : room.exits) {
-        QJsonObject je;
-        // ISSUE: We haven't been updating the schema for these.
-        je["flags"] = static_cast<qint64>(e.getExitFlags().asUint32());
-        je["dflags"] = static_cast<qint64>(e.getDoorFlags().asUint32());
-        je["name"] = e.getDoorName().toQString();
-
-        QJsonArray jin;
-        for (const ExternalRoomId idx : e.getIncomingSet()) {
-            jin << QString::number(m_jRoomIds[idx]);
-        }
-        je["in"] = jin;
-
-        QJsonArray jout;
-        for (const ExternalRoomId idx : e.getOutgoingSet()) {
-            jout << QString::number(m_jRoomIds[idx]);
+    const auto writeIds = [this, &w](const auto &set) {
+        w.beginArray();
+        for (const ExternalRoomId idx : set) {
+            w.value(std::to_string(m_jRoomIds[idx]));
         }
-        je["out"] = jout;
+        w.endArray();
+    };
 
-        jExits << je;
+    w.key("exits");
+    w.beginArray(); // Direction-indexed
+    for (const ExternalRawExit &e : room.exits) {
+        w.beginObject();
+        // ISSUE: We haven't been updating the schema for these.
+        w.field("dflags", e.getDoorFlags().asUint32());
+        w.field("flags", e.getExitFlags().asUint32());
+        w.key("in");
+        writeIds(e.getIncomingSet());
+        w.field("name", e.getDoorName().getStdStringViewUtf8());
+        w.key("out");
+        writeIds(e.getOutgoingSet());
+        w.endObject();
     }
-
-    jr["exits"] = jExits;
+    w.endArray();
 }
 
-void JsonWorld::writeZones(const QDir &dir, ProgressCounter &progressCounter) const
+// Zones without changed rooms are kept as they are. The others are serialized and hashed
+// in parallel, and only written to disk if their content actually changed.
+void JsonWorld::writeZones(ExportManifest &manifest, ProgressCounter &progressCounter) const
 {
-    const ZoneIndex::Index &index = m_zoneIndex.index();
-
-    for (const auto &kv : index) {
-        const ConstRoomList &rooms = kv.second;
-        QJsonArray jRooms;
-        for (const auto &room : rooms) {
-            addRoom(jRooms, room.getRawCopyExternal());
-            progressCounter.step();
+    std::vector<const ZoneIndex::Index::value_type *> zones;
+    zones.reserve(m_zoneIndex.index().size());
+    for (const auto &kv : m_zoneIndex.index()) {
+        const auto &[zoneKey, rooms] = kv;
+        if (!m_dirty.isZoneDirty(zoneKey) && manifest.tryKeep("zone/" + zoneKey + ".json")) {
+            progressCounter.step(rooms.size());
+            continue;
         }
-
-        QString filePath = dir.filePath(mmqt::toQStringUtf8(kv.first + ".json"));
-        writeJson(filePath, jRooms, "zone");
+        zones.emplace_back(&kv);
     }
+
+    struct NODISCARD DummyThreadLocals final
+    {};
+    thread_utils::parallel_for_each_tl_range<DummyThreadLocals>(
+        zones,
+        progressCounter,
+        [this, &manifest, &progressCounter](DummyThreadLocals &, auto it, const auto end) {
+            for (; it != end; ++it) {
+                const auto &[zoneKey, rooms] = **it;
+                JsonWriter w;
+                w.beginArray();
+                for (const auto &room : rooms) {
+                    writeRoom(w, room.getRawCopyExternal());
+                }
+                w.endArray();
+                progressCounter.step(rooms.size());
+
+                manifest.writeIfChanged("zone/" + zoneKey + ".json", w.steal(), "zone");
+            }
+        },
+        [](auto &) {});
 }
 
 } // namespace
@@ -457,11 +901,14 @@ bool JsonMapStorage::virt_saveData(const MapLoadData &mapData)
     auto &progressCounter = getProgressCounter();
     progressCounter.setNewTask(ProgressMsg{}, roomsCount * 2 + marksCount);
 
-    JsonWorld world;
-    world.addRooms(roomList, progressCounter);
-
     QDir saveDir(getFilename());
     QDir destDir(QFileInfo(saveDir, "v1").filePath());
+
+    const std::optional<PreviousExport> prev = getPreviousExportCache().take(destDir.path());
+
+    JsonWorld world;
+    world.addRooms(roomList, prev.has_value() ? &prev.value() : nullptr, progressCounter);
+
     QDir roomIndexDir(QFileInfo(destDir, "roomindex").filePath());
     QDir zoneDir(QFileInfo(destDir, "zone").filePath());
     try {
@@ -476,9 +923,20 @@ bool JsonMapStorage::virt_saveData(const MapLoadData &mapData)
             throw std::runtime_error("error creating dir v1/zone");
         }
 
-        world.writeMetadata(QFileInfo(destDir, "arda.json"), map.getBounds().value_or(Bounds{}));
-        world.writeRoomIndex(roomIndexDir);
-        world.writeZones(zoneDir, progressCounter);
+        ExportManifest manifest(destDir);
+        if (!prev.has_value() || prev->manifestHash != manifest.getPreviousHash()) {
+            world.markEverythingDirty();
+        }
+        world.writeMetadata(manifest, map.getBounds().value_or(Bounds{}));
+        world.writeRoomIndex(manifest);
+        world.writeZones(manifest, progressCounter);
+        manifest.removeStale();
+        const QByteArray manifestHash = manifest.save();
+        getPreviousExportCache().put(world.release(destDir.path(), manifestHash, map));
+
+        log(QString("Wrote %1 of %2 files; the others were unchanged.")
+                .arg(manifest.getWrittenCount())
+                .arg(manifest.getFileCount()));
     } catch (const std::exception &e) {
         log(e.what());
         return false;
@@ -21,6 +21,11 @@ class QObject;
  * - v1/arda.json (global metadata like map size).
  * - v1/roomindex/ss.json (room sums -> zone coords).
  * - v1/zone/xx-yy.json (full info on the NxN rooms zone at coords xx,yy).
+ * - v1/manifest.json (content hash of each file above).
+ *
+ * Files whose content hash matches the manifest of the previous export are not rewritten,
+ * and the zones and room index files without changed rooms since the previous export in
+ * this session are not even serialized again.
  */
 class NODISCARD_QOBJECT JsonMapStorage final : public AbstractMapStorage
 {
@@ -432,6 +432,9 @@ std::optional<RawMapLoadData> MapStorage::virt_loadData()
                                                                                compressedData)
                                               : StorageUtils::mmqt::zlib_inflate(progressCounter,
                                                                                  compressedData);
+            progressCounter.addByteCount("bytes read", static_cast<size_t>(compressedData.size()));
+            progressCounter.addByteCount("bytes decompressed",
+                                         static_cast<size_t>(uncompressedData.size()));
             buffer.setData(uncompressedData);
             buffer.open(QIODevice::ReadOnly);
             stream.setDevice(&buffer);
@@ -663,6 +666,8 @@ bool MapStorage::virt_saveData(const MapLoadData &mapData)
         log(QString("Map compressed (compression ratio of %1:1)")
                 .arg(QString::number(compressionRatio, 'f', 1)));
 
+        progressCounter.addByteCount("bytes written", static_cast<size_t>(compressedData.size()));
+
         // TODO: add progress counter
         fileStream.writeRawData(compressedData.data(), static_cast<int>(compressedData.size()));
     }
@@ -27,7 +27,7 @@ void GameObserver::observeSentToUser(const QString &input)
 
 void GameObserver::observeSentToUserGmcp(const GmcpMessage &m)
 {
-    sig2_sentToUserGmcp.invoke(m);
+    sentToUserGmcp.dispatch(m);
 }
 
 void GameObserver::observeToggledEchoMode(const bool echo)
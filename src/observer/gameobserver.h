@@ -6,6 +6,7 @@
 #include "../clock/mumemoment.h"
 #include "../global/Signal2.h"
 #include "../map/PromptFlags.h"
+#include "../proxy/GmcpDispatcher.h"
 #include "../proxy/GmcpMessage.h"
 
 class NODISCARD GameObserver final
@@ -16,7 +17,8 @@ class NODISCARD GameObserver final
     Signal2<QString> sig2_sentToMudString;  // removes ANSI
     Signal2<QString> sig2_sentToUserString; // removes ANSI
 
-    Signal2<GmcpMessage> sig2_sentToUserGmcp;
+    // Subscribe to the message types you care about; see GmcpDispatcher.
+    GmcpDispatcher sentToUserGmcp;
     Signal2<bool> sig2_toggledEchoMode;
 
     Signal2<MumeTimeEnum> sig2_timeOfDayChanged;
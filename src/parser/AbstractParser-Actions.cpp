@@ -3,7 +3,6 @@
 // Author: Nils Schimmelmann <nschimme@gmail.com> (Jahara)
 
 #include "../clock/mumeclock.h"
-#include "../global/Consts.h"
 #include "Action.h"
 #include "abstractparser.h"
 
@@ -21,32 +20,22 @@ static void maybePop(Queue &queue)
 
 void MumeXmlParserBase::initActionMap()
 {
-    auto &map = m_actionMap;
-    map.clear();
+    auto &matcher = m_actionMatcher;
+    matcher.clear();
 
-    auto addStartsWith = [&map](const std::string &match, const ActionCallback &callback) {
+    auto addStartsWith = [&matcher](const std::string &match, const ActionCallback &callback) {
         assert(!match.empty());
-        const char hint = match[0];
-        map.emplace(hint, std::make_unique<StartsWithAction>(match, callback));
+        matcher.addStartsWith(match, callback);
     };
 
-    auto addEndsWith = [&map](const std::string &match, const ActionCallback &callback) {
+    auto addEndsWith = [&matcher](const std::string &match, const ActionCallback &callback) {
         assert(!match.empty());
-        const char hint = 0;
-        map.emplace(hint, std::make_unique<EndsWithAction>(match, callback));
+        matcher.addEndsWith(match, callback);
     };
 
-    auto addRegex = [&map](const std::string &match, const ActionCallback &callback) {
+    auto addRegex = [&matcher](const std::string &match, const ActionCallback &callback) {
         assert(!match.empty());
-        const char hint = std::invoke([&match]() -> char {
-            using namespace char_consts;
-            if (match.length() > 2 && match[0] == C_CARET && match[1] != C_BACKSLASH
-                && match[1] != C_OPEN_PARENS) {
-                return match[1];
-            }
-            return 0;
-        });
-        map.emplace(hint, std::make_unique<RegexAction>(match, callback));
+        matcher.addRegex(match, callback);
     };
 
     /// Positions
@@ -123,19 +112,6 @@ bool MumeXmlParserBase::evalActionMap(StringView line)
         return false;
     }
 
-    auto &map = m_actionMap;
-
-    auto range = map.equal_range(line.firstChar());
-    for (auto it = range.first; it != range.second; ++it) {
-        const ActionHolder &action = it->second;
-        action.match(line);
-    }
-
-    range = map.equal_range(0);
-    for (auto it = range.first; it != range.second; ++it) {
-        const ActionHolder &action = it->second;
-        action.match(line);
-    }
-
+    m_actionMatcher.match(line);
     return false;
 }
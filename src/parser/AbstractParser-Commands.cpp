@@ -8,6 +8,7 @@
 #include "../global/Consts.h"
 #include "../global/EnumIndexedArray.h"
 #include "../global/LineUtils.h"
+#include "../global/PerfStats.h"
 #include "../global/StringView.h"
 #include "../global/TextUtils.h"
 #include "../global/View.h"
@@ -21,6 +22,7 @@
 #include "../map/infomark.h"
 #include "../mapdata/mapdata.h"
 #include "../observer/gameobserver.h"
+#include "../proxy/GmcpDispatcher.h"
 #include "../syntax/Sublist.h"
 #include "../syntax/SyntaxArgs.h"
 #include "../syntax/TreeParser.h"
@@ -33,6 +35,7 @@
 #include "abstractparser.h"
 
 #include <algorithm>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <ostream>
@@ -206,6 +209,7 @@ const Abbrev cmdHelp{"help", 2};
 const Abbrev cmdHotkey{"hotkey", 3};
 const Abbrev cmdMap{"map"};
 const Abbrev cmdMark{"mark", 3};
+const Abbrev cmdPerf{"perf", 4};
 // TODO: move this to a sub-command of _map
 const Abbrev cmdRemoveDoorNames{"remove-secret-door-names"};
 const Abbrev cmdRoom{"room", 2};
@@ -1171,6 +1175,14 @@ void AbstractParser::initSpecialCommandMap()
         },
         makeSimpleHelp("List or manage background tasks."));
 
+    add(
+        cmdPerf,
+        [this](const View<StringView> /*s*/, StringView rest) -> bool {
+            this->doPerfCommand(rest);
+            return true;
+        },
+        makeSimpleHelp("Show, reset, or export per-stage latency histograms."));
+
     add(
         cmdBack,
         [this](const View<StringView> /*s*/, StringView rest) {
@@ -1410,6 +1422,13 @@ void AbstractParser::doTasksCommand(StringView rest)
         },
         "list background tasks");
 
+    const auto doTaskStats = syntax::Accept(
+        [](User &user, const Pair * /*args*/) {
+            AnsiOstream &aos = user.getOstream();
+            async_tasks::report_stats(aos);
+        },
+        "show per-phase timings and memory usage of recent tasks");
+
     // _async task cancel all
     const auto doTaskCancelAll = syntax::Accept(
         [](User &user, const Pair *args) {
@@ -1462,6 +1481,7 @@ void AbstractParser::doTasksCommand(StringView rest)
     /////
 
     const auto taskSyntax = syn(syn("list", doTaskList),
+                                syn("stats", doTaskStats),
                                 syn("cancel", "all", doTaskCancelAll),
                                 syn(argInt, //
                                     syn("status", doTaskStatus),
@@ -1471,3 +1491,60 @@ void AbstractParser::doTasksCommand(StringView rest)
 
     eval("async", taskSyntax, rest);
 }
+
+void AbstractParser::doPerfCommand(StringView rest)
+{
+    const auto argFilename = syntax::TokenMatcher::alloc<syntax::ArgString>();
+
+    /////
+
+    const auto doPerfShow = syntax::Accept(
+        [](User &user, const Pair * /*args*/) {
+            AnsiOstream &aos = user.getOstream();
+            perf_stats::report(aos);
+            gmcp_dispatch_stats::report(aos);
+        },
+        "show latency histograms");
+
+    const auto doPerfReset = syntax::Accept(
+        [](User &user, const Pair * /*args*/) {
+            perf_stats::reset();
+            gmcp_dispatch_stats::reset();
+            send_ok(user.getOstream());
+        },
+        "reset latency histograms");
+
+    const auto doPerfJson = syntax::Accept(
+        [](User &user, const Pair * /*args*/) {
+            AnsiOstream &aos = user.getOstream();
+            aos << perf_stats::toJson();
+        },
+        "print latency histograms as JSON");
+
+    // _perf save <filename>
+    const auto doPerfSave = syntax::Accept(
+        [](User &user, const Pair *args) {
+            AnsiOstream &aos = user.getOstream();
+            const auto argv = getAnyVectorReversed(args);
+            assert(argv.size() == 2);
+            assert(argv[0].getString() == "save");
+
+            const auto &filename = argv[1].getString();
+            std::ofstream file{filename, std::ios::out | std::ios::trunc | std::ios::binary};
+            if (!file || !(file << perf_stats::toJson())) {
+                aos << "Error: unable to write " << ColoredValue{red, filename} << ".\n";
+                return;
+            }
+            aos << "Saved latency histograms to " << ColoredValue{green, filename} << ".\n";
+        },
+        "save latency histograms as JSON");
+
+    /////
+
+    const auto perfSyntax = syn(syn("show", doPerfShow),
+                                syn("reset", doPerfReset),
+                                syn("json", doPerfJson),
+                                syn("save", argFilename, doPerfSave));
+
+    eval("perf", perfSyntax, rest);
+}
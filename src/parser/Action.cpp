@@ -4,42 +4,796 @@
 
 #include "Action.h"
 
+#include "../global/tests.h"
+
+#include <algorithm>
+#include <cassert>
+#include <optional>
 #include <regex>
+#include <stdexcept>
+#include <tuple>
+
+namespace { // anonymous
+
+// Lines that keep producing new DFA states (which shouldn't happen with MUME's output)
+// can't grow the cache without bound; it's simply rebuilt.
+constexpr size_t MAX_DFA_STATES = 4096;
+constexpr int MAX_REPEAT = 1000;
+
+using ByteSet = std::bitset<256>;
+
+NODISCARD ByteSet byteRange(const uint8_t lo, const uint8_t hi)
+{
+    ByteSet result;
+    for (int c = lo; c <= hi; ++c) {
+        result.set(static_cast<size_t>(c));
+    }
+    return result;
+}
+
+NODISCARD ByteSet singleByte(const char c)
+{
+    ByteSet result;
+    result.set(static_cast<uint8_t>(c));
+    return result;
+}
+
+NODISCARD ByteSet anyByte()
+{
+    return ByteSet{}.set();
+}
+
+NODISCARD ByteSet digitBytes()
+{
+    return byteRange('0', '9');
+}
 
-IAction::~IAction() = default;
+NODISCARD ByteSet wordBytes()
+{
+    return digitBytes() | byteRange('a', 'z') | byteRange('A', 'Z') | singleByte('_');
+}
+
+NODISCARD ByteSet spaceBytes()
+{
+    return byteRange('\t', '\r') | singleByte(' ');
+}
 
-void IAction::match(const StringView input) const
+// ECMAScript's "." doesn't match line terminators.
+NODISCARD ByteSet dotBytes()
 {
-    return virt_match(input);
+    return anyByte() & ~(singleByte('\n') | singleByte('\r'));
 }
 
-void StartsWithAction::virt_match(const StringView input) const
+NODISCARD int hexValue(const char c)
 {
-    if (input.startsWith(m_match)) {
-        m_callback(input);
+    if (c >= '0' && c <= '9') {
+        return c - '0';
     }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
 }
 
-void EndsWithAction::virt_match(const StringView input) const
+} // namespace
+
+// Recursive descent parser for the supported ECMAScript subset; the parse tree is then
+// compiled back-to-front into Thompson NFA states ending at the trigger's accept state.
+struct NODISCARD ActionMatcher::RegexCompiler final
 {
-    if (input.endsWith(m_match)) {
-        m_callback(input);
+private:
+    struct NODISCARD Node final
+    {
+        enum class NODISCARD KindEnum : uint8_t { Bytes, Concat, Alternation, Repeat };
+        KindEnum kind = KindEnum::Concat;
+        ByteSet bytes;
+        std::vector<Node> children;
+        int min = 1;
+        int max = 1; // negative means unbounded
+    };
+
+private:
+    ActionMatcher &m_matcher;
+    const std::string_view m_pattern;
+    std::string_view m_body;
+    size_t m_pos = 0;
+
+public:
+    explicit RegexCompiler(ActionMatcher &matcher, const std::string_view pattern)
+        : m_matcher{matcher}
+        , m_pattern{pattern}
+        , m_body{pattern}
+    {}
+
+public:
+    NODISCARD NfaStateId compile(const NfaStateId accept)
+    {
+        // The whole line always has to match, so anchors at the ends don't change anything.
+        if (!m_body.empty() && m_body.front() == '^') {
+            m_body.remove_prefix(1);
+        }
+        if (!m_body.empty() && m_body.back() == '$' && !isEscaped(m_body.size() - 1)) {
+            m_body.remove_suffix(1);
+        }
+
+        const Node root = parseAlternation();
+        if (!atEnd()) {
+            fail("unmatched ')'");
+        }
+        return compileNode(root, accept);
+    }
+
+private:
+    [[noreturn]] void fail(const std::string_view what) const
+    {
+        throw std::invalid_argument("regex \"" + std::string{m_pattern} + "\": "
+                                    + std::string{what});
+    }
+
+    NODISCARD bool isEscaped(const size_t pos) const
+    {
+        size_t numBackslashes = 0;
+        while (numBackslashes < pos && m_body[pos - numBackslashes - 1] == '\\') {
+            ++numBackslashes;
+        }
+        return numBackslashes % 2 != 0;
+    }
+
+    NODISCARD bool atEnd() const { return m_pos >= m_body.size(); }
+    NODISCARD char peek() const { return atEnd() ? '\0' : m_body[m_pos]; }
+    NODISCARD char take()
+    {
+        if (atEnd()) {
+            fail("unexpected end of pattern");
+        }
+        return m_body[m_pos++];
+    }
+    NODISCARD bool tryTake(const char c)
+    {
+        if (!atEnd() && m_body[m_pos] == c) {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    NODISCARD static Node makeBytes(const ByteSet &bytes)
+    {
+        Node node;
+        node.kind = Node::KindEnum::Bytes;
+        node.bytes = bytes;
+        return node;
+    }
+
+    NODISCARD Node parseAlternation()
+    {
+        Node node;
+        node.kind = Node::KindEnum::Alternation;
+        node.children.emplace_back(parseConcat());
+        while (tryTake('|')) {
+            node.children.emplace_back(parseConcat());
+        }
+        if (node.children.size() == 1) {
+            return std::move(node.children.front());
+        }
+        return node;
+    }
+
+    NODISCARD Node parseConcat()
+    {
+        Node node;
+        node.kind = Node::KindEnum::Concat;
+        while (!atEnd() && peek() != '|' && peek() != ')') {
+            node.children.emplace_back(parseRepeat());
+        }
+        return node;
+    }
+
+    NODISCARD int parseNumber()
+    {
+        if (peek() < '0' || peek() > '9') {
+            fail("expected a number in {}");
+        }
+        int result = 0;
+        while (peek() >= '0' && peek() <= '9') {
+            result = result * 10 + (take() - '0');
+            if (result > MAX_REPEAT) {
+                fail("repeat count is too large");
+            }
+        }
+        return result;
+    }
+
+    NODISCARD Node parseRepeat()
+    {
+        Node atom = parseAtom();
+        while (true) {
+            int min = 0;
+            int max = 0;
+            if (tryTake('?')) {
+                max = 1;
+            } else if (tryTake('*')) {
+                max = -1;
+            } else if (tryTake('+')) {
+                min = 1;
+                max = -1;
+            } else if (tryTake('{')) {
+                min = parseNumber();
+                max = min;
+                if (tryTake(',')) {
+                    max = (peek() == '}') ? -1 : parseNumber();
+                }
+                if (!tryTake('}')) {
+                    fail("expected '}'");
+                }
+                if (max >= 0 && max < min) {
+                    fail("invalid repeat range");
+                }
+            } else {
+                return atom;
+            }
+            // Lazy and greedy quantifiers accept the same lines.
+            std::ignore = tryTake('?');
+
+            Node repeat;
+            repeat.kind = Node::KindEnum::Repeat;
+            repeat.min = min;
+            repeat.max = max;
+            repeat.children.emplace_back(std::move(atom));
+            atom = std::move(repeat);
+        }
+    }
+
+    NODISCARD Node parseAtom()
+    {
+        const char c = take();
+        switch (c) {
+        case '(': {
+            if (tryTake('?') && !tryTake(':')) {
+                fail("only (?:...) groups are supported");
+            }
+            Node node = parseAlternation();
+            if (!tryTake(')')) {
+                fail("expected ')'");
+            }
+            return node;
+        }
+        case '[':
+            return makeBytes(parseClass());
+        case '.':
+            return makeBytes(dotBytes());
+        case '\\':
+            return makeBytes(parseEscape(false));
+        case '^':
+        case '$':
+            fail("anchors are only supported at the ends of the pattern");
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+            fail("nothing to repeat");
+        default:
+            return makeBytes(singleByte(c));
+        }
+    }
+
+    NODISCARD ByteSet parseEscape(const bool inClass)
+    {
+        const char c = take();
+        switch (c) {
+        case 'd':
+            return digitBytes();
+        case 'D':
+            return ~digitBytes();
+        case 'w':
+            return wordBytes();
+        case 'W':
+            return ~wordBytes();
+        case 's':
+            return spaceBytes();
+        case 'S':
+            return ~spaceBytes();
+        case 'f':
+            return singleByte('\f');
+        case 'n':
+            return singleByte('\n');
+        case 'r':
+            return singleByte('\r');
+        case 't':
+            return singleByte('\t');
+        case 'v':
+            return singleByte('\v');
+        case '0':
+            if (peek() >= '0' && peek() <= '9') {
+                fail("octal escapes are not supported");
+            }
+            return singleByte('\0');
+        case 'b':
+            if (inClass) {
+                return singleByte('\b');
+            }
+            fail("word boundaries are not supported");
+        case 'x': {
+            const int hi = hexValue(take());
+            const int lo = hexValue(take());
+            if (hi < 0 || lo < 0) {
+                fail("invalid \\x escape");
+            }
+            return singleByte(static_cast<char>(hi * 16 + lo));
+        }
+        default:
+            break;
+        }
+
+        const auto uc = static_cast<uint8_t>(c);
+        if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+            || uc >= 0x80) {
+            fail("unsupported escape");
+        }
+        return singleByte(c);
+    }
+
+    // Returns the byte, or nullopt if the item is a class like \d.
+    NODISCARD std::optional<uint8_t> parseClassItem(ByteSet &bytes)
+    {
+        const char c = take();
+        if (c != '\\') {
+            bytes = singleByte(c);
+            return static_cast<uint8_t>(c);
+        }
+        bytes = parseEscape(true);
+        if (bytes.count() == 1) {
+            for (size_t i = 0; i < bytes.size(); ++i) {
+                if (bytes.test(i)) {
+                    return static_cast<uint8_t>(i);
+                }
+            }
+        }
+        return std::nullopt;
+    }
+
+    NODISCARD ByteSet parseClass()
+    {
+        const bool negate = tryTake('^');
+        ByteSet result;
+        while (!tryTake(']')) {
+            ByteSet item;
+            const auto lo = parseClassItem(item);
+            if (peek() == '-' && m_pos + 1 < m_body.size() && m_body[m_pos + 1] != ']') {
+                std::ignore = take();
+                ByteSet hiItem;
+                const auto hi = parseClassItem(hiItem);
+                if (!lo || !hi || *lo > *hi) {
+                    fail("invalid range in []");
+                }
+                item = byteRange(*lo, *hi);
+            }
+            result |= item;
+        }
+        return negate ? ~result : result;
+    }
+
+private:
+    NODISCARD NfaStateId addSplit(const NfaStateId out, const NfaStateId out1)
+    {
+        NfaState state;
+        state.kind = NfaState::KindEnum::Split;
+        state.out = out;
+        state.out1 = out1;
+        return m_matcher.addNfaState(state);
+    }
+
+    NODISCARD NfaStateId compileNode(const Node &node, const NfaStateId next)
+    {
+        switch (node.kind) {
+        case Node::KindEnum::Bytes: {
+            NfaState state;
+            state.kind = NfaState::KindEnum::Byte;
+            state.bytes = node.bytes;
+            state.out = next;
+            return m_matcher.addNfaState(state);
+        }
+        case Node::KindEnum::Concat: {
+            NfaStateId cur = next;
+            for (auto it = node.children.rbegin(); it != node.children.rend(); ++it) {
+                cur = compileNode(*it, cur);
+            }
+            return cur;
+        }
+        case Node::KindEnum::Alternation: {
+            NfaStateId cur = compileNode(node.children.back(), next);
+            for (size_t i = node.children.size() - 1; i-- > 0;) {
+                cur = addSplit(compileNode(node.children[i], next), cur);
+            }
+            return cur;
+        }
+        case Node::KindEnum::Repeat: {
+            const Node &child = node.children.front();
+            NfaStateId cur = next;
+            if (node.max < 0) {
+                const NfaStateId loop = addSplit(next, next);
+                m_matcher.m_nfa[loop].out = compileNode(child, loop);
+                cur = loop;
+            } else {
+                for (int i = node.min; i < node.max; ++i) {
+                    cur = addSplit(compileNode(child, cur), next);
+                }
+            }
+            for (int i = 0; i < node.min; ++i) {
+                cur = compileNode(child, cur);
+            }
+            return cur;
+        }
+        }
+        std::abort();
     }
+};
+
+ActionMatcher::NfaStateId ActionMatcher::addNfaState(NfaState state)
+{
+    const auto id = static_cast<NfaStateId>(m_nfa.size());
+    m_nfa.emplace_back(std::move(state));
+    return id;
 }
 
-NODISCARD static std::regex createRegex(const std::string &pattern)
+void ActionMatcher::addTrigger(const NfaStateId start, ActionCallback callback)
 {
-    return std::regex(pattern, std::regex::nosubs | std::regex::optimize);
+    m_starts.push_back(start);
+    m_callbacks.emplace_back(std::move(callback));
+    invalidateDfa();
 }
 
-RegexAction::RegexAction(const std::string &pattern, const ActionCallback &callback)
-    : m_regex{createRegex(pattern)}
-    , m_callback{callback}
-{}
+void ActionMatcher::addStartsWith(const std::string_view literal, ActionCallback callback)
+{
+    NfaState accept;
+    accept.kind = NfaState::KindEnum::Accept;
+    accept.action = m_callbacks.size();
+
+    // literal, then anything
+    NfaStateId cur = addNfaState(accept);
+    NfaState any;
+    any.kind = NfaState::KindEnum::Byte;
+    any.bytes = anyByte();
+    const NfaStateId anyId = addNfaState(any);
+    NfaState loop;
+    loop.out = anyId;
+    loop.out1 = cur;
+    cur = addNfaState(loop);
+    m_nfa[anyId].out = cur;
 
-void RegexAction::virt_match(const StringView input) const
+    for (auto it = literal.rbegin(); it != literal.rend(); ++it) {
+        NfaState state;
+        state.kind = NfaState::KindEnum::Byte;
+        state.bytes = singleByte(*it);
+        state.out = cur;
+        cur = addNfaState(state);
+    }
+    addTrigger(cur, std::move(callback));
+}
+
+void ActionMatcher::addEndsWith(const std::string_view literal, ActionCallback callback)
 {
-    if (std::regex_match(input.begin(), input.end(), m_regex)) {
-        m_callback(input);
+    NfaState accept;
+    accept.kind = NfaState::KindEnum::Accept;
+    accept.action = m_callbacks.size();
+
+    // anything, then literal
+    NfaStateId cur = addNfaState(accept);
+    for (auto it = literal.rbegin(); it != literal.rend(); ++it) {
+        NfaState state;
+        state.kind = NfaState::KindEnum::Byte;
+        state.bytes = singleByte(*it);
+        state.out = cur;
+        cur = addNfaState(state);
+    }
+    NfaState any;
+    any.kind = NfaState::KindEnum::Byte;
+    any.bytes = anyByte();
+    const NfaStateId anyId = addNfaState(any);
+    NfaState loop;
+    loop.out = anyId;
+    loop.out1 = cur;
+    cur = addNfaState(loop);
+    m_nfa[anyId].out = cur;
+
+    addTrigger(cur, std::move(callback));
+}
+
+void ActionMatcher::addRegex(const std::string_view pattern, ActionCallback callback)
+{
+    NfaState accept;
+    accept.kind = NfaState::KindEnum::Accept;
+    accept.action = m_callbacks.size();
+
+    const NfaStateId start = RegexCompiler{*this, pattern}.compile(addNfaState(accept));
+    addTrigger(start, std::move(callback));
+}
+
+void ActionMatcher::clear()
+{
+    m_callbacks.clear();
+    m_nfa.clear();
+    m_starts.clear();
+    invalidateDfa();
+}
+
+void ActionMatcher::invalidateDfa()
+{
+    m_dfa.clear();
+    m_dfaLookup.clear();
+}
+
+void ActionMatcher::addClosure(const NfaStateId id, std::vector<NfaStateId> &result)
+{
+    std::vector<NfaStateId> stack{id};
+    while (!stack.empty()) {
+        const NfaStateId cur = stack.back();
+        stack.pop_back();
+        if (m_visited[cur] == m_visitGeneration) {
+            continue;
+        }
+        m_visited[cur] = m_visitGeneration;
+
+        const NfaState &state = m_nfa[cur];
+        if (state.kind == NfaState::KindEnum::Split) {
+            stack.push_back(state.out1);
+            stack.push_back(state.out);
+        } else {
+            result.push_back(cur);
+        }
+    }
+}
+
+ActionMatcher::DfaStateId ActionMatcher::getDfaState(std::vector<NfaStateId> nfaStates)
+{
+    std::sort(nfaStates.begin(), nfaStates.end());
+    if (const auto it = m_dfaLookup.find(nfaStates); it != m_dfaLookup.end()) {
+        return it->second;
+    }
+
+    DfaState state;
+    for (const NfaStateId id : nfaStates) {
+        if (m_nfa[id].kind == NfaState::KindEnum::Accept) {
+            state.accepts.push_back(m_nfa[id].action);
+        }
+    }
+    std::sort(state.accepts.begin(), state.accepts.end());
+    state.next.fill(UNKNOWN_DFA_STATE);
+    state.nfaStates = nfaStates;
+
+    const auto id = static_cast<DfaStateId>(m_dfa.size());
+    m_dfa.emplace_back(std::move(state));
+    m_dfaLookup.emplace(std::move(nfaStates), id);
+    return id;
+}
+
+ActionMatcher::DfaStateId ActionMatcher::getStartState()
+{
+    if (m_dfa.size() > MAX_DFA_STATES) {
+        invalidateDfa();
+    }
+    if (!m_dfa.empty()) {
+        return START_DFA_STATE;
+    }
+
+    // Each state is visited at most once per closure, so one generation covers all starts.
+    m_visited.resize(m_nfa.size(), 0);
+    ++m_visitGeneration;
+    std::vector<NfaStateId> nfaStates;
+    for (const NfaStateId start : m_starts) {
+        addClosure(start, nfaStates);
+    }
+    const DfaStateId id = getDfaState(std::move(nfaStates));
+    assert(id == START_DFA_STATE);
+    // Reserve the second id for the state with no live NFA states, so match() can
+    // stop early with a plain comparison.
+    const DfaStateId dead = getDfaState({});
+    assert(dead == DEAD_DFA_STATE);
+    std::ignore = dead;
+    return id;
+}
+
+ActionMatcher::DfaStateId ActionMatcher::step(const DfaStateId from, const uint8_t byte)
+{
+    m_visited.resize(m_nfa.size(), 0);
+    if (++m_visitGeneration == 0) {
+        std::fill(m_visited.begin(), m_visited.end(), 0);
+        m_visitGeneration = 1;
+    }
+
+    std::vector<NfaStateId> nfaStates;
+    for (const NfaStateId id : m_dfa[static_cast<size_t>(from)].nfaStates) {
+        const NfaState &state = m_nfa[id];
+        if (state.kind == NfaState::KindEnum::Byte && state.bytes.test(byte)) {
+            addClosure(state.out, nfaStates);
+        }
+    }
+
+    // NOTE: getDfaState() can reallocate m_dfa.
+    const DfaStateId to = getDfaState(std::move(nfaStates));
+    m_dfa[static_cast<size_t>(from)].next[byte] = to;
+    return to;
+}
+
+void ActionMatcher::match(const StringView line)
+{
+    if (m_callbacks.empty()) {
+        return;
+    }
+
+    DfaStateId state = getStartState();
+    for (const char c : line) {
+        const auto byte = static_cast<uint8_t>(c);
+        DfaStateId next = m_dfa[static_cast<size_t>(state)].next[byte];
+        if (next == UNKNOWN_DFA_STATE) {
+            next = step(state, byte);
+        }
+        if (next == DEAD_DFA_STATE) {
+            return;
+        }
+        state = next;
+    }
+
+    // Copied, since a callback is free to add triggers (which rebuilds the DFA).
+    const std::vector<size_t> accepts = m_dfa[static_cast<size_t>(state)].accepts;
+    for (const size_t action : accepts) {
+        m_callbacks[action](line);
+    }
+}
+
+namespace { // anonymous
+struct NODISCARD ReferenceTrigger final
+{
+    enum class NODISCARD KindEnum : uint8_t { StartsWith, EndsWith, Regex };
+    KindEnum kind = KindEnum::StartsWith;
+    std::string text;
+};
+
+// The per-trigger matching that ActionMatcher replaced.
+NODISCARD bool referenceMatch(const ReferenceTrigger &trigger, const std::string &line)
+{
+    const StringView sv{line};
+    switch (trigger.kind) {
+    case ReferenceTrigger::KindEnum::StartsWith:
+        return sv.startsWith(trigger.text);
+    case ReferenceTrigger::KindEnum::EndsWith:
+        return sv.endsWith(trigger.text);
+    case ReferenceTrigger::KindEnum::Regex: {
+        const std::regex re{trigger.text, std::regex::nosubs | std::regex::optimize};
+        return std::regex_match(line, re);
+    }
+    }
+    std::abort();
+}
+} // namespace
+
+void test::testActionMatcher()
+{
+    using KindEnum = ReferenceTrigger::KindEnum;
+    const std::vector<ReferenceTrigger> triggers{
+        {KindEnum::StartsWith, "You are too exhausted."},
+        {KindEnum::StartsWith, "You are too exhausted to ride."},
+        {KindEnum::StartsWith, "The current time is"},
+        {KindEnum::EndsWith, "seem to be closed."},
+        {KindEnum::EndsWith, "seems to be closed."},
+        {KindEnum::EndsWith, "is too exhausted."},
+        {KindEnum::EndsWith, "of the Third Age."},
+        {KindEnum::Regex, R"(^ZBLAM! .+ doesn't want you riding (him|her|it) anymore.$)"},
+        {KindEnum::Regex,
+         R"(^(?:Needed:(?: [\d,]+ xp)?(?:,? [\d,]+ tp)\. )?(Gold|Lauren): [\d,]+\.)"
+         R"((?: Iv: [^.]+\.)?)"
+         R"( Alert: \w+\.(?: Condition: [^.]+\.)?)"},
+        {KindEnum::Regex, R"(a{2,3}b*?c+\$)"},
+        {KindEnum::Regex, R"([^a-c\s]x?|\x41\.\\)"},
+        {KindEnum::Regex, R"(.*(ab|a)*)"},
+    };
+
+    ActionMatcher matcher;
+    std::vector<size_t> matched;
+    for (size_t i = 0; i < triggers.size(); ++i) {
+        const auto &trigger = triggers[i];
+        auto callback = [&matched, i](StringView) { matched.push_back(i); };
+        switch (trigger.kind) {
+        case KindEnum::StartsWith:
+            matcher.addStartsWith(trigger.text, callback);
+            break;
+        case KindEnum::EndsWith:
+            matcher.addEndsWith(trigger.text, callback);
+            break;
+        case KindEnum::Regex:
+            matcher.addRegex(trigger.text, callback);
+            break;
+        }
+    }
+    TEST_ASSERT(matcher.size() == triggers.size());
+
+    const std::vector<std::string> pieces{
+        "You are too exhausted",
+        " to ride",
+        ".",
+        "The current time is 5:00 am",
+        "The door",
+        " seems to be closed.",
+        " seem to be closed.",
+        "A pack horse is too exhausted.",
+        "Sunday, the 12th of Afterlithe, year 3030 of the Third Age.",
+        "ZBLAM! ",
+        "A horse",
+        " doesn't want you riding ",
+        "him",
+        "it",
+        " anymore.",
+        "Needed: 1,234 xp, 5 tp. ",
+        "Gold: 12,345.",
+        "Lauren: 3.",
+        " Iv: 5.",
+        " Alert: Normal.",
+        " Condition: Hungry.",
+        "aa",
+        "aaa",
+        "b",
+        "c",
+        "$",
+        "A.\\",
+        "d",
+        "x",
+        "ab",
+        " ",
+        "\t",
+        "\xE9",
+        "",
+    };
+
+    // deterministic pseudo-random lines built from the pieces
+    uint32_t seed = 12345;
+    const auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+
+    std::vector<std::string> lines;
+    for (const auto &piece : pieces) {
+        lines.push_back(piece);
+    }
+    lines.emplace_back("You are too exhausted to ride.");
+    lines.emplace_back("ZBLAM! A wild horse doesn't want you riding her anymore.");
+    lines.emplace_back("Needed: 1,234 xp, 5 tp. Gold: 12. Alert: Normal. Condition: Hungry.");
+    lines.emplace_back("Gold: 12. Alert: Normal.");
+    lines.emplace_back("Gold: 12. Alert: Normal. Condition: Hungry. Extra");
+    for (int i = 0; i < 3000; ++i) {
+        std::string line;
+        const auto numPieces = 1 + next() % 5;
+        for (uint32_t j = 0; j < numPieces; ++j) {
+            line += pieces[next() % pieces.size()];
+        }
+        lines.emplace_back(std::move(line));
+    }
+
+    for (const auto &line : lines) {
+        matched.clear();
+        matcher.match(StringView{line});
+
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < triggers.size(); ++i) {
+            if (referenceMatch(triggers[i], line)) {
+                expected.push_back(i);
+            }
+        }
+        TEST_ASSERT(matched == expected);
+    }
+
+    for (const std::string_view bad : {"(?=a)", "a\\b", "(a)\\1", "*a", "a{2", "(a", "a)", "[z-a]"}) {
+        bool threw = false;
+        try {
+            matcher.addRegex(bad, [](StringView) {});
+        } catch (const std::invalid_argument &) {
+            threw = true;
+        }
+        TEST_ASSERT(threw);
     }
+    TEST_ASSERT(matcher.size() == triggers.size());
 }
@@ -6,90 +6,100 @@
 #include "../global/RuleOf5.h"
 #include "../global/StringView.h"
 
+#include <array>
+#include <bitset>
+#include <cstdint>
 #include <functional>
-#include <memory>
-#include <regex>
+#include <map>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 using ActionCallback = std::function<void(StringView)>;
 
-struct NODISCARD IAction
-{
-public:
-    virtual ~IAction();
-    IAction() = default;
-    DEFAULT_CTORS_AND_ASSIGN_OPS(IAction);
-
-private:
-    virtual void virt_match(StringView input) const = 0;
-
-public:
-    void match(StringView input) const;
-};
-
-class NODISCARD StartsWithAction : public IAction
+// All of the line triggers compiled into a single automaton, so a line is matched against
+// every trigger in one pass over its bytes, no matter how many triggers there are.
+//
+// Each trigger becomes a branch of one NFA that must match the whole line (a starts-with
+// literal is followed by "anything", an ends-with literal is preceded by it). The NFA is
+// turned into a DFA lazily, one state per set of live NFA states actually reached, so the
+// steady-state cost per byte is a single table lookup.
+//
+// Regex triggers support the ECMAScript subset the parser needs: literals and escapes,
+// ".", "[...]" classes, \d \w \s (and their negations), groups, "|", and the ?, *, +,
+// {n,m} quantifiers, with "^" and "$" only at the ends of the pattern. Like
+// std::regex_match, a pattern has to match the entire line. Anything else (e.g. lookaheads,
+// backreferences, \b) throws std::invalid_argument when the trigger is added.
+class NODISCARD ActionMatcher final
 {
 private:
-    const std::string m_match;
-    const ActionCallback m_callback;
+    using NfaStateId = uint32_t;
+    using DfaStateId = int32_t;
+    static constexpr DfaStateId UNKNOWN_DFA_STATE = -1;
+    static constexpr DfaStateId START_DFA_STATE = 0;
+    static constexpr DfaStateId DEAD_DFA_STATE = 1;
 
-public:
-    explicit StartsWithAction(std::string moved_str, ActionCallback moved_callback)
-        : m_match{std::move(moved_str)}
-        , m_callback{std::move(moved_callback)}
-    {}
+    struct NODISCARD NfaState final
+    {
+        enum class NODISCARD KindEnum : uint8_t { Byte, Split, Accept };
+        KindEnum kind = KindEnum::Split;
+        std::bitset<256> bytes;
+        NfaStateId out = 0;
+        NfaStateId out1 = 0;
+        size_t action = 0;
+    };
+
+    struct NODISCARD DfaState final
+    {
+        std::vector<NfaStateId> nfaStates; // sorted; only Byte and Accept states
+        std::vector<size_t> accepts;       // sorted, i.e. in the order the triggers were added
+        std::array<DfaStateId, 256> next{};
+    };
 
 private:
-    void virt_match(StringView input) const override;
-};
+    std::vector<ActionCallback> m_callbacks;
+    std::vector<NfaState> m_nfa;
+    std::vector<NfaStateId> m_starts;
 
-class NODISCARD EndsWithAction : public IAction
-{
-private:
-    const std::string m_match;
-    const ActionCallback m_callback;
+    // lazily built from m_nfa
+    std::vector<DfaState> m_dfa;
+    std::map<std::vector<NfaStateId>, DfaStateId> m_dfaLookup;
+    std::vector<uint32_t> m_visited;
+    uint32_t m_visitGeneration = 0;
 
 public:
-    explicit EndsWithAction(std::string moved_str, ActionCallback moved_callback)
-        : m_match{std::move(moved_str)}
-        , m_callback{std::move(moved_callback)}
-    {}
+    ActionMatcher() = default;
+    ~ActionMatcher() = default;
+    DELETE_CTORS_AND_ASSIGN_OPS(ActionMatcher);
 
-private:
-    void virt_match(StringView input) const override;
-};
+public:
+    void addStartsWith(std::string_view literal, ActionCallback callback);
+    void addEndsWith(std::string_view literal, ActionCallback callback);
+    void addRegex(std::string_view pattern, ActionCallback callback);
+    void clear();
 
-class NODISCARD RegexAction : public IAction
-{
-private:
-    const std::regex m_regex;
-    const ActionCallback m_callback;
+public:
+    NODISCARD size_t size() const { return m_callbacks.size(); }
+    NODISCARD size_t getNumDfaStates() const { return m_dfa.size(); }
 
 public:
-    explicit RegexAction(const std::string &pattern, const ActionCallback &callback);
+    // Calls the callback of every trigger that matches the line, in the order they were added.
+    void match(StringView line);
 
 private:
-    void virt_match(StringView input) const override;
-};
+    NODISCARD NfaStateId addNfaState(NfaState state);
+    void addTrigger(NfaStateId start, ActionCallback callback);
+    void invalidateDfa();
+    NODISCARD DfaStateId getDfaState(std::vector<NfaStateId> nfaStates);
+    NODISCARD DfaStateId getStartState();
+    NODISCARD DfaStateId step(DfaStateId from, uint8_t byte);
+    void addClosure(NfaStateId id, std::vector<NfaStateId> &result);
 
-using ActionHint = char;
-struct NODISCARD ActionHolder final
-{
 private:
-    std::unique_ptr<IAction> m_ptr;
-
-public:
-    ActionHolder() noexcept = default;
-    ~ActionHolder() = default;
-    DEFAULT_MOVES_DELETE_COPIES(ActionHolder);
-    explicit ActionHolder(std::unique_ptr<IAction> ptr) CAN_THROW : m_ptr{std::move(ptr)}
-    {
-        std::ignore = deref(m_ptr); // called for side effect
-    }
-
-public:
-    void match(const StringView line) const { deref(m_ptr).match(line); }
+    struct RegexCompiler;
 };
-using ActionRecordMap = std::unordered_multimap<ActionHint, ActionHolder>;
+
+namespace test {
+extern void testActionMatcher();
+} // namespace test
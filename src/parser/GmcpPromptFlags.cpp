@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "GmcpPromptFlags.h"
+
+#include "../global/ConfigConsts.h"
+#include "../global/Consts.h"
+#include "../global/JsonView.h"
+#include "../global/TextUtils.h"
+#include "../map/PromptFlags.h"
+
+#include <QDebug>
+#include <QString>
+
+namespace { // anonymous
+volatile bool verbose_debugging = IS_DEBUG_BUILD;
+} // namespace
+
+// Note: The flags are read with getString() rather than getStringView(), because some of them
+// need an escape in JSON (e.g. heavy rain is sent as "\"").
+GmcpPromptFlagsUpdate applyGmcpPromptFlags(const JsonObjView &obj, PromptFlagsType &promptFlags)
+{
+    GmcpPromptFlagsUpdate result;
+
+    if (auto fog = obj.getString("fog")) {
+        if (verbose_debugging) {
+            qInfo().noquote() << "fog" << mmqt::toQStringUtf8(*fog);
+        }
+        if (fog == string_consts::SV_MINUS_SIGN) {
+            promptFlags.setFogType(PromptFogEnum::LIGHT_FOG);
+        } else if (fog == string_consts::SV_EQUALS) {
+            promptFlags.setFogType(PromptFogEnum::HEAVY_FOG);
+        } else {
+            qWarning().noquote() << "prompt has unknown fog flag:" << mmqt::toQStringUtf8(*fog);
+        }
+        result.fog = true;
+    } else if (obj.isNull("fog")) {
+        if (verbose_debugging) {
+            qInfo().noquote() << "fog null";
+        }
+        promptFlags.setFogType(PromptFogEnum::NO_FOG);
+        result.fog = true;
+    }
+
+    if (auto light = obj.getString("light")) {
+        if (verbose_debugging) {
+            qInfo().noquote() << "light" << mmqt::toQStringUtf8(*light);
+        }
+        if (light == string_consts::SV_ASTERISK            // indoor/sun (direct and indirect)
+            || light == string_consts::SV_CLOSE_PARENS) { // moon (direct and indirect)
+            promptFlags.setLit();
+        } else if (light == "o") { // darkness (magical, night, or permanent)
+            promptFlags.setDark();
+        } else if (light == string_consts::SV_EXCLAMATION) { // artifical light
+            promptFlags.setArtificial();
+        } else {
+            qWarning().noquote() << "prompt has unknown light flag:" << mmqt::toQStringUtf8(*light);
+        }
+    }
+
+    if (auto weather = obj.getString("weather")) {
+        if (verbose_debugging) {
+            qInfo().noquote() << "weather" << mmqt::toQStringUtf8(*weather);
+        }
+        if (weather == string_consts::SV_TILDE) {
+            promptFlags.setWeatherType(PromptWeatherEnum::CLOUDS);
+        } else if (weather == string_consts::SV_SQUOTE) {
+            promptFlags.setWeatherType(PromptWeatherEnum::RAIN);
+        } else if (weather == string_consts::SV_DQUOTE) {
+            promptFlags.setWeatherType(PromptWeatherEnum::HEAVY_RAIN);
+        } else if (weather == string_consts::SV_ASTERISK) {
+            promptFlags.setWeatherType(PromptWeatherEnum::SNOW);
+        } else if (weather == string_consts::SV_SPACE) {
+            promptFlags.setWeatherType(PromptWeatherEnum::NICE);
+        } else {
+            qWarning().noquote() << "prompt has unknown weather flag:"
+                                 << mmqt::toQStringUtf8(*weather);
+        }
+        result.weather = true;
+    } else if (obj.isNull("weather")) {
+        if (verbose_debugging) {
+            qInfo().noquote() << "weather null";
+        }
+        promptFlags.setWeatherType(PromptWeatherEnum::NICE);
+        result.weather = true;
+    }
+
+    return result;
+}
@@ -0,0 +1,19 @@
+#pragma once
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "../global/macros.h"
+
+class JsonObjView;
+class PromptFlagsType;
+
+struct NODISCARD GmcpPromptFlagsUpdate final
+{
+    bool fog = false;
+    bool weather = false;
+};
+
+// Applies the "fog", "light" and "weather" fields of a Char.Vitals message to the flags,
+// and reports whether the fog and weather were given (even as null, or as an unknown flag).
+NODISCARD extern GmcpPromptFlagsUpdate applyGmcpPromptFlags(const JsonObjView &obj,
+                                                            PromptFlagsType &promptFlags);
@@ -7,6 +7,7 @@
 #include "abstractparser.h"
 
 #include "../clock/mumeclock.h"
+#include "../global/Charset.h"
 #include "../global/Consts.h"
 #include "../global/LineUtils.h"
 #include "../global/RAII.h"
@@ -235,13 +236,19 @@ void MumeXmlParserBase::parseExits(std::ostream &os)
 // NOTE: This is now fully redundant, since room sanitizer::sanitizeXXX()
 // handles whitespace, removes ansi codes, and converts from Utf8 to ASCII.
 //
-QString normalizeStringCopy(QString string)
+std::string normalizeStringCopy(const std::string_view utf8)
 {
+    std::string string{StringView{utf8}.trim().getStdStringView()};
     // Remove ANSI first, since we don't want Utf8
     // transliterations to accidentally count as ANSI.
     ParserUtils::removeAnsiMarksInPlace(string);
-    mmqt::toAsciiInPlace(string);
-    string.remove(char_consts::C_CARRIAGE_RETURN);
+    if (!charset::isAscii(string)) {
+        std::ostringstream os;
+        charset::conversion::utf8ToAscii(os, string);
+        string = std::move(os).str();
+    }
+    string.erase(std::remove(string.begin(), string.end(), char_consts::C_CARRIAGE_RETURN),
+                 string.end());
     return string;
 }
 
@@ -298,7 +305,7 @@ void ParserCommon::emulateExits(AnsiOstream &os, const CommandEnum move)
 
 void AbstractParser::slot_parseNewUserInput(const TelnetData &data)
 {
-    const auto &line = data.line.getQByteArray();
+    const QByteArray line = data.line.toQByteArray();
     auto parse_and_send = [this, &line]() {
         sendToUser(SendToUserSourceEnum::NoLongerPrompted, "", true);
 
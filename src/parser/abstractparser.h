@@ -37,6 +37,7 @@
 #include <memory>
 #include <ostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <QArgument>
@@ -279,7 +280,7 @@ class NODISCARD_QOBJECT ParserCommon : public QObject
 class MumeXmlParserBase : public ParserCommon
 {
 private:
-    ActionRecordMap m_actionMap;
+    ActionMatcher m_actionMatcher;
 
 protected:
     explicit MumeXmlParserBase(QObject *const parent,
@@ -414,6 +415,7 @@ class NODISCARD_QOBJECT AbstractParser final : public ParserCommon
     void doBackCommand();
     void doConfig(StringView view);
     void doTasksCommand(StringView args);
+    void doPerfCommand(StringView args);
 
     NODISCARD bool isConnected();
     void doConnectToHost();
@@ -480,7 +482,7 @@ public slots:
     void slot_parseNewUserInput(const TelnetData &);
 };
 
-NODISCARD extern QString normalizeStringCopy(QString str);
+NODISCARD extern std::string normalizeStringCopy(std::string_view utf8);
 
 namespace test {
 extern void testAbstractParser();
@@ -2,6 +2,9 @@
 // Copyright (C) 2024 The MMapper Authors
 
 #include "../global/CaseUtils.h"
+#include "../global/JsonView.h"
+#include "../global/PerfStats.h"
+#include "../global/TextUtils.h"
 #include "../group/mmapper2group.h"
 #include "../map/ExitsFlags.h"
 #include "../map/ParseTree.h"
@@ -10,10 +13,12 @@
 #include "../map/parseevent.h"
 #include "../mapdata/mapdata.h"
 #include "../proxy/GmcpMessage.h"
+#include "GmcpPromptFlags.h"
 #include "abstractparser.h"
 #include "mumexmlparser.h"
 
 #include <optional>
+#include <string_view>
 #include <utility>
 
 #include <QByteArray>
@@ -25,11 +30,19 @@ static volatile bool verbose_debugging = IS_DEBUG_BUILD;
 
 void MumeXmlParser::slot_parseGmcpInput(const GmcpMessage &msg)
 {
-    if (!msg.getJsonDocument().has_value()) {
+    DECL_PERF_TIMER(t, MudParse);
+
+    // Most messages aren't for us, so don't even look at the payload until we know.
+    if (!(msg.isCharStatusVars() || msg.isCharVitals() || msg.isEventMoved()
+          || msg.isRoomInfo())) {
         return;
     }
 
-    auto pObj = msg.getJsonDocument()->getObject();
+    const auto optView = msg.getJsonView();
+    if (!optView) {
+        return;
+    }
+    const auto pObj = optView->getObject();
     if (!pObj) {
         return;
     }
@@ -46,12 +59,12 @@ void MumeXmlParser::slot_parseGmcpInput(const GmcpMessage &msg)
     }
 }
 
-void MumeXmlParser::parseGmcpStatusVars(const JsonObj &obj)
+void MumeXmlParser::parseGmcpStatusVars(const JsonObjView &obj)
 {
     // "Char.StatusVars {\"race\":\"Troll\",\"subrace\":\"Cave Troll\"}"
     if (auto race = obj.getString("race")) {
         auto &trollExitMapping = m_commonData.trollExitMapping;
-        trollExitMapping = areEqualAsLowerUtf8(race->toUtf8().toStdString(), "Troll");
+        trollExitMapping = areEqualAsLowerUtf8(*race, "Troll");
         log("Parser",
             QString("%1 troll exit mapping").arg(trollExitMapping ? "Enabling" : "Disabling"));
     }
@@ -59,11 +72,11 @@ void MumeXmlParser::parseGmcpStatusVars(const JsonObj &obj)
 
 namespace mume_xml_parser_gmcp_detail {
 
-NODISCARD static CommandEnum getMove(const JsonObj &obj)
+NODISCARD static CommandEnum getMove(const JsonObjView &obj)
 {
     if (auto dir = obj.getString("dir")) {
         if (verbose_debugging) {
-            qInfo().noquote() << "MOVED" << *dir;
+            qInfo().noquote() << "MOVED" << mmqt::toQStringUtf8(*dir);
         }
         if (dir == "north") {
             return CommandEnum::NORTH;
@@ -80,7 +93,7 @@ NODISCARD static CommandEnum getMove(const JsonObj &obj)
         } else if (dir == "none") {
             return CommandEnum::NONE;
         } else {
-            qWarning().noquote() << "unknown movement direction:" << *dir;
+            qWarning().noquote() << "unknown movement direction:" << mmqt::toQStringUtf8(*dir);
             return CommandEnum::UNKNOWN;
         }
     }
@@ -91,25 +104,23 @@ NODISCARD static CommandEnum getMove(const JsonObj &obj)
     return CommandEnum::UNKNOWN;
 }
 
-NODISCARD static RoomTerrainEnum getTerrain(const JsonObj &obj)
+NODISCARD static RoomTerrainEnum getTerrain(const JsonObjView &obj)
 {
     const auto pEnv = obj.getString("environment");
     if (!pEnv) {
         return RoomTerrainEnum::UNDEFINED;
     }
 
-    auto &env = *pEnv;
+    const std::string &env = *pEnv;
     if (env == "building") {
         return RoomTerrainEnum::INDOORS;
     } else if (env == "shallows") {
         return RoomTerrainEnum::SHALLOW;
     }
 
-    const std::string s = mmqt::toStdStringUtf8(env);
-
     do {
 #define X_CASE(x) \
-    if (areEqualAsLowerUtf8(#x, s)) { \
+    if (areEqualAsLowerUtf8(#x, env)) { \
         return RoomTerrainEnum::x; \
     }
         XFOREACH_RoomTerrainEnum(X_CASE)
@@ -117,11 +128,11 @@ NODISCARD static RoomTerrainEnum getTerrain(const JsonObj &obj)
     } while (false);
 
     //
-    qWarning() << "Unknown room terrain" << env;
+    qWarning() << "Unknown room terrain" << mmqt::toQStringUtf8(env);
     return RoomTerrainEnum::UNDEFINED;
 }
 
-NODISCARD static ServerRoomId asServerId(const JsonInt room)
+NODISCARD static ServerRoomId asServerId(const int32_t room)
 {
     // CAUTION: static analysis is wrong here, because room is a signed integer,
     // so (room < 1) can happen.
@@ -129,48 +140,48 @@ NODISCARD static ServerRoomId asServerId(const JsonInt room)
     return (room < 1) ? INVALID_SERVER_ROOMID : ServerRoomId{static_cast<uint32_t>(room)};
 }
 
-NODISCARD static ServerRoomId getServerId(const JsonObj &obj)
+NODISCARD static ServerRoomId getServerId(const JsonObjView &obj)
 {
     const auto optRoom = obj.getInt("id");
     if (!optRoom) {
         return INVALID_SERVER_ROOMID;
     }
-    const JsonInt &room = *optRoom;
+    const int32_t room = *optRoom;
     if (verbose_debugging) {
         qInfo().noquote() << "ID:" << room;
     }
     return asServerId(room);
 }
 
-NODISCARD static RoomArea getRoomArea(const JsonObj &obj)
+NODISCARD static RoomArea getRoomArea(const JsonObjView &obj)
 {
     if (auto area = obj.getString("area")) {
         if (verbose_debugging) {
-            qInfo().noquote() << "Area:" << *area;
+            qInfo().noquote() << "Area:" << mmqt::toQStringUtf8(*area);
         }
-        return mmqt::makeRoomArea(*area);
+        return makeRoomArea(std::move(*area));
     }
     return RoomArea{};
 }
 
-NODISCARD static RoomName getRoomName(const JsonObj &obj)
+NODISCARD static RoomName getRoomName(const JsonObjView &obj)
 {
     if (auto name = obj.getString("name")) { // can be null
         if (verbose_debugging) {
-            qInfo().noquote() << "Name:" << *name;
+            qInfo().noquote() << "Name:" << mmqt::toQStringUtf8(*name);
         }
-        return mmqt::makeRoomName(*name);
+        return makeRoomName(std::move(*name));
     }
     return RoomName{};
 }
 
-NODISCARD static RoomDesc getRoomDesc(const JsonObj &obj)
+NODISCARD static RoomDesc getRoomDesc(const JsonObjView &obj)
 {
     if (auto desc = obj.getString("desc")) {
         if (verbose_debugging) {
-            qInfo() << "Desc:" << *desc;
+            qInfo() << "Desc:" << mmqt::toQStringUtf8(*desc);
         }
-        return mmqt::makeRoomDesc(*desc);
+        return makeRoomDesc(std::move(*desc));
     }
     return RoomDesc{};
 }
@@ -185,7 +196,7 @@ struct NODISCARD Misc final
     ServerExitIds exitIds{};
 };
 
-static void processOneFlag(const QString &flag,
+static void processOneFlag(const std::string_view flag,
                            const ExitDirEnum d,
                            RawExit &exit,
                            ConnectedRoomFlagsType &connectedRoomFlags,
@@ -207,11 +218,11 @@ static void processOneFlag(const QString &flag,
         // TODO: Not useful as of now
     } else {
         const char dir[2] = {lowercaseDirection(d)[0], char_consts::C_NUL};
-        qWarning().noquote() << "exit" << dir << "has unknown flag:" << flag;
+        qWarning().noquote() << "exit" << dir << "has unknown flag:" << mmqt::toQStringUtf8(flag);
     }
 }
 
-NODISCARD static Misc getMisc(const JsonObj &obj, const ServerRoomId room, bool isTrollMode)
+NODISCARD static Misc getMisc(const JsonObjView &obj, const ServerRoomId room, bool isTrollMode)
 {
     auto exits = obj.getObject("exits");
     if (!exits) {
@@ -229,10 +240,10 @@ NODISCARD static Misc getMisc(const JsonObj &obj, const ServerRoomId room, bool
         RawExit &currentExit = result.exits[d];
         currentExit.addExitFlags(ExitFlagEnum::EXIT);
 
-        const JsonObj &exit = *optExit;
+        const JsonObjView &exit = *optExit;
         const auto optTo = exit.getInt("id");
         if (room != INVALID_SERVER_ROOMID && optTo) {
-            const JsonInt &to = *optTo;
+            const int32_t to = *optTo;
             if (verbose_debugging) {
                 qInfo().noquote() << "EXIT from" << room.asUint32() << dir << "to"
                                   << asServerId(to).asUint32();
@@ -242,14 +253,14 @@ NODISCARD static Misc getMisc(const JsonObj &obj, const ServerRoomId room, bool
             // currentExit.getOutgoingSet().insert(asServerId(to));
         }
 
-        const auto optDoorName = exit.getString("name");
+        auto optDoorName = exit.getString("name");
         if (optDoorName) {
-            const QString &doorName = *optDoorName;
+            std::string &doorName = *optDoorName;
             if (verbose_debugging) {
-                qInfo().noquote() << "exit" << dir << "name:" << doorName;
+                qInfo().noquote() << "exit" << dir << "name:" << mmqt::toQStringUtf8(doorName);
             }
             currentExit.addExitFlags(ExitFlagEnum::DOOR);
-            currentExit.setDoorName(mmqt::makeDoorName(doorName));
+            currentExit.setDoorName(makeDoorName(std::move(doorName)));
             auto &currentDoor = result.doors.at(d);
             currentDoor = Misc::DoorStateEnum::OPEN;
         }
@@ -259,9 +270,9 @@ NODISCARD static Misc getMisc(const JsonObj &obj, const ServerRoomId room, bool
             continue;
         }
 
-        for (const JsonValue &pflag : *optFlags) {
+        for (const JsonValueView &pflag : *optFlags) {
             if (auto optString = pflag.getString()) {
-                const QString flag = optString.value();
+                const std::string &flag = optString.value();
                 processOneFlag(flag, d, currentExit, result.connectedRoomFlags, result.doors.at(d));
             }
         }
@@ -295,77 +306,22 @@ NODISCARD static Misc getMisc(const JsonObj &obj, const ServerRoomId room, bool
 
 } // namespace mume_xml_parser_gmcp_detail
 
-void MumeXmlParser::parseGmcpCharVitals(const JsonObj &obj)
+void MumeXmlParser::parseGmcpCharVitals(const JsonObjView &obj)
 {
     auto &promptFlags = m_commonData.promptFlags;
-    using namespace mume_xml_parser_gmcp_detail;
 
     promptFlags.setValid();
 
-    if (auto fog = obj.getString("fog")) {
-        if (verbose_debugging) {
-            qInfo().noquote() << "fog" << *fog;
-        }
-        if (fog == mmqt::QS_MINUS_SIGN) {
-            promptFlags.setFogType(PromptFogEnum::LIGHT_FOG);
-        } else if (fog == mmqt::QS_EQUALS) {
-            promptFlags.setFogType(PromptFogEnum::HEAVY_FOG);
-        } else {
-            qWarning().noquote() << "prompt has unknown fog flag:" << *fog;
-        }
-        m_observer.observeFog(promptFlags.getFogType());
-    } else if (obj.getNull("fog")) {
-        if (verbose_debugging) {
-            qInfo().noquote() << "fog null";
-        }
-        promptFlags.setFogType(PromptFogEnum::NO_FOG);
+    const auto updated = applyGmcpPromptFlags(obj, promptFlags);
+    if (updated.fog) {
         m_observer.observeFog(promptFlags.getFogType());
     }
-
-    if (auto light = obj.getString("light")) {
-        if (verbose_debugging) {
-            qInfo().noquote() << "light" << *light;
-        }
-        if (light == mmqt::QS_ASTERISK           // indoor/sun (direct and indirect)
-            || light == mmqt::QS_CLOSE_PARENS) { // moon (direct and indirect)
-            promptFlags.setLit();
-        } else if (light == "o") { // darkness (magical, night, or permanent)
-            promptFlags.setDark();
-        } else if (light == mmqt::QS_EXCLAMATION) { // artifical light
-            promptFlags.setArtificial();
-        } else {
-            qWarning().noquote() << "prompt has unknown light flag:" << *light;
-        }
-    }
-
-    if (auto weather = obj.getString("weather")) {
-        if (verbose_debugging) {
-            qInfo().noquote() << "weather" << *weather;
-        }
-        if (weather == mmqt::QS_TILDE) {
-            promptFlags.setWeatherType(PromptWeatherEnum::CLOUDS);
-        } else if (weather == mmqt::QS_SQUOTE) {
-            promptFlags.setWeatherType(PromptWeatherEnum::RAIN);
-        } else if (weather == mmqt::QS_DQUOTE) {
-            promptFlags.setWeatherType(PromptWeatherEnum::HEAVY_RAIN);
-        } else if (weather == mmqt::QS_ASTERISK) {
-            promptFlags.setWeatherType(PromptWeatherEnum::SNOW);
-        } else if (weather == mmqt::QS_SPACE) {
-            promptFlags.setWeatherType(PromptWeatherEnum::NICE);
-        } else {
-            qWarning().noquote() << "prompt has unknown weather flag:" << *weather;
-        }
-        m_observer.observeWeather(promptFlags.getWeatherType());
-    } else if (obj.getNull("weather")) {
-        if (verbose_debugging) {
-            qInfo().noquote() << "weather null";
-        }
-        promptFlags.setWeatherType(PromptWeatherEnum::NICE);
+    if (updated.weather) {
         m_observer.observeWeather(promptFlags.getWeatherType());
     }
 }
 
-void MumeXmlParser::parseGmcpEventMoved(const JsonObj &obj)
+void MumeXmlParser::parseGmcpEventMoved(const JsonObjView &obj)
 {
     // In-game falls do not send a prompt, so we check if an event is ready to fire
     if (m_eventReady) {
@@ -376,7 +332,7 @@ void MumeXmlParser::parseGmcpEventMoved(const JsonObj &obj)
     setMove(move);
 }
 
-void MumeXmlParser::parseGmcpRoomInfo(const JsonObj &obj)
+void MumeXmlParser::parseGmcpRoomInfo(const JsonObjView &obj)
 {
     using namespace mume_xml_parser_gmcp_detail;
     m_serverId = getServerId(obj);
@@ -8,6 +8,7 @@
 #include "../configuration/configuration.h"
 #include "../global/AnsiOstream.h"
 #include "../global/Consts.h"
+#include "../global/PerfStats.h"
 #include "../global/PrintUtils.h"
 #include "../global/TextUtils.h"
 #include "../global/entities.h"
@@ -41,23 +42,6 @@ namespace { // anonymous
 const QString nullString{};
 const QByteArray emptyByteArray{""};
 
-void decodeXmlEntities(QString &s)
-{
-    s = entities::decode(entities::EncodedString{s});
-}
-
-void appendCodepoint(QString &qs, char32_t c)
-{
-    if ((false)) {
-        qs += QString::fromStdU32String(std::u32string{c, 1});
-    } else {
-        charset::conversion::Utf16StringBuilder builder;
-        builder += c;
-        auto sv = builder.get_string_view();
-        qs += QStringView{sv.data(), static_cast<int>(sv.size())};
-    }
-}
-
 } // namespace
 
 MumeXmlParser::MumeXmlParser(MapData &md,
@@ -78,10 +62,12 @@ MumeXmlParser::~MumeXmlParser() = default;
 
 void MumeXmlParser::slot_parseNewMudInput(const TelnetData &data)
 {
+    DECL_PERF_TIMER(t, MudParse);
+
     const bool isPromptOrTwiddlers = data.type == TelnetDataEnum::Prompt
                                      || data.type == TelnetDataEnum::Backspace;
     if (isPromptOrTwiddlers) {
-        m_commonData.lastPrompt = QString::fromUtf8(data.line.getQByteArray());
+        m_commonData.lastPrompt = QString::fromUtf8(data.line.getQByteArrayView());
     }
     parse(data, isPromptOrTwiddlers);
 }
@@ -89,54 +75,77 @@ void MumeXmlParser::slot_parseNewMudInput(const TelnetData &data)
 void MumeXmlParser::parse(const TelnetData &data, const bool isGoAhead)
 {
     m_lineToUser.clear();
+    m_lineToUserView = {};
     m_lineFlags.remove(LineFlagEnum::NONE);
 
-    std::string_view utf8 = mmqt::toStdStringViewRaw(data.line.getQByteArray());
-    charset::foreach_codepoint_utf8(utf8, [this](const char32_t c) {
-        if (m_readingTag) {
-            if (c == char_consts::C_GREATER_THAN) {
-                // send tag
-                if (!m_tempTag.isEmpty()) {
-                    std::ignore = element(m_tempTag);
-                }
+    // '<' and '>' are ASCII, so they can't appear inside a multi-byte UTF-8 sequence;
+    // each run of text or tag is found with a single search. Text runs never span lines,
+    // so they're handed on as views of the received line instead of being copied.
+    std::string_view utf8 = data.line.getStdStringView();
+    while (!utf8.empty()) {
+        const size_t pos = utf8.find(m_readingTag ? C_GREATER_THAN : C_LESS_THAN);
+        const auto run = utf8.substr(0, pos);
 
-                m_tempTag.clear();
+        if (m_readingTag) {
+            m_tempTag += run;
+            if (pos == std::string_view::npos) {
+                break;
+            }
 
-                m_readingTag = false;
-                return;
+            // send tag
+            if (!m_tempTag.empty()) {
+                std::ignore = element(m_tempTag);
             }
-            appendCodepoint(m_tempTag, c);
+            m_tempTag.clear();
+            m_readingTag = false;
 
         } else {
-            if (c == char_consts::C_LESS_THAN) {
-                m_lineToUser.append(characters(m_tempCharacters));
-                m_tempCharacters.clear();
-
-                m_readingTag = true;
-                return;
+            characters(run);
+            if (pos == std::string_view::npos) {
+                break;
             }
-            appendCodepoint(m_tempCharacters, c);
+            m_readingTag = true;
         }
-    });
-
-    if (!m_readingTag) {
-        m_lineToUser.append(characters(m_tempCharacters));
-        m_tempCharacters.clear();
+        utf8.remove_prefix(pos + 1);
     }
-    if (!m_lineToUser.isEmpty()) {
-        sendToUser(SendToUserSourceEnum::FromMud, m_lineToUser, isGoAhead);
+
+    const std::string_view toUser = getLineToUser();
+    if (!toUser.empty()) {
+        sendToUser(SendToUserSourceEnum::FromMud, mmqt::toQStringUtf8(toUser), isGoAhead);
 
         // Simplify the output and run actions
-        QString tempStr = m_lineToUser;
-        tempStr = normalizeStringCopy(tempStr.trimmed());
-        parseMudCommands(tempStr);
+        parseMudCommands(toUser);
     }
 }
 
-bool MumeXmlParser::element(const QString &line)
+void MumeXmlParser::appendToUser(const std::string_view utf8, const bool isViewOfLine)
+{
+    if (utf8.empty()) {
+        return;
+    }
+    if (isViewOfLine && m_lineToUser.empty() && m_lineToUserView.empty()) {
+        m_lineToUserView = utf8;
+        return;
+    }
+    if (!m_lineToUserView.empty()) {
+        m_lineToUser.assign(m_lineToUserView);
+        m_lineToUserView = {};
+    }
+    m_lineToUser += utf8;
+}
+
+std::string_view MumeXmlParser::getLineToUser() const
+{
+    if (!m_lineToUserView.empty()) {
+        return m_lineToUserView;
+    }
+    return m_lineToUser;
+}
+
+bool MumeXmlParser::element(const std::string_view line)
 {
     using namespace char_consts;
-    const auto length = line.length();
+    const auto length = line.size();
 
     using Attributes = std::list<std::pair<std::string, std::string>>;
     // REVISIT: Merge this logic with the state machine in parse()
@@ -155,12 +164,7 @@ bool MumeXmlParser::element(const QString &line)
             os.str(std::string());
             state = XmlAttributeStateEnum::ATTRIBUTE;
         };
-        for (const QChar qc : line) {
-            if (qc.unicode() >= 256) {
-                continue;
-            }
-            const char c = mmqt::toLatin1(qc);
-
+        for (const char c : line) {
             switch (state) {
             case XmlAttributeStateEnum::ELEMENT:
                 if (ascii::isSpace(c)) {
@@ -225,19 +229,19 @@ bool MumeXmlParser::element(const QString &line)
     switch (m_xmlMode) {
     case XmlModeEnum::NONE:
         if (length > 0) {
-            switch (line.front().unicode()) {
+            switch (line.front()) {
             case C_SLASH:
-                if (line.startsWith("/snoop")) {
+                if (line.starts_with("/snoop")) {
                     m_lineFlags.remove(LineFlagEnum::SNOOP);
 
-                } else if (line.startsWith("/status")) {
+                } else if (line.starts_with("/status")) {
                     m_lineFlags.remove(LineFlagEnum::STATUS);
 
-                } else if (line.startsWith("/weather")) {
+                } else if (line.starts_with("/weather")) {
                     m_lineFlags.remove(LineFlagEnum::WEATHER);
                     // Certain weather events happen on ticks
 
-                } else if (line.startsWith("/xml")) {
+                } else if (line.starts_with("/xml")) {
                     sendToUser(SendToUserSourceEnum::FromMMapper,
                                "[MMapper] Mapper cannot function without XML mode\n");
                     getQueue().clear();
@@ -245,14 +249,14 @@ bool MumeXmlParser::element(const QString &line)
                 }
                 break;
             case 'p':
-                if (line.startsWith("prompt")) {
+                if (line.starts_with("prompt")) {
                     m_xmlMode = XmlModeEnum::PROMPT;
                     m_lineFlags.insert(LineFlagEnum::PROMPT);
                     m_commonData.lastPrompt = emptyByteArray;
                 }
                 break;
             case 'e':
-                if (line.startsWith("exits")) {
+                if (line.starts_with("exits")) {
                     m_commonData.exits
                         = nullString; // Reset string since payload can be from the 'exit' command
                     m_xmlMode = XmlModeEnum::EXITS;
@@ -260,28 +264,28 @@ bool MumeXmlParser::element(const QString &line)
                 }
                 break;
             case 'r':
-                if (line.startsWith("room")) {
+                if (line.starts_with("room")) {
                     m_xmlMode = XmlModeEnum::ROOM;
                     m_lineFlags.insert(LineFlagEnum::ROOM);
                     if (!m_lineFlags.isSnoop()) {
                         m_descriptionReady = false;
                         m_exitsReady = false;
                         m_commonData.exits = nullString;
-                        m_stringBuffer = nullString;
+                        m_stringBuffer.clear();
                         m_commonData.roomContents.reset();
                     }
                 }
                 break;
             case 'w':
-                if (line.startsWith("weather")) {
+                if (line.starts_with("weather")) {
                     m_lineFlags.insert(LineFlagEnum::WEATHER);
                 }
                 break;
             case 's':
-                if (line.startsWith("status")) {
+                if (line.starts_with("status")) {
                     m_lineFlags.insert(LineFlagEnum::STATUS);
 
-                } else if (line.startsWith("snoop")) {
+                } else if (line.starts_with("snoop")) {
                     m_lineFlags.insert(LineFlagEnum::SNOOP);
                 }
                 break;
@@ -291,9 +295,9 @@ bool MumeXmlParser::element(const QString &line)
 
     case XmlModeEnum::ROOM:
         if (length > 0) {
-            switch (line.front().unicode()) {
+            switch (line.front()) {
             case 'e':
-                if (line.startsWith("exits")) {
+                if (line.starts_with("exits")) {
                     m_xmlMode = XmlModeEnum::EXITS;
                     m_lineFlags.insert(LineFlagEnum::EXITS);
                     if (!m_lineFlags.isSnoop()) {
@@ -304,25 +308,25 @@ bool MumeXmlParser::element(const QString &line)
                 }
                 break;
             case 'n':
-                if (line.startsWith("name")) {
+                if (line.starts_with("name")) {
                     m_xmlMode = XmlModeEnum::NAME;
                     m_lineFlags.insert(LineFlagEnum::NAME);
                 }
                 break;
             case 'd':
-                if (line.startsWith("description")) {
+                if (line.starts_with("description")) {
                     m_xmlMode = XmlModeEnum::DESCRIPTION;
                     m_lineFlags.insert(LineFlagEnum::DESCRIPTION);
                 }
                 break;
             case 't': // terrain tag only comes up in blindness or fog
-                if (line.startsWith("terrain")) {
+                if (line.starts_with("terrain")) {
                     m_xmlMode = XmlModeEnum::TERRAIN;
                     m_lineFlags.insert(LineFlagEnum::TERRAIN);
                 }
                 break;
             case 'h': // Gods have an "Obvious exits" header
-                if (line.startsWith("header")) {
+                if (line.starts_with("header")) {
                     m_xmlMode = XmlModeEnum::HEADER;
                     m_lineFlags.insert(LineFlagEnum::HEADER);
                     if (!m_lineFlags.isSnoop()) {
@@ -331,11 +335,11 @@ bool MumeXmlParser::element(const QString &line)
                 }
                 break;
             case C_SLASH:
-                if (line.startsWith("/room")) {
+                if (line.starts_with("/room")) {
                     m_xmlMode = XmlModeEnum::NONE;
                     m_lineFlags.remove(LineFlagEnum::ROOM);
                     if (!m_lineFlags.isSnoop()) {
-                        m_commonData.roomContents = mmqt::makeRoomContents(m_stringBuffer);
+                        m_commonData.roomContents = makeRoomContents(m_stringBuffer);
                         m_descriptionReady = true;
                         if (!m_exitsReady && getConfig().mumeNative.emulatedExits) {
                             m_exitsReady = true;
@@ -353,16 +357,16 @@ bool MumeXmlParser::element(const QString &line)
         }
         break;
     case XmlModeEnum::NAME:
-        if (line.startsWith("/name")) {
+        if (line.starts_with("/name")) {
             m_xmlMode = XmlModeEnum::ROOM;
             m_lineFlags.remove(LineFlagEnum::NAME);
         }
         break;
     case XmlModeEnum::DESCRIPTION:
         if (length > 0) {
-            switch (line.front().unicode()) {
+            switch (line.front()) {
             case C_SLASH:
-                if (line.startsWith("/description")) {
+                if (line.starts_with("/description")) {
                     m_xmlMode = XmlModeEnum::ROOM;
                     m_lineFlags.remove(LineFlagEnum::DESCRIPTION);
                 }
@@ -372,9 +376,9 @@ bool MumeXmlParser::element(const QString &line)
         break;
     case XmlModeEnum::EXITS:
         if (length > 0) {
-            switch (line.front().unicode()) {
+            switch (line.front()) {
             case C_SLASH:
-                if (line.startsWith("/exits")) {
+                if (line.starts_with("/exits")) {
                     if (!m_lineFlags.isSnoop()) {
                         std::ostringstream os;
                         parseExits(os);
@@ -391,9 +395,9 @@ bool MumeXmlParser::element(const QString &line)
         break;
     case XmlModeEnum::PROMPT:
         if (length > 0) {
-            switch (line.front().unicode()) {
+            switch (line.front()) {
             case C_SLASH:
-                if (line.startsWith("/prompt")) {
+                if (line.starts_with("/prompt")) {
                     m_xmlMode = XmlModeEnum::NONE;
                     m_lineFlags.remove(LineFlagEnum::PROMPT);
                     m_commonData.overrideSendPrompt = false;
@@ -408,9 +412,9 @@ bool MumeXmlParser::element(const QString &line)
         break;
     case XmlModeEnum::TERRAIN:
         if (length > 0) {
-            switch (line.front().unicode()) {
+            switch (line.front()) {
             case C_SLASH:
-                if (line.startsWith("/terrain")) {
+                if (line.starts_with("/terrain")) {
                     m_xmlMode = XmlModeEnum::ROOM;
                     m_lineFlags.remove(LineFlagEnum::TERRAIN);
                 }
@@ -420,9 +424,9 @@ bool MumeXmlParser::element(const QString &line)
         break;
     case XmlModeEnum::HEADER:
         if (length > 0) {
-            switch (line.front().unicode()) {
+            switch (line.front()) {
             case C_SLASH:
-                if (line.startsWith("/header")) {
+                if (line.starts_with("/header")) {
                     m_xmlMode = XmlModeEnum::ROOM;
                     m_lineFlags.remove(LineFlagEnum::HEADER);
                 }
@@ -435,18 +439,24 @@ bool MumeXmlParser::element(const QString &line)
     return true;
 }
 
-QString MumeXmlParser::characters(QString &ch)
+void MumeXmlParser::characters(const std::string_view run)
 {
-    if (ch.isEmpty()) {
-        return ch;
+    if (run.empty()) {
+        return;
     }
 
-    // replace > and < chars
-    decodeXmlEntities(ch);
+    // replace > and < chars; most runs have no entities and are used as they are.
+    std::string_view ch = run;
+    const bool isViewOfLine = run.find(char_consts::C_AMPERSAND) == std::string_view::npos;
+    if (!isViewOfLine) {
+        m_decodedCharacters.assign(run);
+        entities::decodeUtf8InPlace(m_decodedCharacters);
+        ch = m_decodedCharacters;
+    }
 
     const auto &config = getConfig();
 
-    QString toUser;
+    const auto addToUser = [this, &ch, isViewOfLine]() { appendToUser(ch, isViewOfLine); };
 
     const XmlModeEnum mode = std::invoke([this]() -> XmlModeEnum {
         if (m_lineFlags.isPrompt()) {
@@ -465,7 +475,7 @@ QString MumeXmlParser::characters(QString &ch)
 
     switch (mode) {
     case XmlModeEnum::NONE: // non room info
-        if (ch.isEmpty()) { // standard end of description parsed
+        if (ch.empty()) { // standard end of description parsed
             if (m_descriptionReady && !m_exitsReady && config.mumeNative.emulatedExits
                 && !m_lineFlags.isSnoop()) {
                 m_exitsReady = true;
@@ -478,7 +488,7 @@ QString MumeXmlParser::characters(QString &ch)
             }
         } else {
             m_lineFlags.insert(LineFlagEnum::NONE);
-            toUser.append(ch);
+            addToUser();
         }
         break;
 
@@ -487,39 +497,37 @@ QString MumeXmlParser::characters(QString &ch)
             // REVISIT: Ask a Vala to build GMCP Room.Objects so we can use that and Room.Chars
             m_stringBuffer += ch;
         }
-        toUser.append(ch);
+        addToUser();
         break;
 
     case XmlModeEnum::NAME:
-        toUser.append(ch);
+        addToUser();
         break;
 
     case XmlModeEnum::DESCRIPTION: // static line
-        toUser.append(ch);
+        addToUser();
         break;
 
     case XmlModeEnum::EXITS:
         if (m_lineFlags.isSnoop()) {
-            toUser.append(ch);
+            addToUser();
         } else {
-            m_commonData.exits += ch;
+            m_commonData.exits += mmqt::toQStringUtf8(ch);
         }
         break;
 
     case XmlModeEnum::PROMPT:
         // Store prompts in case an internal command is executed
-        m_commonData.lastPrompt += ch;
-        toUser.append(ch);
+        m_commonData.lastPrompt += mmqt::toQStringUtf8(ch);
+        addToUser();
         break;
 
     case XmlModeEnum::HEADER:
     case XmlModeEnum::TERRAIN:
     default:
-        toUser.append(ch);
+        addToUser();
         break;
     }
-
-    return toUser;
 }
 
 void MumeXmlParser::setMove(const CommandEnum move)
@@ -570,11 +578,11 @@ void MumeXmlParser::move()
     setMove(CommandEnum::LOOK);
 }
 
-void MumeXmlParser::parseMudCommands(const QString &str)
+void MumeXmlParser::parseMudCommands(const std::string_view utf8)
 {
     // REVISIT: Add XML tag-based actions that match on a given LineFlag
-    const auto stdString = mmqt::toStdStringUtf8(str);
-    if (evalActionMap(StringView{stdString})) {
+    const auto normalized = normalizeStringCopy(utf8);
+    if (evalActionMap(StringView{normalized})) {
         return;
     }
 }
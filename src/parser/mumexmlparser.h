@@ -13,6 +13,7 @@
 #include "abstractparser.h"
 
 #include <optional>
+#include <string>
 #include <string_view>
 
 #include <QByteArray>
@@ -22,7 +23,7 @@
 #include <QtGlobal>
 class GmcpMessage;
 class GroupManagerApi;
-class JsonObj;
+class JsonObjView;
 class MapData;
 class MumeClock;
 class ProxyParserApi;
@@ -48,10 +49,15 @@ class NODISCARD_QOBJECT MumeXmlParser final : public MumeXmlParserBase
 private:
     XmlModeEnum m_xmlMode = XmlModeEnum::NONE;
     LineFlags m_lineFlags{};
-    QString m_lineToUser;
-    QString m_tempCharacters;
-    QString m_tempTag;
-    QString m_stringBuffer;
+    // UTF-8; only turned into a QString when it's sent to the user.
+    // While the line's text for the user is a single undecoded run, it stays a view of the
+    // received line (m_lineToUserView), and is only copied once more text has to be added.
+    std::string m_lineToUser;
+    std::string_view m_lineToUserView;
+    // Scratch buffer for text runs that contain entities.
+    std::string m_decodedCharacters;
+    std::string m_tempTag;
+    std::string m_stringBuffer;
     CommandEnum m_move = CommandEnum::NONE;
     ServerRoomId m_serverId = INVALID_SERVER_ROOMID;
     bool m_readingTag = false;
@@ -97,13 +103,15 @@ class NODISCARD_QOBJECT MumeXmlParser final : public MumeXmlParserBase
     void slot_parseGmcpInput(const GmcpMessage &msg);
 
 private:
-    void parseMudCommands(const QString &str);
-    NODISCARD QString characters(QString &ch);
-    NODISCARD bool element(const QString &);
+    void parseMudCommands(std::string_view utf8);
+    void characters(std::string_view run);
+    void appendToUser(std::string_view utf8, bool isViewOfLine);
+    NODISCARD std::string_view getLineToUser() const;
+    NODISCARD bool element(std::string_view);
     void setMove(CommandEnum dir);
     void move();
-    void parseGmcpStatusVars(const JsonObj &obj);
-    void parseGmcpCharVitals(const JsonObj &obj);
-    void parseGmcpEventMoved(const JsonObj &obj);
-    void parseGmcpRoomInfo(const JsonObj &obj);
+    void parseGmcpStatusVars(const JsonObjView &obj);
+    void parseGmcpCharVitals(const JsonObjView &obj);
+    void parseGmcpEventMoved(const JsonObjView &obj);
+    void parseGmcpRoomInfo(const JsonObjView &obj);
 };
@@ -0,0 +1,333 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "ParseEventLog.h"
+
+#include "../map/CommandId.h"
+#include "../map/ConnectedRoomFlags.h"
+#include "../map/DoorFlags.h"
+#include "../map/ExitDirection.h"
+#include "../map/ExitFlags.h"
+#include "../map/PromptFlags.h"
+#include "../map/mmapper2room.h"
+
+#include <charconv>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+namespace parse_event_log {
+
+namespace { // anonymous
+
+constexpr const char *const HEADER = "# MMapper parse event log v1";
+constexpr char SEP = '\t';
+
+// move, server id, terrain, prompt flags, connected room flags,
+// area, name, desc, contents,
+// (exit flags, door flags, door name, exit id) x NUM_EXITS,
+// state, room
+constexpr size_t NUM_FIELDS = 9 + 4 * NUM_EXITS + 2;
+
+void writeEscaped(std::ostream &os, const std::string_view sv)
+{
+    for (const char c : sv) {
+        switch (c) {
+        case '\\':
+            os << "\\\\";
+            break;
+        case '\t':
+            os << "\\t";
+            break;
+        case '\n':
+            os << "\\n";
+            break;
+        case '\r':
+            os << "\\r";
+            break;
+        default:
+            os << c;
+            break;
+        }
+    }
+}
+
+NODISCARD std::string unescape(const std::string_view sv)
+{
+    std::string result;
+    result.reserve(sv.size());
+    for (size_t i = 0; i < sv.size(); ++i) {
+        const char c = sv[i];
+        if (c != '\\') {
+            result += c;
+            continue;
+        }
+        if (++i == sv.size()) {
+            throw std::runtime_error("dangling escape");
+        }
+        switch (sv[i]) {
+        case '\\':
+            result += '\\';
+            break;
+        case 't':
+            result += '\t';
+            break;
+        case 'n':
+            result += '\n';
+            break;
+        case 'r':
+            result += '\r';
+            break;
+        default:
+            throw std::runtime_error("invalid escape");
+        }
+    }
+    return result;
+}
+
+NODISCARD uint32_t parseUint(const std::string_view sv)
+{
+    uint32_t result = 0;
+    const auto *const end = sv.data() + sv.size();
+    const auto [ptr, ec] = std::from_chars(sv.data(), end, result);
+    if (ec != std::errc{} || ptr != end) {
+        throw std::runtime_error("invalid number");
+    }
+    return result;
+}
+
+NODISCARD uint32_t encodeConnectedRoomFlags(const ConnectedRoomFlagsType flags)
+{
+    uint32_t result = 0;
+    if (flags.isValid()) {
+        result |= CONNECTED_ROOM_FLAGS_VALID;
+    }
+    if (flags.isTrollMode()) {
+        result |= CONNECTED_ROOM_FLAGS_TROLL_MODE;
+    }
+    for (const ExitDirEnum dir : ALL_EXITS_NESWUD) {
+        const auto shift = static_cast<uint32_t>(dir) * 2u;
+        result |= enums::to_underlying(flags.getDirectSunlight(dir)) << shift;
+    }
+    return result;
+}
+
+NODISCARD ConnectedRoomFlagsType decodeConnectedRoomFlags(const uint32_t raw)
+{
+    ConnectedRoomFlagsType result;
+    if ((raw & CONNECTED_ROOM_FLAGS_VALID) != 0u) {
+        result.setValid();
+    }
+    if ((raw & CONNECTED_ROOM_FLAGS_TROLL_MODE) != 0u) {
+        result.setTrollMode();
+    }
+    for (const ExitDirEnum dir : ALL_EXITS_NESWUD) {
+        const auto shift = static_cast<uint32_t>(dir) * 2u;
+        result.setDirectSunlight(dir, static_cast<DirectSunlightEnum>((raw >> shift) & 3u));
+    }
+    return result;
+}
+
+NODISCARD PromptFlagsType decodePromptFlags(const uint32_t raw)
+{
+    PromptFlagsType result;
+    if ((raw & PromptFlagsType::PROMPT_FLAGS_VALID) != 0u) {
+        result.setValid();
+    }
+    result.setFogType(static_cast<PromptFogEnum>((raw & PromptFlagsType::FOG_TYPE)
+                                                 >> PromptFlagsType::FOG_SHIFT));
+    result.setWeatherType(static_cast<PromptWeatherEnum>((raw & PromptFlagsType::WEATHER_TYPE)
+                                                         >> PromptFlagsType::WEATHER_SHIFT));
+    if ((raw & PromptFlagsType::LIT_ROOM) != 0u) {
+        result.setLit();
+    } else if ((raw & PromptFlagsType::DARK_ROOM) != 0u) {
+        result.setDark();
+    }
+    return result;
+}
+
+NODISCARD PathStateEnum decodeState(const uint32_t raw)
+{
+    switch (static_cast<PathStateEnum>(raw)) {
+    case PathStateEnum::APPROVED:
+    case PathStateEnum::EXPERIMENTING:
+    case PathStateEnum::SYNCING:
+        return static_cast<PathStateEnum>(raw);
+    }
+    throw std::runtime_error("invalid path state");
+}
+
+NODISCARD std::vector<std::string_view> split(const std::string_view line)
+{
+    std::vector<std::string_view> fields;
+    fields.reserve(NUM_FIELDS);
+    size_t begin = 0;
+    while (true) {
+        const auto end = line.find(SEP, begin);
+        if (end == std::string_view::npos) {
+            fields.emplace_back(line.substr(begin));
+            break;
+        }
+        fields.emplace_back(line.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    return fields;
+}
+
+NODISCARD Entry parseLine(const std::string_view line)
+{
+    const auto fields = split(line);
+    if (fields.size() != NUM_FIELDS) {
+        throw std::runtime_error("wrong number of fields");
+    }
+
+    size_t i = 0;
+    auto nextUint = [&fields, &i]() -> uint32_t { return parseUint(fields[i++]); };
+    auto nextString = [&fields, &i]() -> std::string { return unescape(fields[i++]); };
+
+    const auto move = nextUint();
+    if (move > static_cast<uint32_t>(CommandEnum::NONE)) {
+        throw std::runtime_error("invalid move type");
+    }
+    const ServerRoomId serverId{nextUint()};
+    const auto terrain = nextUint();
+    if (terrain >= NUM_ROOM_TERRAIN_TYPES) {
+        throw std::runtime_error("invalid terrain");
+    }
+    const auto promptFlags = decodePromptFlags(nextUint());
+    const auto connectedRoomFlags = decodeConnectedRoomFlags(nextUint());
+
+    RoomArea area{nextString()};
+    RoomName name{nextString()};
+    RoomDesc desc{nextString()};
+    RoomContents contents{nextString()};
+
+    RawExits exits;
+    ServerExitIds exitIds;
+    for (const ExitDirEnum dir : ALL_EXITS7) {
+        auto &ex = exits[dir];
+        ex.setExitFlags(ExitFlags{static_cast<ExitFlags::bitmask_type>(nextUint())});
+        ex.setDoorFlags(DoorFlags{static_cast<DoorFlags::bitmask_type>(nextUint())});
+        ex.setDoorName(DoorName{nextString()});
+        exitIds[dir] = ServerRoomId{nextUint()};
+    }
+
+    Entry entry;
+    entry.state = decodeState(nextUint());
+    entry.room = ExternalRoomId{nextUint()};
+    entry.event = ParseEvent::createSharedEvent(static_cast<CommandEnum>(move),
+                                                serverId,
+                                                std::move(area),
+                                                std::move(name),
+                                                std::move(desc),
+                                                std::move(contents),
+                                                exitIds,
+                                                static_cast<RoomTerrainEnum>(terrain),
+                                                std::move(exits),
+                                                promptFlags,
+                                                connectedRoomFlags);
+    return entry;
+}
+
+} // namespace
+
+std::string_view getStateName(const PathStateEnum state)
+{
+    switch (state) {
+    case PathStateEnum::APPROVED:
+        return "APPROVED";
+    case PathStateEnum::EXPERIMENTING:
+        return "EXPERIMENTING";
+    case PathStateEnum::SYNCING:
+        return "SYNCING";
+    }
+    return "UNKNOWN";
+}
+
+void writeHeader(std::ostream &os)
+{
+    os << HEADER << '\n';
+}
+
+void write(std::ostream &os,
+           const ParseEvent &ev,
+           const PathStateEnum state,
+           const ExternalRoomId room)
+{
+    os << static_cast<uint32_t>(ev.getMoveType()) << SEP;
+    os << ev.getServerId().asUint32() << SEP;
+    os << static_cast<uint32_t>(ev.getTerrainType()) << SEP;
+    os << static_cast<uint32_t>(ev.getPromptFlags()) << SEP;
+    os << encodeConnectedRoomFlags(ev.getConnectedRoomFlags()) << SEP;
+
+    writeEscaped(os, ev.getRoomArea().getStdStringViewUtf8());
+    os << SEP;
+    writeEscaped(os, ev.getRoomName().getStdStringViewUtf8());
+    os << SEP;
+    writeEscaped(os, ev.getRoomDesc().getStdStringViewUtf8());
+    os << SEP;
+    writeEscaped(os, ev.getRoomContents().getStdStringViewUtf8());
+    os << SEP;
+
+    const auto &exits = ev.getExits();
+    const auto &exitIds = ev.getExitIds();
+    for (const ExitDirEnum dir : ALL_EXITS7) {
+        const auto &ex = exits[dir];
+        os << ex.getExitFlags().asUint32() << SEP;
+        os << ex.getDoorFlags().asUint32() << SEP;
+        writeEscaped(os, ex.getDoorName().getStdStringViewUtf8());
+        os << SEP;
+        os << exitIds[dir].asUint32() << SEP;
+    }
+
+    os << static_cast<uint32_t>(state) << SEP;
+    os << room.asUint32() << '\n';
+}
+
+std::vector<Entry> read(std::istream &is)
+{
+    std::vector<Entry> result;
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(is, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+        try {
+            result.emplace_back(parseLine(line));
+        } catch (const std::exception &e) {
+            throw std::runtime_error("line " + std::to_string(lineNumber) + ": " + e.what());
+        }
+    }
+    return result;
+}
+
+} // namespace parse_event_log
+
+// Truncates rather than appends, since the replay starts from a fresh path machine.
+ParseEventRecorder::ParseEventRecorder(const std::string &filename)
+    : m_file{filename, std::ios::out | std::ios::trunc | std::ios::binary}
+{
+    if (m_file.is_open()) {
+        parse_event_log::writeHeader(m_file);
+    }
+}
+
+void ParseEventRecorder::record(const ParseEvent &event,
+                                const PathStateEnum state,
+                                const ExternalRoomId room)
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    parse_event_log::write(m_file, event, state, room);
+
+    // Flush per event, so the recording survives a crash in the code being measured.
+    m_file.flush();
+}
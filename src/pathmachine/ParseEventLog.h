@@ -0,0 +1,64 @@
+#pragma once
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "../global/RuleOf5.h"
+#include "../global/macros.h"
+#include "../map/parseevent.h"
+#include "../map/roomid.h"
+#include "pathmachine.h"
+
+#include <fstream>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*! \brief Line-based recording of the parse events fed to the path machine.
+ *
+ * Each line holds one ParseEvent, followed by the path machine state and the
+ * most likely room (by external id) after the event was handled. The replay
+ * harness (tests/ReplayPathMachine.cpp) compares against those to detect
+ * behavior changes.
+ *
+ * Set the MMAPPER_RECORD_PARSE_EVENTS environment variable to a file name to
+ * record a live session. Each run of MMapper starts the file over: a recording has
+ * to begin with a fresh path machine for the replay to reproduce it.
+ */
+namespace parse_event_log {
+
+static constexpr const char *const RECORD_ENV_VAR = "MMAPPER_RECORD_PARSE_EVENTS";
+
+struct NODISCARD Entry final
+{
+    SharedParseEvent event;
+    PathStateEnum state = PathStateEnum::SYNCING;
+    ExternalRoomId room = INVALID_EXTERNAL_ROOMID;
+};
+
+NODISCARD extern std::string_view getStateName(PathStateEnum state);
+
+extern void writeHeader(std::ostream &os);
+extern void write(std::ostream &os,
+                  const ParseEvent &event,
+                  PathStateEnum state,
+                  ExternalRoomId room);
+
+// NOTE: This throws std::runtime_error if the input is malformed.
+NODISCARD extern std::vector<Entry> read(std::istream &is);
+
+} // namespace parse_event_log
+
+class NODISCARD ParseEventRecorder final
+{
+private:
+    std::ofstream m_file;
+
+public:
+    explicit ParseEventRecorder(const std::string &filename);
+    DELETE_CTORS_AND_ASSIGN_OPS(ParseEventRecorder);
+
+public:
+    NODISCARD bool isOpen() const { return m_file.is_open() && m_file.good(); }
+    void record(const ParseEvent &event, PathStateEnum state, ExternalRoomId room);
+};
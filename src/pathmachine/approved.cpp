@@ -39,7 +39,13 @@ void Approved::virt_receiveRoom(const RoomHandle &perhaps)
         if (it != m_compareCache.end()) {
             return it->second;
         }
-        const auto result = ::compare(perhaps.getRaw(), event, m_matchingTolerance);
+        const auto &raw = perhaps.getRaw();
+        const auto result = std::invoke([&raw, &event, this]() -> ComparisonResultEnum {
+            if (const auto fast = ::compareByServerId(raw, event)) {
+                return *fast;
+            }
+            return ::compare(raw, event, m_matchingTolerance);
+        });
         m_compareCache.emplace(id, result);
         return result;
     });
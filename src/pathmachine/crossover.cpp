@@ -17,8 +17,9 @@ struct PathParameters;
 Crossover::Crossover(MapFrontend &map,
                      std::shared_ptr<PathList> _paths,
                      const ExitDirEnum _dirCode,
-                     PathParameters &_params)
-    : Experimenting(std::move(_paths), _dirCode, _params)
+                     PathParameters &_params,
+                     PathPool &_pool)
+    : Experimenting(std::move(_paths), _dirCode, _params, _pool)
     , m_map{map}
 {}
 
@@ -29,7 +30,7 @@ void Crossover::virt_receiveRoom(const RoomHandle &room)
         std::ignore = m_map.tryRemoveTemporary(room.getId());
     }
 
-    for (auto &shortPath : shortPaths) {
+    for (const PathId shortPath : shortPaths) {
         augmentPath(shortPath, room);
     }
 }
@@ -29,7 +29,8 @@ class NODISCARD Crossover final : public Experimenting
     Crossover(MapFrontend &map,
               std::shared_ptr<PathList> paths,
               ExitDirEnum dirCode,
-              PathParameters &params);
+              PathParameters &params,
+              PathPool &pool);
 
 private:
     void virt_receiveRoom(const RoomHandle &) final;
@@ -13,29 +13,31 @@
 
 Experimenting::Experimenting(std::shared_ptr<PathList> pat,
                              const ExitDirEnum in_dirCode,
-                             PathParameters &in_params)
+                             PathParameters &in_params,
+                             PathPool &in_pool)
     : m_direction(::exitDir(in_dirCode))
     , m_dirCode(in_dirCode)
     , m_paths(PathList::alloc())
     , m_params(in_params)
+    , m_pool(in_pool)
     , m_shortPaths(std::move(pat))
 {}
 
 Experimenting::~Experimenting() = default;
 
-void Experimenting::augmentPath(const std::shared_ptr<Path> &path, const RoomHandle &room)
+void Experimenting::augmentPath(const PathId path, const RoomHandle &room)
 {
-    auto &p = deref(path);
-    const Coordinate c = p.getRoom().getPosition() + m_direction;
-    const auto working = p.fork(room, c, m_params, m_dirCode);
-    if (m_best == nullptr) {
+    auto &pool = m_pool;
+    const Coordinate c = pool[path].getRoom().getPosition() + m_direction;
+    const PathId working = pool.fork(path, room, c, m_params, m_dirCode);
+    if (m_best == INVALID_PATHID) {
         m_best = working;
-    } else if (working->getProb() > m_best->getProb()) {
+    } else if (pool[working].getProb() > pool[m_best].getProb()) {
         m_paths->push_back(m_best);
         m_second = m_best;
         m_best = working;
     } else {
-        if (m_second == nullptr || working->getProb() > m_second->getProb()) {
+        if (m_second == INVALID_PATHID || pool[working].getProb() > pool[m_second].getProb()) {
             m_second = working;
         }
         m_paths->push_back(working);
@@ -45,36 +47,37 @@ void Experimenting::augmentPath(const std::shared_ptr<Path> &path, const RoomHan
 
 std::shared_ptr<PathList> Experimenting::evaluate()
 {
+    auto &pool = m_pool;
     for (PathList &sp = deref(m_shortPaths); !sp.empty();) {
-        std::shared_ptr<Path> ppath = utils::pop_front(sp);
-        Path &path = deref(ppath);
-        if (!path.hasChildren()) {
-            path.deny();
+        const PathId path = utils::pop_front(sp);
+        if (!pool[path].hasChildren()) {
+            pool.deny(path);
         }
     }
 
-    if (m_best != nullptr) {
-        if (m_second == nullptr
-            || m_best->getProb() > m_second->getProb() * m_params.acceptBestRelative
-            || m_best->getProb() > m_second->getProb() + m_params.acceptBestAbsolute) {
-            for (auto &path : *m_paths) {
-                path->deny();
+    if (m_best != INVALID_PATHID) {
+        const double bestProb = pool[m_best].getProb();
+        if (m_second == INVALID_PATHID
+            || bestProb > pool[m_second].getProb() * m_params.acceptBestRelative
+            || bestProb > pool[m_second].getProb() + m_params.acceptBestAbsolute) {
+            for (const PathId path : *m_paths) {
+                pool.deny(path);
             }
             m_paths->clear();
             m_paths->push_front(m_best);
         } else {
             m_paths->push_back(m_best);
 
-            for (std::shared_ptr<Path> working = m_paths->front(); working != m_best;) {
+            for (PathId working = m_paths->front(); working != m_best;) {
                 m_paths->pop_front();
                 // throw away if the probability is very low or not
                 // distinguishable from best. Don't keep paths with equal
                 // probability at the front, for we need to find a unique
                 // best path eventually.
-                if (m_best->getProb() > working->getProb() * m_params.maxPaths / m_numPaths
-                    || (m_best->getProb() <= working->getProb()
-                        && m_best->getRoom() == working->getRoom())) {
-                    working->deny();
+                const Path &w = pool[working];
+                if (bestProb > w.getProb() * m_params.maxPaths / m_numPaths
+                    || (bestProb <= w.getProb() && pool[m_best].getRoom() == w.getRoom())) {
+                    pool.deny(working);
                 } else {
                     m_paths->push_back(working);
                 }
@@ -82,8 +85,8 @@ std::shared_ptr<PathList> Experimenting::evaluate()
             }
         }
     }
-    m_second = nullptr;
+    m_second = INVALID_PATHID;
     m_shortPaths = nullptr;
-    m_best = nullptr;
+    m_best = INVALID_PATHID;
     return m_paths;
 }
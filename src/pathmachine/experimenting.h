@@ -34,13 +34,14 @@ class NODISCARD Experimenting : public PathProcessor
     const ExitDirEnum m_dirCode;
     const std::shared_ptr<PathList> m_paths;
     PathParameters &m_params;
+    PathPool &m_pool;
     std::shared_ptr<PathList> m_shortPaths;
-    std::shared_ptr<Path> m_best;
-    std::shared_ptr<Path> m_second;
+    PathId m_best = INVALID_PATHID;
+    PathId m_second = INVALID_PATHID;
     double m_numPaths = 0.0;
 
 protected:
-    void augmentPath(const std::shared_ptr<Path> &path, const RoomHandle &room);
+    void augmentPath(PathId path, const RoomHandle &room);
 
 public:
     Experimenting() = delete;
@@ -49,7 +50,8 @@ class NODISCARD Experimenting : public PathProcessor
 protected:
     explicit Experimenting(std::shared_ptr<PathList> paths,
                            ExitDirEnum dirCode,
-                           PathParameters &params);
+                           PathParameters &params,
+                           PathPool &pool);
 
 public:
     ~Experimenting() override;
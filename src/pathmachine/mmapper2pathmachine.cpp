@@ -7,7 +7,9 @@
 
 #include "../configuration/configuration.h"
 #include "../global/SendToUser.h"
+#include "../global/logging.h"
 #include "../map/parseevent.h"
+#include "ParseEventLog.h"
 #include "pathmachine.h"
 #include "pathparameters.h"
 
@@ -62,9 +64,29 @@ void Mmapper2PathMachine::slot_handleParseEvent(const SigParseEvent &sigParseEve
         global::sendToUser("ERROR: unknown exception\n");
     }
 
+    if (m_recorder != nullptr) {
+        m_recorder->record(sigParseEvent.deref(), getState(), getMostLikelyRoomExternalId());
+    }
+
     emit sig_state(stateName(getState()));
 }
 
 Mmapper2PathMachine::Mmapper2PathMachine(MapFrontend &map, QObject *const parent)
     : PathMachine(map, parent)
-{}
+{
+    if (!qEnvironmentVariableIsSet(parse_event_log::RECORD_ENV_VAR)) {
+        return;
+    }
+
+    const auto filename = qEnvironmentVariable(parse_event_log::RECORD_ENV_VAR).toStdString();
+    auto recorder = std::make_unique<ParseEventRecorder>(filename);
+    if (!recorder->isOpen()) {
+        MMLOG_WARNING() << "Unable to record parse events to " << filename;
+        return;
+    }
+
+    MMLOG() << "Recording parse events to " << filename;
+    m_recorder = std::move(recorder);
+}
+
+Mmapper2PathMachine::~Mmapper2PathMachine() = default;
@@ -7,12 +7,15 @@
 #include "../map/parseevent.h"
 #include "pathmachine.h"
 
+#include <memory>
+
 #include <QString>
 #include <QtCore>
 
 class Configuration;
 class MapFrontend;
 class ParseEvent;
+class ParseEventRecorder;
 class QObject;
 
 /*!
@@ -24,8 +27,12 @@ class NODISCARD_QOBJECT Mmapper2PathMachine final : public PathMachine
 {
     Q_OBJECT
 
+private:
+    std::unique_ptr<ParseEventRecorder> m_recorder;
+
 public:
     explicit Mmapper2PathMachine(MapFrontend &map, QObject *parent);
+    ~Mmapper2PathMachine() final;
 
 signals:
     void sig_state(const QString &);
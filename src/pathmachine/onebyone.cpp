@@ -5,6 +5,8 @@
 
 #include "onebyone.h"
 
+#include "../global/progresscounter.h"
+#include "../global/thread_utils.h"
 #include "../global/utils.h"
 #include "../map/CommandId.h"
 #include "../map/Compare.h"
@@ -14,30 +16,82 @@
 #include "pathparameters.h"
 #include "roomsignalhandler.h"
 
+#include <cstddef>
+#include <iterator>
 #include <memory>
+#include <vector>
 
-class Path;
+// commit() gets the rooms reachable from every live path, so the count grows with the
+// number of paths being tracked. The rooms are already resolved, and each result goes
+// into its own slot of a preallocated vector with nothing to merge afterwards, so the
+// split pays off sooner than for the candidate scan in ParseTree.
+static constexpr size_t MIN_PARALLEL_CANDIDATES = 256;
 
 OneByOne::OneByOne(const SigParseEvent &sigParseEvent,
                    PathParameters &in_params,
+                   PathPool &in_pool,
                    RoomSignalHandler &in_handler)
-    : Experimenting{PathList::alloc(), getDirection(sigParseEvent.deref().getMoveType()), in_params}
+    : Experimenting{PathList::alloc(),
+                    getDirection(sigParseEvent.deref().getMoveType()),
+                    in_params,
+                    in_pool}
     , m_event{sigParseEvent.getShared()}
     , m_handler{in_handler}
 {}
 
 void OneByOne::virt_receiveRoom(const RoomHandle &room)
 {
-    if (::compare(room.getRaw(), deref(m_event), m_params.matchingTolerance)
-        == ComparisonResultEnum::EQUAL) {
-        augmentPath(m_shortPaths->back(), room);
+    m_candidates.emplace_back(Candidate{m_shortPaths->back(), room});
+}
+
+void OneByOne::commit()
+{
+    const auto &event = deref(m_event);
+    const int tolerance = m_params.matchingTolerance;
+
+    // phase 1: pure comparisons
+    std::vector<char> matches(m_candidates.size(), 0);
+    const auto scoreRange = [this, &event, &matches, tolerance](const size_t begin,
+                                                                const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const bool equal = ::compare(m_candidates[i].room.getRaw(), event, tolerance)
+                               == ComparisonResultEnum::EQUAL;
+            matches[i] = static_cast<char>(equal);
+        }
+    };
+
+    if (m_candidates.size() < MIN_PARALLEL_CANDIDATES) {
+        scoreRange(0, m_candidates.size());
     } else {
-        m_handler.hold(room.getId());
-        m_handler.release(room.getId());
+        struct NODISCARD DummyThreadLocals final
+        {};
+        const auto first = m_candidates.begin();
+        ProgressCounter dummyPc;
+        thread_utils::parallel_for_each_tl_range<DummyThreadLocals>(
+            m_candidates,
+            dummyPc,
+            [&scoreRange, first](DummyThreadLocals &, const auto chunkBegin, const auto chunkEnd) {
+                scoreRange(static_cast<size_t>(std::distance(first, chunkBegin)),
+                           static_cast<size_t>(std::distance(first, chunkEnd)));
+            },
+            [](auto &) {});
+    }
+
+    // phase 2: serial updates to the paths and room holds, in the order received
+    const size_t size = m_candidates.size();
+    for (size_t i = 0; i < size; ++i) {
+        const Candidate &candidate = m_candidates[i];
+        if (matches[i] != 0) {
+            augmentPath(candidate.path, candidate.room);
+        } else {
+            m_handler.hold(candidate.room.getId());
+            m_handler.release(candidate.room.getId());
+        }
     }
+    m_candidates.clear();
 }
 
-void OneByOne::addPath(std::shared_ptr<Path> path)
+void OneByOne::addPath(const PathId path)
 {
-    m_shortPaths->emplace_back(std::move(path));
+    m_shortPaths->emplace_back(path);
 }
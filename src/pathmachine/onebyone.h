@@ -9,9 +9,9 @@
 #include "roomsignalhandler.h"
 
 #include <memory>
+#include <vector>
 
 class ParseEvent;
-class Path;
 struct PathParameters;
 
 /*!
@@ -19,23 +19,34 @@ struct PathParameters;
  *
  * Used in "Experimenting" state, typically when not creating new rooms.
  * PathMachine feeds it rooms found via current paths' exits/coordinates.
- * If a received room matches the event, `augmentPath()` (from Experimenting)
- * is called to extend the current path being processed.
+ * Received rooms are only collected; `commit()` compares them all against the
+ * event in parallel, and then, in the order they were received, calls
+ * `augmentPath()` (from Experimenting) for each match to extend its path.
  */
 class NODISCARD OneByOne final : public Experimenting
 {
 private:
+    struct NODISCARD Candidate final
+    {
+        PathId path;
+        RoomHandle room;
+    };
+
     SharedParseEvent m_event;
     RoomSignalHandler &m_handler;
+    std::vector<Candidate> m_candidates;
 
 public:
     explicit OneByOne(const SigParseEvent &sigParseEvent,
                       PathParameters &in_params,
+                      PathPool &pool,
                       RoomSignalHandler &handler);
 
 private:
     void virt_receiveRoom(const RoomHandle &room) final;
 
 public:
-    void addPath(std::shared_ptr<Path> path);
+    void addPath(PathId path);
+    // must be called before evaluate()
+    void commit();
 };
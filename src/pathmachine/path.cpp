@@ -12,30 +12,35 @@
 #include "pathparameters.h"
 #include "roomsignalhandler.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
-#include <memory>
 #include <optional>
 #include <utility>
 
-std::shared_ptr<Path> Path::alloc(const RoomHandle &room,
-                                  RoomSignalHandler &signaler,
-                                  std::optional<ExitDirEnum> moved_direction)
+PathId PathPool::alloc(const RoomHandle &room, const std::optional<ExitDirEnum> direction)
 {
-    return std::make_shared<Path>(Badge<Path>{}, room, signaler, std::move(moved_direction));
-}
+    PathId id;
+    if (m_free.empty()) {
+        id = PathId{static_cast<uint32_t>(m_paths.size())};
+        m_paths.emplace_back();
+    } else {
+        id = m_free.back();
+        m_free.pop_back();
+    }
 
-Path::Path(Badge<Path>,
-           RoomHandle moved_room,
-           RoomSignalHandler &in_signaler,
-           std::optional<ExitDirEnum> moved_direction)
-    : m_room(std::move(moved_room))
-    , m_signaler(in_signaler)
-    , m_dir(std::move(moved_direction))
-{
-    if (m_dir.has_value()) {
-        m_signaler.hold(m_room.getId());
+    Path &path = (*this)[id];
+    assert(path.m_children.empty());
+    path.m_parent = INVALID_PATHID;
+    path.m_probability = 1.0;
+    path.m_room = room;
+    path.m_dir = direction;
+    path.m_zombie = false;
+
+    if (direction.has_value()) {
+        m_signaler.hold(room.getId());
     }
+    return id;
 }
 
 /**
@@ -43,21 +48,25 @@ Path::Path(Badge<Path>,
  * distance between rooms is calculated
  * and probability is updated accordingly
  */
-std::shared_ptr<Path> Path::fork(const RoomHandle &in_room,
-                                 const Coordinate expectedCoordinate,
-                                 const PathParameters &p,
-                                 const ExitDirEnum direction)
+PathId PathPool::fork(const PathId parent,
+                      const RoomHandle &in_room,
+                      const Coordinate expectedCoordinate,
+                      const PathParameters &p,
+                      const ExitDirEnum direction)
 {
-    assert(!m_zombie);
+    assert(!(*this)[parent].m_zombie);
     const auto udir = static_cast<uint32_t>(direction);
     assert(isClamped(udir, 0u, NUM_EXITS));
 
-    auto ret = Path::alloc(in_room, m_signaler, direction);
-    ret->setParent(shared_from_this());
-    insertChild(ret);
+    // note: this can reallocate m_paths, so don't hold references across it.
+    const PathId ret = alloc(in_room, direction);
+    insertChild(parent, ret);
+
+    const Path &self = (*this)[parent];
+    const RoomHandle &room = self.m_room;
 
     double dist = expectedCoordinate.distance(in_room.getPosition());
-    const auto size = static_cast<uint32_t>(m_room.isTemporary() ? 0 : NUM_EXITS);
+    const auto size = static_cast<uint32_t>(room.isTemporary() ? 0 : NUM_EXITS);
     // NOTE: we can probably assert that size is nonzero (room is not a dummy).
     assert(size == 0u /* dummy */ || size == NUM_EXITS /* valid */);
 
@@ -70,11 +79,11 @@ std::shared_ptr<Path> Path::fork(const RoomHandle &in_room,
         }
     } else {
         if (udir < size) {
-            const auto &e = m_room.getExit(direction);
+            const auto &e = room.getExit(direction);
             auto oid = in_room.getId();
             if (e.containsOut(oid)) {
                 dist = 1.0 / p.correctPositionBonus;
-            } else if (!e.outIsEmpty() || oid == m_room.getId()) {
+            } else if (!e.outIsEmpty() || oid == room.getId()) {
                 dist *= p.multipleConnectionsPenalty;
             } else {
                 const auto &oe = in_room.getExit(opposite(direction));
@@ -86,7 +95,7 @@ std::shared_ptr<Path> Path::fork(const RoomHandle &in_room,
         } else if (udir < NUM_EXITS_INCLUDING_NONE) {
             /* NOTE: This is currently always true unless the data is corrupt. */
             for (uint32_t d = 0; d < size; ++d) {
-                const auto &e = m_room.getExit(static_cast<ExitDirEnum>(d));
+                const auto &e = room.getExit(static_cast<ExitDirEnum>(d));
                 if (e.containsOut(in_room.getId())) {
                     dist = 1.0 / p.correctPositionBonus;
                     break;
@@ -98,87 +107,111 @@ std::shared_ptr<Path> Path::fork(const RoomHandle &in_room,
     if (in_room.isTemporary()) {
         dist *= p.newRoomPenalty;
     }
-    ret->setProb(m_probability / dist);
+    (*this)[ret].setProb(self.m_probability / dist);
 
     return ret;
 }
 
-void Path::setParent(const std::shared_ptr<Path> &p)
+void PathPool::approve(const PathId id, ChangeList &changes)
 {
-    assert(!m_zombie);
-    assert(!deref(p).m_zombie);
-    m_parent = p;
-}
-
-void Path::approve(ChangeList &changes)
-{
-    assert(!m_zombie);
+    assert(!(*this)[id].m_zombie);
 
-    const auto &parent = getParent();
-    if (parent == nullptr) {
-        assert(!m_dir.has_value());
+    const PathId parent = (*this)[id].m_parent;
+    if (parent == INVALID_PATHID) {
+        assert(!(*this)[id].m_dir.has_value());
     } else {
-        assert(m_dir.has_value());
-        const RoomHandle proom = parent->getRoom();
+        const Path &path = (*this)[id];
+        assert(path.m_dir.has_value());
+        const RoomHandle &proom = (*this)[parent].getRoom();
         const auto pId = !proom.exists() ? INVALID_ROOMID : proom.getId();
-        m_signaler.keep(m_room.getId(), m_dir.value(), pId, changes);
-        parent->removeChild(this->shared_from_this());
-        parent->approve(changes);
+        m_signaler.keep(path.m_room.getId(), path.m_dir.value(), pId, changes);
+        removeChild(parent, id);
+        approve(parent, changes);
     }
 
-    for (const std::weak_ptr<Path> &weak_child : m_children) {
-        if (auto child = weak_child.lock()) {
-            child->setParent(nullptr);
-        }
+    for (const PathId child : (*this)[id].m_children) {
+        (*this)[child].m_parent = INVALID_PATHID;
     }
 
     // was: `delete this`
-    this->m_zombie = true;
+    setZombie(id);
 }
 
 /** removes this path and all parents up to the next branch
  * and removes the respective rooms if experimental
  */
-void Path::deny()
+void PathPool::deny(const PathId id)
 {
-    assert(!m_zombie);
+    const Path &path = (*this)[id];
+    assert(!path.m_zombie);
 
-    if (!m_children.empty()) {
+    if (!path.m_children.empty()) {
         return;
     }
-    if (m_dir.has_value()) {
-        m_signaler.release(m_room.getId());
+    if (path.m_dir.has_value()) {
+        m_signaler.release(path.m_room.getId());
     }
-    if (const auto &parent = getParent()) {
-        parent->removeChild(shared_from_this());
-        parent->deny();
+    if (const PathId parent = path.m_parent; parent != INVALID_PATHID) {
+        removeChild(parent, id);
+        deny(parent);
     }
 
     // was: `delete this`
-    this->m_zombie = true;
+    setZombie(id);
 }
 
-void Path::insertChild(const std::shared_ptr<Path> &p)
+void PathPool::insertChild(const PathId parent, const PathId child)
 {
-    assert(!m_zombie);
-    assert(!deref(p).m_zombie);
-    m_children.emplace_back(p);
+    assert(!(*this)[parent].m_zombie);
+    assert(!(*this)[child].m_zombie);
+    (*this)[child].m_parent = parent;
+    (*this)[parent].m_children.emplace_back(child);
 }
 
-void Path::removeChild(const std::shared_ptr<Path> &p)
+void PathPool::removeChild(const PathId parent, const PathId child)
 {
-    assert(!m_zombie);
-    assert(!deref(p).m_zombie);
+    assert(!(*this)[parent].m_zombie);
+    assert(!(*this)[child].m_zombie);
 
-    const auto end = m_children.end();
-    const auto it = std::remove_if(m_children.begin(), end, [&p](const auto &weak) {
-        if (auto shared = weak.lock()) {
-            return shared == p; // remove p
-        } else {
-            return true; // also remove any expired children
-        }
-    });
-    if (it != end) {
-        m_children.erase(it, end);
+    auto &children = (*this)[parent].m_children;
+    const auto it = std::find(children.begin(), children.end(), child);
+    if (it != children.end()) {
+        children.erase(it);
+    }
+}
+
+void PathPool::setZombie(const PathId id)
+{
+    Path &path = (*this)[id];
+    assert(!path.m_zombie);
+    path.m_zombie = true;
+    m_zombies.emplace_back(id);
+}
+
+void PathPool::recycleZombies()
+{
+    for (const PathId id : m_zombies) {
+        Path &path = (*this)[id];
+        assert(path.m_zombie);
+        // keeps the capacity of the children for the next fork.
+        path.m_children.clear();
+        path.m_room.reset();
+        m_free.emplace_back(id);
+    }
+    m_zombies.clear();
+}
+
+void PathPool::reset()
+{
+    m_zombies.clear();
+    m_free.clear();
+    const auto size = static_cast<uint32_t>(m_paths.size());
+    // reversed, so the lowest ids are handed out first.
+    for (uint32_t i = size; i-- > 0;) {
+        Path &path = m_paths[i];
+        path.m_children.clear();
+        path.m_room.reset();
+        path.m_zombie = true;
+        m_free.emplace_back(PathId{i});
     }
 }
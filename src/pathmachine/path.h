@@ -3,9 +3,10 @@
 // Copyright (C) 2019 The MMapper Authors
 // Author: Ulf Hermann <ulfonk_mennhar@gmx.de> (Alve)
 // Author: Marek Krejza <krejza@gmail.com> (Caligor)
-// Author: Nils Schimmelmann <nschimme@gmail.com> (Jahara)
 
 #include "../global/Badge.h"
+#include "../global/RuleOf5.h"
+#include "../global/TaggedInt.h"
 #include "../map/DoorFlags.h"
 #include "../map/ExitDirection.h"
 #include "../map/ExitFieldVariant.h"
@@ -15,7 +16,8 @@
 
 #include <cassert>
 #include <climits>
-#include <list>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -23,10 +25,28 @@
 #include <QtGlobal>
 
 class Coordinate;
+class PathPool;
 class PathProcessor;
 class RoomSignalHandler;
 struct PathParameters;
 
+namespace tags {
+struct NODISCARD PathIdTag final
+{};
+} // namespace tags
+
+// Index of a Path in its PathPool.
+struct NODISCARD PathId final : public TaggedInt<PathId, tags::PathIdTag, uint32_t>
+{
+    using TaggedInt::TaggedInt;
+    constexpr PathId()
+        : PathId{UINT_MAX}
+    {}
+    NODISCARD constexpr uint32_t asUint32() const { return value(); }
+};
+
+static constexpr const PathId INVALID_PATHID{UINT_MAX};
+
 /*!
  * @brief Represents a potential path segment during the pathfinding process.
  *
@@ -37,88 +57,125 @@ struct PathParameters;
  * Key attributes:
  * - `m_room`: The RoomHandle this path segment points to.
  * - `m_probability`: Likelihood of this segment being correct.
- * - `m_signaler`: Reference to RoomSignalHandler for lifecycle ops.
  * - `m_dir`: Optional direction taken to reach this path's room.
+ * - `m_parent` and `m_children`: Links to other paths in the same PathPool.
  *
- * Core methods:
- * - `approve(ChangeList&)`: Confirms this path segment, "keeps" its room via
- *   RoomSignalHandler, and recursively approves its parent.
- * - `deny(ChangeList&)`: Rejects this path segment, "releases" its room, and
- *   may recursively deny its parent.
- * - `fork(...)`: Creates a new child Path. Probability is based on various
- *   factors including `RoomSignalHandler::getNumHolders()` for the target room.
- *   When a Path is created via `alloc` (often from `fork`), if it represents a
- *   specific direction from a parent, its room is `hold()`-called via the `RoomSignalHandler`.
- *
- * Managed by `std::shared_ptr<Path>`, typically in PathMachine's `m_paths` list.
+ * Paths are owned by a PathPool and referred to by PathId; the pool implements
+ * the tree operations (fork, approve, deny).
  */
-class NODISCARD Path final : public std::enable_shared_from_this<Path>
+class NODISCARD Path final
 {
 private:
-    std::shared_ptr<Path> m_parent;
-    std::vector<std::weak_ptr<Path>> m_children;
+    friend PathPool;
+
+private:
+    PathId m_parent = INVALID_PATHID;
+    std::vector<PathId> m_children;
     double m_probability = 1.0;
     // in fact a path only has one room, one parent and some children (forks).
-    const RoomHandle m_room;
-    RoomSignalHandler &m_signaler;
-    const std::optional<ExitDirEnum> m_dir;
+    RoomHandle m_room;
+    std::optional<ExitDirEnum> m_dir;
     bool m_zombie = false;
 
 public:
-    static std::shared_ptr<Path> alloc(const RoomHandle &room,
-                                       RoomSignalHandler &signaler,
-                                       std::optional<ExitDirEnum> direction);
+    Path() = default;
+    DEFAULT_RULE_OF_5(Path);
 
 public:
-    explicit Path(Badge<Path>,
-                  RoomHandle moved_room,
-                  RoomSignalHandler &signaler,
-                  std::optional<ExitDirEnum> direction);
-    DELETE_CTORS_AND_ASSIGN_OPS(Path);
-
-    void insertChild(const std::shared_ptr<Path> &p);
-    void removeChild(const std::shared_ptr<Path> &p);
-    void setParent(const std::shared_ptr<Path> &p);
     NODISCARD bool hasChildren() const
     {
         assert(!m_zombie);
         return !m_children.empty();
     }
-    NODISCARD RoomHandle getRoom() const
+    NODISCARD const RoomHandle &getRoom() const
     {
         assert(!m_zombie);
         return m_room;
     }
-
-    // new Path is created, distance between rooms is calculated and probability is set accordingly.
-    NODISCARD std::shared_ptr<Path> fork(const RoomHandle &room,
-                                         Coordinate expectedCoordinate,
-                                         const PathParameters &params,
-                                         ExitDirEnum dir);
     NODISCARD double getProb() const
     {
         assert(!m_zombie);
         return m_probability;
     }
-    void approve(ChangeList &changes);
-
-    // deletes this path and all parents up to the next branch
-    void deny();
     void setProb(double p)
     {
         assert(!m_zombie);
         m_probability = p;
     }
-
-    NODISCARD const std::shared_ptr<Path> &getParent() const
+    NODISCARD PathId getParent() const
     {
         assert(!m_zombie);
         return m_parent;
     }
 };
 
-struct NODISCARD PathList : public std::list<std::shared_ptr<Path>>,
-                            public std::enable_shared_from_this<PathList>
+/*!
+ * @brief Owns the Path tree explored by the PathMachine.
+ *
+ * Paths are stored in a vector and linked by PathId, so forking hundreds of paths
+ * per move doesn't require individual heap allocations. Approved and denied paths
+ * become "zombies"; they are only recycled by `recycleZombies()`, which the
+ * PathMachine calls once per parse event, after all PathProcessors are gone.
+ */
+class NODISCARD PathPool final
+{
+private:
+    RoomSignalHandler &m_signaler;
+    std::vector<Path> m_paths;
+    std::vector<PathId> m_free;
+    std::vector<PathId> m_zombies;
+
+public:
+    explicit PathPool(RoomSignalHandler &signaler)
+        : m_signaler{signaler}
+    {}
+    DELETE_CTORS_AND_ASSIGN_OPS(PathPool);
+
+public:
+    NODISCARD Path &operator[](const PathId id)
+    {
+        assert(id.value() < m_paths.size());
+        return m_paths[id.value()];
+    }
+    NODISCARD const Path &operator[](const PathId id) const
+    {
+        assert(id.value() < m_paths.size());
+        return m_paths[id.value()];
+    }
+
+public:
+    // If a direction is given, the room is `hold()`-called via the RoomSignalHandler.
+    NODISCARD PathId alloc(const RoomHandle &room, std::optional<ExitDirEnum> direction);
+
+    // new Path is created, distance between rooms is calculated and probability is set accordingly.
+    NODISCARD PathId fork(PathId parent,
+                          const RoomHandle &room,
+                          Coordinate expectedCoordinate,
+                          const PathParameters &params,
+                          ExitDirEnum dir);
+
+    // "keeps" the path's room via the RoomSignalHandler, and recursively approves its parent.
+    void approve(PathId id, ChangeList &changes);
+
+    // deletes this path and all parents up to the next branch
+    void deny(PathId id);
+
+    // also sets the child's parent
+    void insertChild(PathId parent, PathId child);
+
+public:
+    // Caller must guarantee that nothing refers to an approved or denied path anymore.
+    void recycleZombies();
+    // Caller must guarantee that nothing refers to any path anymore.
+    void reset();
+    NODISCARD size_t getNumAllocated() const { return m_paths.size() - m_free.size(); }
+
+private:
+    void removeChild(PathId parent, PathId child);
+    void setZombie(PathId id);
+};
+
+struct NODISCARD PathList : public std::deque<PathId>, public std::enable_shared_from_this<PathList>
 {
 public:
     NODISCARD static std::shared_ptr<PathList> alloc()
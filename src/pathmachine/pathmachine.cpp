@@ -6,10 +6,12 @@
 
 #include "pathmachine.h"
 
+#include "../global/PerfStats.h"
 #include "../global/logging.h"
 #include "../global/utils.h"
 #include "../map/ChangeList.h"
 #include "../map/ChangeTypes.h"
+#include "../map/Compare.h"
 #include "../map/CommandId.h"
 #include "../map/ConnectedRoomFlags.h"
 #include "../map/ExitDirection.h"
@@ -38,6 +40,7 @@ PathMachine::PathMachine(MapFrontend &map, QObject *const parent)
     : QObject(parent)
     , m_map{map}
     , m_signaler{map, this}
+    , m_pathPool{m_signaler}
     , m_lastEvent{ParseEvent::createDummyEvent()}
     , m_paths{PathList::alloc()}
 {}
@@ -100,10 +103,11 @@ void PathMachine::forcePositionChange(const RoomId id, const bool update)
 void PathMachine::slot_releaseAllPaths()
 {
     auto &paths = deref(m_paths);
-    for (auto &path : paths) {
-        path->deny();
+    for (const PathId path : paths) {
+        m_pathPool.deny(path);
     }
     paths.clear();
+    recyclePaths();
 
     m_state = PathStateEnum::SYNCING;
 
@@ -116,6 +120,8 @@ void PathMachine::slot_releaseAllPaths()
 
 void PathMachine::handleParseEvent(const SigParseEvent &sigParseEvent)
 {
+    DECL_PERF_TIMER(t, PathMachine);
+
     if (m_lastEvent != sigParseEvent.requireValid()) {
         m_lastEvent = sigParseEvent;
     }
@@ -146,6 +152,9 @@ void PathMachine::handleParseEvent(const SigParseEvent &sigParseEvent)
         break;
     }
 
+    // All of the PathProcessors are gone, so nothing can refer to approved or denied paths.
+    recyclePaths();
+
     if (m_state == PathStateEnum::APPROVED && hasMostLikelyRoom()) {
         updateMostLikelyRoom(sigParseEvent, changes, false);
     }
@@ -313,7 +322,7 @@ void PathMachine::approved(const SigParseEvent &sigParseEvent, ChangeList &chang
             return;
         }
 
-        deref(m_paths).push_front(Path::alloc(pathRoot, m_signaler, std::nullopt));
+        deref(m_paths).push_front(m_pathPool.alloc(pathRoot, std::nullopt));
         experimenting(sigParseEvent, changes);
 
         return;
@@ -542,12 +551,15 @@ void PathMachine::syncing(const SigParseEvent &sigParseEvent, ChangeList &change
     auto &params = m_params;
     ParseEvent &event = sigParseEvent.deref();
     {
-        Syncing sync{params, m_paths, m_signaler};
-        if (event.getNumSkipped() <= params.maxSkipped) {
+        Syncing sync{params, m_paths, m_pathPool};
+        if (const auto rh = findRoomByServerId(event)) {
+            // Server ids are unique, so there's no need to search the ParseTree.
+            sync.receiveRoom(rh);
+        } else if (event.getNumSkipped() <= params.maxSkipped) {
             RoomIdSet ids = m_map.lookingForRooms(sigParseEvent);
             if (event.hasServerId()) {
-                if (auto rh = m_map.findRoomHandle(event.getServerId())) {
-                    ids.insert(rh.getId());
+                if (auto serverIdRoom = m_map.findRoomHandle(event.getServerId())) {
+                    ids.insert(serverIdRoom.getId());
                 }
             }
             for (RoomId id : ids) {
@@ -571,10 +583,10 @@ void PathMachine::experimenting(const SigParseEvent &sigParseEvent, ChangeList &
     if (event.canCreateNewRoom() && isDirectionNESWUD(moveCode) && hasMostLikelyRoom()) {
         const auto dir = getDirection(moveCode);
         const Coordinate move = ::exitDir(dir);
-        Crossover exp{m_map, m_paths, dir, params};
+        Crossover exp{m_map, m_paths, dir, params, m_pathPool};
         RoomIdSet pathEnds;
-        for (const auto &path : deref(m_paths)) {
-            const auto &working = path->getRoom();
+        for (const PathId path : deref(m_paths)) {
+            const RoomHandle &working = m_pathPool[path].getRoom();
             const RoomId workingId = working.getId();
             if (!pathEnds.contains(workingId)) {
                 qInfo() << "creating RoomId" << workingId.asUint32();
@@ -598,17 +610,19 @@ void PathMachine::experimenting(const SigParseEvent &sigParseEvent, ChangeList &
         }
         m_paths = exp.evaluate();
     } else {
-        OneByOne oneByOne{sigParseEvent, params, m_signaler};
+        OneByOne oneByOne{sigParseEvent, params, m_pathPool, m_signaler};
         {
             auto &tmp = oneByOne;
-            for (const auto &path : deref(m_paths)) {
-                const auto &working = path->getRoom();
+            for (const PathId path : deref(m_paths)) {
+                // copied, because forking can reallocate the pool.
+                const RoomHandle working = m_pathPool[path].getRoom();
                 tmp.addPath(path);
                 tryExits(working, tmp, event, true);
                 tryExits(working, tmp, event, false);
                 tryCoordinate(working, tmp, event);
             }
         }
+        oneByOne.commit();
         m_paths = oneByOne.evaluate();
     }
 
@@ -623,7 +637,7 @@ void PathMachine::evaluatePaths(ChangeList &changes)
         return;
     }
 
-    if (const auto room = deref(paths.front()).getRoom()) {
+    if (const auto &room = m_pathPool[paths.front()].getRoom()) {
         setMostLikelyRoom(room.getId());
     } else {
         // REVISIT: Should this case set state to SYNCING and then return?
@@ -634,13 +648,23 @@ void PathMachine::evaluatePaths(ChangeList &changes)
     // but here we happily assume that it does exist.
     if (paths.size() == 1) {
         m_state = PathStateEnum::APPROVED;
-        std::shared_ptr<Path> path = utils::pop_front(paths);
-        deref(path).approve(changes);
+        const PathId path = utils::pop_front(paths);
+        m_pathPool.approve(path, changes);
     } else {
         m_state = PathStateEnum::EXPERIMENTING;
     }
 }
 
+void PathMachine::recyclePaths()
+{
+    if (deref(m_paths).empty()) {
+        // Nothing is being tracked, so start over with an empty pool.
+        m_pathPool.reset();
+    } else {
+        m_pathPool.recycleZombies();
+    }
+}
+
 void PathMachine::scheduleAction(const ChangeList &action)
 {
     if (getMapMode() != MapModeEnum::OFFLINE) {
@@ -666,6 +690,27 @@ RoomHandle PathMachine::getMostLikelyRoom() const
     return m_map.findRoomHandle(m_mostLikelyRoom.value());
 }
 
+RoomHandle PathMachine::findRoomByServerId(const ParseEvent &event) const
+{
+    if (!event.hasServerId()) {
+        return RoomHandle{};
+    }
+
+    auto room = m_map.findRoomHandle(event.getServerId());
+    if (!room || !::compareByServerId(room.getRaw(), event).has_value()) {
+        return RoomHandle{};
+    }
+    return room;
+}
+
+ExternalRoomId PathMachine::getMostLikelyRoomExternalId() const
+{
+    if (const auto &room = getMostLikelyRoom()) {
+        return room.getIdExternal();
+    }
+    return INVALID_EXTERNAL_ROOMID;
+}
+
 void PathMachine::setMostLikelyRoom(const RoomId roomId)
 {
     if (const auto &room = m_map.findRoomHandle(roomId)) {
@@ -51,6 +51,7 @@ class NODISCARD_QOBJECT PathMachine : public QObject
 private:
     MapFrontend &m_map;
     RoomSignalHandler m_signaler;
+    PathPool m_pathPool;
     SigParseEvent m_lastEvent;
     std::shared_ptr<PathList> m_paths;
     std::optional<RoomId> m_pathRoot;
@@ -65,6 +66,11 @@ class NODISCARD_QOBJECT PathMachine : public QObject
     void forceUpdate(const RoomId id) { forcePositionChange(id, true); }
     NODISCARD bool hasLastEvent() const;
 
+public:
+    NODISCARD PathStateEnum getState() const { return m_state; }
+    // Returns INVALID_EXTERNAL_ROOMID if there's no most likely room.
+    NODISCARD ExternalRoomId getMostLikelyRoomExternalId() const;
+
 public:
     void onMapLoaded();
 
@@ -83,6 +89,7 @@ class NODISCARD_QOBJECT PathMachine : public QObject
     void syncing(const SigParseEvent &sigParseEvent, ChangeList &changes);
     void approved(const SigParseEvent &sigParseEvent, ChangeList &changes);
     void evaluatePaths(ChangeList &changes);
+    void recyclePaths();
     void tryExits(const RoomHandle &, PathProcessor &, const ParseEvent &, bool out);
     void tryExit(const RawExit &possible, PathProcessor &recipient, bool out);
     void tryCoordinate(const RoomHandle &, PathProcessor &, const ParseEvent &);
@@ -95,7 +102,6 @@ class NODISCARD_QOBJECT PathMachine : public QObject
     void setMostLikelyRoom(RoomId roomId);
 
 protected:
-    NODISCARD PathStateEnum getState() const { return m_state; }
     NODISCARD MapModeEnum getMapMode() const { return getConfig().general.mapMode; }
 
 private:
@@ -106,6 +112,8 @@ class NODISCARD_QOBJECT PathMachine : public QObject
     NODISCARD RoomHandle getPathRoot() const;
     // NOTE: This can fail.
     NODISCARD RoomHandle getMostLikelyRoom() const;
+    // Returns the room with the event's server id, if its weak properties agree.
+    NODISCARD RoomHandle findRoomByServerId(const ParseEvent &event) const;
 
 signals:
     void sig_playerMoved(RoomId id);
@@ -11,29 +11,26 @@
 
 #include <memory>
 
-Syncing::Syncing(PathParameters &in_p,
-                 std::shared_ptr<PathList> moved_paths,
-                 RoomSignalHandler &in_signaler)
-    : signaler(in_signaler)
+Syncing::Syncing(PathParameters &in_p, std::shared_ptr<PathList> moved_paths, PathPool &in_pool)
+    : pool(in_pool)
     , params(in_p)
     , paths(std::move(moved_paths))
-    , parent(Path::alloc(RoomHandle{}, signaler, std::nullopt))
+    , parent(pool.alloc(RoomHandle{}, std::nullopt))
 {}
 
 void Syncing::virt_receiveRoom(const RoomHandle &in_room)
 {
     if (++numPaths > params.maxPaths) {
         if (!paths->empty()) {
-            for (auto &path : *paths) {
-                path->deny();
+            for (const PathId path : *paths) {
+                pool.deny(path);
             }
             paths->clear();
-            parent = nullptr;
+            parent = INVALID_PATHID;
         }
     } else {
-        auto p = Path::alloc(in_room, signaler, ExitDirEnum::NONE);
-        p->setParent(parent);
-        parent->insertChild(p);
+        const PathId p = pool.alloc(in_room, ExitDirEnum::NONE);
+        pool.insertChild(parent, p);
         paths->push_back(p);
     }
 }
@@ -45,7 +42,7 @@ std::shared_ptr<PathList> Syncing::evaluate()
 
 Syncing::~Syncing()
 {
-    if (parent != nullptr) {
-        parent->deny();
+    if (parent != INVALID_PATHID) {
+        pool.deny(parent);
     }
 }
@@ -12,7 +12,6 @@
 
 #include <QtGlobal>
 
-class RoomSignalHandler;
 struct PathParameters;
 
 /*!
@@ -26,17 +25,15 @@ struct PathParameters;
 class NODISCARD Syncing final : public PathProcessor
 {
 private:
-    RoomSignalHandler &signaler;
+    PathPool &pool;
     PathParameters &params;
     const std::shared_ptr<PathList> paths;
     // This is not our parent; it's the parent we assign to new objects.
-    std::shared_ptr<Path> parent;
+    PathId parent = INVALID_PATHID;
     uint32_t numPaths = 0u;
 
 public:
-    explicit Syncing(PathParameters &p,
-                     std::shared_ptr<PathList> paths,
-                     RoomSignalHandler &signaler);
+    explicit Syncing(PathParameters &p, std::shared_ptr<PathList> paths, PathPool &pool);
 
 public:
     Syncing() = delete;
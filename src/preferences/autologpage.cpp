@@ -59,6 +59,11 @@ AutoLogPage::AutoLogPage(QWidget *const parent)
                 setConfig().autoLog.deleteWhenLogsReachBytes = size * MEGABYTE_IN_BYTES;
             });
 
+    connect(ui->compressLogsCheckBox,
+            QOverload<bool>::of(&QCheckBox::toggled),
+            this,
+            [](const bool compress) { setConfig().autoLog.compressLogs = compress; });
+
     if constexpr (CURRENT_PLATFORM == PlatformEnum::Wasm) {
         ui->autoLogCheckBox->setDisabled(true);
         ui->autoLogLocation->setDisabled(true);
@@ -70,6 +75,7 @@ AutoLogPage::AutoLogPage(QWidget *const parent)
         ui->spinBoxSize->setDisabled(true);
         ui->askDeleteCheckBox->setDisabled(true);
         ui->autoLogMaxBytes->setDisabled(true);
+        ui->compressLogsCheckBox->setDisabled(true);
     }
 }
 
@@ -100,6 +106,7 @@ void AutoLogPage::slot_loadConfig()
     ui->spinBoxDays->setValue(config.deleteWhenLogsReachDays);
     ui->spinBoxSize->setValue(config.deleteWhenLogsReachBytes / MEGABYTE_IN_BYTES);
     ui->askDeleteCheckBox->setChecked(config.askDelete);
+    ui->compressLogsCheckBox->setChecked(config.compressLogs);
 }
 
 void AutoLogPage::slot_selectLogLocationButtonClicked(int /*unused*/)
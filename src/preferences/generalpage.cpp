@@ -73,6 +73,9 @@ GeneralPage::GeneralPage(QWidget *parent)
     connect(ui->checkForUpdateCheckBox, &QCheckBox::stateChanged, this, [this]() {
         setConfig().general.checkForUpdate = ui->checkForUpdateCheckBox->isChecked();
     });
+    connect(ui->roomTextOnDiskCheckBox, &QCheckBox::stateChanged, this, [this]() {
+        setConfig().general.mapRoomTextOnDisk = ui->roomTextOnDiskCheckBox->isChecked();
+    });
     connect(ui->autoLoadFileName,
             &QLineEdit::textChanged,
             this,
@@ -310,6 +313,8 @@ void GeneralPage::slot_loadConfig()
 
     ui->checkForUpdateCheckBox->setChecked(config.general.checkForUpdate);
     ui->checkForUpdateCheckBox->setDisabled(NO_UPDATER);
+    ui->roomTextOnDiskCheckBox->setChecked(config.general.mapRoomTextOnDisk);
+    ui->roomTextOnDiskCheckBox->setDisabled(CURRENT_PLATFORM == PlatformEnum::Wasm);
     ui->autoLoadFileName->setText(autoLoad.fileName);
     ui->autoLoadCheck->setChecked(autoLoad.autoLoadMap);
     if constexpr (CURRENT_PLATFORM == PlatformEnum::Wasm) {
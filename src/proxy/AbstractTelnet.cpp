@@ -17,6 +17,7 @@
 
 #include <array>
 #include <cassert>
+#include <cstring>
 #include <functional>
 #include <limits>
 #include <optional>
@@ -855,8 +856,9 @@ void AbstractTelnet::onReadInternal(const TelnetIacBytes &data)
     // because the data contains telnet commands
     // so we parse the text and process all telnet commands:
 
-    AppendBuffer cleanData;
-    cleanData.reserve(static_cast<int>(data.size()));
+    // Shares the received buffer, so plain text can be passed on without copying it.
+    const RawSlice input{RawBytes{data.getQByteArray()}};
+    CleanData cleanData;
 
     int pos = 0;
     while (pos < data.size()) {
@@ -869,6 +871,13 @@ void AbstractTelnet::onReadInternal(const TelnetIacBytes &data)
             continue;
         }
 
+        // Plain text can't change the state or set any of the flags checked below,
+        // so everything up to the next IAC is taken at once.
+        if (const int n = onReadInternalBulk(cleanData, input.mid(pos)); n > 0) {
+            pos += n;
+            continue;
+        }
+
         // Process character by character
         const auto c = static_cast<uint8_t>(data.at(pos));
         ++pos;
@@ -891,11 +900,68 @@ void AbstractTelnet::onReadInternal(const TelnetIacBytes &data)
 
     // some data left to send - do it now!
     if (!cleanData.isEmpty()) {
-        sendToMapper(cleanData, m_recvdGA); // without GO-AHEAD
+        sendToMapper(cleanData.getSlice(), m_recvdGA); // without GO-AHEAD
         cleanData.clear();
     }
 }
 
+NODISCARD static int lengthBeforeIac(const char *const data, const int length)
+{
+    if (length <= 0) {
+        return 0;
+    }
+    const auto *const iac = static_cast<const char *>(
+        std::memchr(data, TN_IAC, static_cast<size_t>(length)));
+    return (iac == nullptr) ? length : static_cast<int>(iac - data);
+}
+
+/*
+ * Same as below, but plain text is passed on as a slice of the received bytes.
+ */
+int AbstractTelnet::onReadInternalBulk(CleanData &cleanData, const RawSlice &input)
+{
+    if (m_state != TelnetStateEnum::NORMAL) {
+        return onReadInternalBulk(cleanData, input.data(), static_cast<int>(input.size()));
+    }
+
+    const int n = lengthBeforeIac(input.data(), static_cast<int>(input.size()));
+    if (n > 0) {
+        cleanData.append(input.mid(0, n));
+    }
+    return n;
+}
+
+/*
+ * Consumes the leading bytes that onReadInternal2() would only copy: plain text
+ * in the NORMAL state, or option payload in the SUBNEG state. Stops at the next
+ * IAC, and returns the number of bytes consumed (0 in any other state).
+ */
+int AbstractTelnet::onReadInternalBulk(CleanData &cleanData,
+                                       const char *const data,
+                                       const int length)
+{
+    switch (m_state) {
+    case TelnetStateEnum::NORMAL:
+    case TelnetStateEnum::SUBNEG:
+        break;
+    case TelnetStateEnum::IAC:
+    case TelnetStateEnum::COMMAND:
+    case TelnetStateEnum::SUBNEG_IAC:
+    case TelnetStateEnum::SUBNEG_COMMAND:
+        return 0;
+    }
+
+    const int n = lengthBeforeIac(data, length);
+    if (n > 0) {
+        if (m_state == TelnetStateEnum::NORMAL) {
+            cleanData.append(data, n);
+        } else {
+            m_subnegBuffer.append(data, n);
+        }
+    }
+    return n;
+}
+
 /*
  * normal telnet state
  * -------------------
@@ -921,7 +987,7 @@ void AbstractTelnet::onReadInternal(const TelnetIacBytes &data)
  * So if you receive "IAC SB IAC WILL ECHO f o o IAC IAC b a r IAC SE"
  * then you process will(ECHO) followed by the subnegotiation(f o o 255 b a r).
  */
-void AbstractTelnet::onReadInternal2(AppendBuffer &cleanData, const uint8_t c)
+void AbstractTelnet::onReadInternal2(CleanData &cleanData, const uint8_t c)
 {
     auto &state = m_state;
     auto &commandBuffer = m_commandBuffer;
@@ -1034,7 +1100,7 @@ void AbstractTelnet::onReadInternal2(AppendBuffer &cleanData, const uint8_t c)
 
 int AbstractTelnet::onReadInternalInflate(const char *const data,
                                           const int length,
-                                          AppendBuffer &cleanData)
+                                          CleanData &cleanData)
 {
 #ifdef MMAPPER_NO_ZLIB
     abort();
@@ -1073,6 +1139,12 @@ int AbstractTelnet::onReadInternalInflate(const char *const data,
 
         const int outLen = CHUNK - static_cast<int>(stream.avail_out);
         for (auto i = 0; i < outLen; ++i) {
+            if (const int n = onReadInternalBulk(cleanData, out + i, outLen - i); n > 0) {
+                // the loop increment skips the last byte of the span
+                i += n - 1;
+                continue;
+            }
+
             // Process character by character
             const auto c = static_cast<uint8_t>(out[i]);
             onReadInternal2(cleanData, c);
@@ -1097,13 +1169,13 @@ void AbstractTelnet::resetCompress()
     }
 }
 
-void AbstractTelnet::processGA(AppendBuffer &cleanData)
+void AbstractTelnet::processGA(CleanData &cleanData)
 {
     if (!m_recvdGA) {
         return;
     }
 
-    sendToMapper(cleanData, m_recvdGA); // with GO-AHEAD
+    sendToMapper(cleanData.getSlice(), m_recvdGA); // with GO-AHEAD
     cleanData.clear();
     m_recvdGA = false;
 }
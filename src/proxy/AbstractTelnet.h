@@ -80,6 +80,7 @@ struct NODISCARD AppendBuffer : public RawBytes
     using RawBytes ::operator=;
 
     void append(const uint8_t c) { RawBytes::append(static_cast<char>(c)); }
+    void append(const char *const data, const int len) { RawBytes::append(data, len); }
     void operator+=(const uint8_t c) { RawBytes::operator+=(static_cast<char>(c)); }
 
     void reserve(const int at_least)
@@ -95,6 +96,57 @@ struct NODISCARD AppendBuffer : public RawBytes
     }
 };
 
+// Text for the mapper. While it's a single run of the received bytes, it's kept as a
+// slice of them; it's only copied once something else has to be appended to it.
+struct NODISCARD CleanData final
+{
+private:
+    RawSlice m_slice;
+    AppendBuffer m_buffer;
+
+private:
+    void takeSlice()
+    {
+        if (!m_slice.isEmpty()) {
+            m_buffer.append(m_slice.data(), static_cast<int>(m_slice.size()));
+            m_slice = RawSlice{};
+        }
+    }
+
+public:
+    NODISCARD bool isEmpty() const { return m_slice.isEmpty() && m_buffer.isEmpty(); }
+
+    void append(const RawSlice &run)
+    {
+        if (m_buffer.isEmpty() && m_slice.isEmpty()) {
+            m_slice = run;
+            return;
+        }
+        takeSlice();
+        m_buffer.append(run.data(), static_cast<int>(run.size()));
+    }
+    void append(const char *const data, const int len)
+    {
+        takeSlice();
+        m_buffer.append(data, len);
+    }
+    void append(const uint8_t c)
+    {
+        takeSlice();
+        m_buffer.append(c);
+    }
+
+    NODISCARD RawSlice getSlice() const
+    {
+        return m_slice.isEmpty() ? RawSlice{m_buffer} : m_slice;
+    }
+    void clear()
+    {
+        m_slice = RawSlice{};
+        m_buffer.clear();
+    }
+};
+
 struct TelnetFormatter;
 class NODISCARD AbstractTelnet
 {
@@ -226,7 +278,7 @@ class NODISCARD AbstractTelnet
     virtual void virt_receiveMudServerStatus(const TelnetMsspBytes &) {}
     virtual void virt_receiveWindowSize(int, int) {}
     virtual void virt_sendRawData(const TelnetIacBytes &data) = 0;
-    virtual void virt_sendToMapper(const RawBytes &, bool goAhead) = 0;
+    virtual void virt_sendToMapper(const RawSlice &, bool goAhead) = 0;
 
 protected:
     void onGmcpEnabled() { virt_onGmcpEnabled(); }
@@ -256,7 +308,7 @@ class NODISCARD AbstractTelnet
     void sendRawData(const QString &s) = delete;
 
 protected:
-    void sendToMapper(const RawBytes &ba, const bool goAhead) { virt_sendToMapper(ba, goAhead); }
+    void sendToMapper(const RawSlice &ba, const bool goAhead) { virt_sendToMapper(ba, goAhead); }
 
 protected:
     /** send a telnet option */
@@ -268,7 +320,9 @@ class NODISCARD AbstractTelnet
     NODISCARD CharacterEncodingEnum getEncoding() const { return m_textCodec.getEncoding(); }
 
 private:
-    void onReadInternal2(AppendBuffer &, uint8_t);
+    NODISCARD int onReadInternalBulk(CleanData &, const RawSlice &);
+    NODISCARD int onReadInternalBulk(CleanData &, const char *, int);
+    void onReadInternal2(CleanData &, uint8_t);
 
     /** processes a telnet command (IAC ...) */
     void processTelnetCommand(const AppendBuffer &command);
@@ -277,7 +331,7 @@ class NODISCARD AbstractTelnet
     void processTelnetSubnegotiation(const AppendBuffer &payload);
 
 private:
-    NODISCARD int onReadInternalInflate(const char *, int, AppendBuffer &);
+    NODISCARD int onReadInternalInflate(const char *, int, CleanData &);
     void resetCompress();
-    void processGA(AppendBuffer &cleanData);
+    void processGA(CleanData &cleanData);
 };
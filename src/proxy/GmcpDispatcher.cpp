@@ -0,0 +1,211 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "GmcpDispatcher.h"
+
+#include "../global/AnsiOstream.h"
+#include "../global/CaseUtils.h"
+#include "../global/Consts.h"
+#include "../global/RAII.h"
+#include "../global/logging.h"
+#include "../global/utils.h"
+
+#include <chrono>
+#include <stdexcept>
+
+namespace { // anonymous
+
+// One extra slot for GmcpMessageTypeEnum::UNKNOWN.
+std::array<perf_stats::LatencyHistogram, NUM_GMCP_MESSAGES + 1> g_histograms;
+
+NODISCARD size_t getIndex(const GmcpMessageTypeEnum type)
+{
+    if (type == GmcpMessageTypeEnum::UNKNOWN) {
+        return NUM_GMCP_MESSAGES;
+    }
+    return static_cast<size_t>(type);
+}
+
+NODISCARD std::string_view getFriendlyName(const GmcpMessageTypeEnum type)
+{
+#define X_CASE(UPPER_CASE, CamelCase, normalized, friendly) \
+    case GmcpMessageTypeEnum::UPPER_CASE: \
+        return friendly;
+
+    switch (type) {
+        XFOREACH_GMCP_MESSAGE_TYPE(X_CASE)
+    case GmcpMessageTypeEnum::UNKNOWN:
+        break;
+    }
+#undef X_CASE
+    return "(other modules)";
+}
+
+#define X_CASE(UPPER_CASE, CamelCase, normalized, friendly) GmcpMessageTypeEnum::UPPER_CASE,
+constexpr const std::array<GmcpMessageTypeEnum, NUM_GMCP_MESSAGES + 1> ALL_GMCP_MESSAGE_TYPES{
+    XFOREACH_GMCP_MESSAGE_TYPE(X_CASE) GmcpMessageTypeEnum::UNKNOWN};
+#undef X_CASE
+
+NODISCARD std::string normalizeModuleName(const std::string_view moduleName)
+{
+    return toLowerUtf8(moduleName);
+}
+
+// "Char.Items.List" -> "char.items"
+NODISCARD std::string getNormalizedModuleName(const GmcpMessage &msg)
+{
+    const std::string_view name = msg.getName().getStdStringViewUtf8();
+    return normalizeModuleName(name.substr(0, name.find_last_of(char_consts::C_PERIOD)));
+}
+
+void tryInvoke(const GmcpDispatcher::Handler &handler, const GmcpMessage &msg)
+{
+    try {
+        handler(msg);
+    } catch (const std::exception &ex) {
+        MMLOG_WARNING() << "Exception in GMCP handler for "
+                        << msg.getName().getStdStringViewUtf8() << ": [" << ex.what() << "]";
+    } catch (...) {
+        MMLOG_WARNING() << "Unknown exception in GMCP handler for "
+                        << msg.getName().getStdStringViewUtf8() << ".";
+    }
+}
+
+} // namespace
+
+void GmcpDispatcher::addSubscriber(Subscribers &subscribers,
+                                   const Signal2Lifetime &lifetime,
+                                   Handler handler)
+{
+    if (subscribers.invoking) {
+        throw std::runtime_error("cannot subscribe while dispatching");
+    }
+    if (auto shared = lifetime.getObj()) {
+        subscribers.list.push_back(Subscriber{std::move(handler), shared});
+    } else {
+        throw std::runtime_error("expired lifetime");
+    }
+}
+
+void GmcpDispatcher::subscribe(const GmcpMessageTypeEnum type,
+                               const Signal2Lifetime &lifetime,
+                               Handler handler)
+{
+    if (type == GmcpMessageTypeEnum::UNKNOWN) {
+        throw std::invalid_argument("use subscribeModule() for unknown message types");
+    }
+    addSubscriber(m_byType[getIndex(type)], lifetime, std::move(handler));
+}
+
+void GmcpDispatcher::subscribe(const std::initializer_list<GmcpMessageTypeEnum> types,
+                               const Signal2Lifetime &lifetime,
+                               const Handler &handler)
+{
+    for (const GmcpMessageTypeEnum type : types) {
+        subscribe(type, lifetime, handler);
+    }
+}
+
+void GmcpDispatcher::subscribeModule(const std::string_view moduleName,
+                                     const Signal2Lifetime &lifetime,
+                                     Handler handler)
+{
+    auto key = normalizeModuleName(moduleName);
+    auto it = m_byModule.find(key);
+    if (it == m_byModule.end()) {
+        it = m_byModule.emplace(std::move(key), Subscribers{}).first;
+    }
+    addSubscriber(it->second, lifetime, std::move(handler));
+}
+
+GmcpDispatcher::Subscribers *GmcpDispatcher::findSubscribers(const GmcpMessage &msg)
+{
+    const GmcpMessageTypeEnum type = msg.getType();
+    if (type != GmcpMessageTypeEnum::UNKNOWN) {
+        return &m_byType[getIndex(type)];
+    }
+    if (m_byModule.empty()) {
+        return nullptr;
+    }
+    const auto it = m_byModule.find(getNormalizedModuleName(msg));
+    return (it == m_byModule.end()) ? nullptr : &it->second;
+}
+
+void GmcpDispatcher::dispatch(const GmcpMessage &msg)
+{
+    Subscribers *const pSubscribers = findSubscribers(msg);
+    if (pSubscribers == nullptr || pSubscribers->list.empty()) {
+        return;
+    }
+
+    auto &subscribers = *pSubscribers;
+    if (subscribers.invoking) {
+        throw std::runtime_error("recursion");
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const auto beg = Clock::now();
+    {
+        subscribers.invoking = true;
+        const RAIICallback doneInvoking{[&subscribers]() { subscribers.invoking = false; }};
+        utils::erase_if(subscribers.list, [&msg](const Subscriber &sub) -> bool {
+            // keep the object alive for the duration of the call
+            if (MAYBE_UNUSED const auto ignored = sub.weak.lock()) {
+                tryInvoke(sub.handler, msg);
+                return false;
+            }
+            return true; // erase
+        });
+    }
+    g_histograms[getIndex(msg.getType())].record(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - beg));
+}
+
+size_t GmcpDispatcher::getNumSubscribers(const GmcpMessageTypeEnum type) const
+{
+    if (type == GmcpMessageTypeEnum::UNKNOWN) {
+        return 0;
+    }
+    return m_byType[getIndex(type)].list.size();
+}
+
+size_t GmcpDispatcher::getNumModuleSubscribers(const std::string_view moduleName) const
+{
+    const auto it = m_byModule.find(normalizeModuleName(moduleName));
+    return (it == m_byModule.end()) ? 0 : it->second.list.size();
+}
+
+namespace gmcp_dispatch_stats {
+
+perf_stats::HistogramSnapshot getSnapshot(const GmcpMessageTypeEnum type)
+{
+    return g_histograms[getIndex(type)].getSnapshot();
+}
+
+void reset()
+{
+    for (auto &histogram : g_histograms) {
+        histogram.reset();
+    }
+}
+
+void report(AnsiOstream &aos)
+{
+    aos << "GMCP handler time per message type:\n";
+    bool any = false;
+    for (const GmcpMessageTypeEnum type : ALL_GMCP_MESSAGE_TYPES) {
+        const auto snapshot = getSnapshot(type);
+        if (snapshot.count == 0) {
+            continue;
+        }
+        any = true;
+
+        aos << "  ";
+        perf_stats::reportSummary(aos, getFriendlyName(type), "messages", snapshot);
+    }
+    if (!any) {
+        aos << "  (no samples)\n";
+    }
+}
+
+} // namespace gmcp_dispatch_stats
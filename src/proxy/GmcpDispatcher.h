@@ -0,0 +1,85 @@
+#pragma once
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "../global/PerfStats.h"
+#include "../global/RuleOf5.h"
+#include "../global/Signal2.h"
+#include "GmcpMessage.h"
+
+#include <array>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class AnsiOstream;
+
+// Hands each GMCP message only to the handlers that subscribed to its type, instead of
+// offering every message to every consumer and letting each one ignore most of them.
+//
+// Messages that aren't in XFOREACH_GMCP_MESSAGE_TYPE (i.e. GmcpMessageTypeEnum::UNKNOWN)
+// go to the handlers that subscribed to their module instead;
+// e.g. "Char.Items.List" goes to the subscribers of "Char.Items".
+//
+// Like Signal2, a handler is dropped once its lifetime expires; unlike Signal2, a handler that
+// throws is only logged, since one bad payload shouldn't cut a module off for the session.
+class NODISCARD GmcpDispatcher final
+{
+public:
+    using Handler = std::function<void(const GmcpMessage &)>;
+
+private:
+    struct NODISCARD Subscriber final
+    {
+        Handler handler;
+        std::weak_ptr<Signal2Lifetime::Obj> weak;
+    };
+    struct NODISCARD Subscribers final
+    {
+        std::vector<Subscriber> list;
+        bool invoking = false;
+    };
+
+private:
+    std::array<Subscribers, NUM_GMCP_MESSAGES> m_byType;
+    // keyed by the normalized (lowercase) module name
+    std::map<std::string, Subscribers, std::less<>> m_byModule;
+
+public:
+    GmcpDispatcher() = default;
+    ~GmcpDispatcher() = default;
+    DELETE_CTORS_AND_ASSIGN_OPS(GmcpDispatcher);
+
+public:
+    void subscribe(GmcpMessageTypeEnum type, const Signal2Lifetime &lifetime, Handler handler);
+    void subscribe(std::initializer_list<GmcpMessageTypeEnum> types,
+                   const Signal2Lifetime &lifetime,
+                   const Handler &handler);
+    void subscribeModule(std::string_view moduleName,
+                         const Signal2Lifetime &lifetime,
+                         Handler handler);
+
+public:
+    void dispatch(const GmcpMessage &msg);
+
+public:
+    // Note: Expired lifetimes are only noticed during dispatch().
+    NODISCARD size_t getNumSubscribers(GmcpMessageTypeEnum type) const;
+    NODISCARD size_t getNumModuleSubscribers(std::string_view moduleName) const;
+
+private:
+    void addSubscriber(Subscribers &subscribers, const Signal2Lifetime &lifetime, Handler handler);
+    NODISCARD Subscribers *findSubscribers(const GmcpMessage &msg);
+};
+
+// Time spent in the handlers for each message type, summed over every dispatcher.
+namespace gmcp_dispatch_stats {
+// GmcpMessageTypeEnum::UNKNOWN covers all of the messages dispatched by module name.
+NODISCARD extern perf_stats::HistogramSnapshot getSnapshot(GmcpMessageTypeEnum type);
+extern void reset();
+extern void report(AnsiOstream &aos);
+} // namespace gmcp_dispatch_stats
@@ -9,8 +9,26 @@
 #include "GmcpModule.h"
 #include "GmcpUtils.h"
 
+#include <mutex>
 #include <sstream>
 
+struct NODISCARD GmcpMessage::LazyDocument final
+{
+    std::once_flag once;
+    std::optional<GmcpJsonDocument> document;
+
+    // What getJsonView() found, as offsets into the payload rather than a view of it,
+    // since every copy of the message holds its own copy of the text.
+    struct NODISCARD ParsedView final
+    {
+        size_t offset = 0;
+        size_t length = 0;
+        JsonViewTypeEnum type = JsonViewTypeEnum::Null;
+    };
+    std::once_flag viewOnce;
+    std::optional<ParsedView> view;
+};
+
 // REVISIT: use cached boxed type to avoid some allocations here?
 NODISCARD static GmcpMessageName toGmcpMessageName(const GmcpMessageTypeEnum type)
 {
@@ -57,7 +75,7 @@ GmcpMessage::GmcpMessage(GmcpMessageName moved_package)
 GmcpMessage::GmcpMessage(GmcpMessageName moved_package, GmcpJson moved_json)
     : m_name{std::move(moved_package)}
     , m_json{std::move(moved_json)}
-    , m_document{m_json.value()}
+    , m_document{std::make_shared<LazyDocument>()}
     , m_type{toGmcpMessageType(m_name.getStdStringUtf8())}
 {}
 
@@ -65,6 +83,42 @@ GmcpMessage::GmcpMessage(const GmcpMessageTypeEnum type, GmcpJson moved_json)
     : GmcpMessage{toGmcpMessageName(type), std::move(moved_json)}
 {}
 
+const std::optional<GmcpJsonDocument> &GmcpMessage::getJsonDocument() const
+{
+    static const std::optional<GmcpJsonDocument> noDocument;
+    if (m_document == nullptr) {
+        return noDocument;
+    }
+
+    auto &lazy = *m_document;
+    std::call_once(lazy.once, [this, &lazy]() { lazy.document.emplace(m_json.value()); });
+    return lazy.document;
+}
+
+std::optional<JsonValueView> GmcpMessage::getJsonView() const
+{
+    if (!m_json || m_document == nullptr) {
+        return std::nullopt;
+    }
+
+    const std::string_view json = m_json->getStdStringViewUtf8();
+    auto &lazy = *m_document;
+    std::call_once(lazy.viewOnce, [&lazy, json]() {
+        if (const auto view = JsonValueView::parse(json)) {
+            const std::string_view raw = view->getRaw();
+            lazy.view = LazyDocument::ParsedView{static_cast<size_t>(raw.data() - json.data()),
+                                                 raw.size(),
+                                                 view->getType()};
+        }
+    });
+
+    if (!lazy.view) {
+        return std::nullopt;
+    }
+    const auto &parsed = lazy.view.value();
+    return JsonValueView{json.substr(parsed.offset, parsed.length), parsed.type};
+}
+
 QByteArray GmcpMessage::toRawBytes() const
 {
     std::ostringstream oss;
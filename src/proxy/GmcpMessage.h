@@ -4,9 +4,11 @@
 
 #include "../global/Flags.h"
 #include "../global/JsonDoc.h"
+#include "../global/JsonView.h"
 #include "../global/TaggedString.h"
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 
@@ -90,10 +92,15 @@ using GmcpJsonDocument = JsonDoc<tags::GmcpJsonTag>;
 
 class NODISCARD GmcpMessage final
 {
+private:
+    // Parsed the first time someone asks for it (as a document or as a view),
+    // and shared by all copies of the message.
+    struct LazyDocument;
+
 private:
     GmcpMessageName m_name;
     std::optional<GmcpJson> m_json;
-    std::optional<GmcpJsonDocument> m_document;
+    std::shared_ptr<LazyDocument> m_document;
     GmcpMessageTypeEnum m_type = GmcpMessageTypeEnum::UNKNOWN;
 
 public:
@@ -113,9 +120,14 @@ class NODISCARD GmcpMessage final
 #undef X_DECL_GETTERS_AND_SETTERS
 
 public:
+    NODISCARD GmcpMessageTypeEnum getType() const { return m_type; }
     NODISCARD const GmcpMessageName &getName() const { return m_name; }
     NODISCARD const std::optional<GmcpJson> &getJson() const { return m_json; }
-    NODISCARD const std::optional<GmcpJsonDocument> &getJsonDocument() const { return m_document; }
+    // Prefer getJsonView() for hot messages; this builds a full QJsonDocument.
+    NODISCARD const std::optional<GmcpJsonDocument> &getJsonDocument() const;
+    // Returns nullopt if there's no payload or it isn't well-formed.
+    // CAUTION: The view points into this message, so it must not outlive it.
+    NODISCARD std::optional<JsonValueView> getJsonView() const;
 
 public:
     NODISCARD QByteArray toRawBytes() const;
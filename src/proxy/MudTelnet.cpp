@@ -7,6 +7,7 @@
 #include "../clock/mumeclock.h"
 #include "../global/Consts.h"
 #include "../global/LineUtils.h"
+#include "../global/PerfStats.h"
 #include "../global/SendToUser.h"
 #include "../global/TextUtils.h"
 #include "../global/Version.h"
@@ -295,6 +296,7 @@ void MudTelnet::onDisconnected()
 
 void MudTelnet::onAnalyzeMudStream(const TelnetIacBytes &data)
 {
+    DECL_PERF_TIMER(t, TelnetDecode);
     onReadInternal(data);
 }
 
@@ -424,7 +426,7 @@ void MudTelnet::onLoginCredentials(const QString &name, const QString &password)
                     GmcpJson{QString(R"({ "name": "%1", "password": "%2" })").arg(name, password)}));
 }
 
-void MudTelnet::virt_sendToMapper(const RawBytes &data, const bool goAhead)
+void MudTelnet::virt_sendToMapper(const RawSlice &data, const bool goAhead)
 {
     if (getDebug()) {
         qDebug() << "MudTelnet::virt_sendToMapper" << data;
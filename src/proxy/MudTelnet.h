@@ -23,7 +23,7 @@ struct NODISCARD MudTelnetOutputs
     virtual ~MudTelnetOutputs();
 
 public:
-    void onAnalyzeMudStream(const RawBytes &bytes, const bool goAhead)
+    void onAnalyzeMudStream(const RawSlice &bytes, const bool goAhead)
     {
         virt_onAnalyzeMudStream(bytes, goAhead);
     }
@@ -44,7 +44,7 @@ struct NODISCARD MudTelnetOutputs
     void onMumeClientError(const QString &errmsg) { virt_onMumeClientError(errmsg); }
 
 private:
-    virtual void virt_onAnalyzeMudStream(const RawBytes &, bool goAhead) = 0;
+    virtual void virt_onAnalyzeMudStream(const RawSlice &, bool goAhead) = 0;
     virtual void virt_onSendToSocket(const TelnetIacBytes &) = 0;
     virtual void virt_onRelayEchoMode(bool) = 0;
     virtual void virt_onRelayGmcpFromMudToUser(const GmcpMessage &) = 0;
@@ -73,7 +73,7 @@ class NODISCARD MudTelnet final : public AbstractTelnet
     ~MudTelnet() final = default;
 
 private:
-    void virt_sendToMapper(const RawBytes &data, bool goAhead) final;
+    void virt_sendToMapper(const RawSlice &data, bool goAhead) final;
     void virt_receiveEchoMode(bool toggle) final;
     void virt_receiveGmcpMessage(const GmcpMessage &) final;
     void virt_receiveMudServerStatus(const TelnetMsspBytes &) final;
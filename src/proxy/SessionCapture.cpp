@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "SessionCapture.h"
+
+#include <algorithm>
+#include <array>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+
+namespace session_capture {
+
+namespace { // anonymous
+
+constexpr std::string_view HEADER = "# MMapper session capture v1\n";
+
+template<typename T>
+void writeLittleEndian(std::ostream &os, const T value)
+{
+    std::array<char, sizeof(T)> buf{};
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        buf[i] = static_cast<char>(static_cast<uint8_t>(value >> (8u * i)));
+    }
+    os.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+}
+
+// Returns false at the end of the input.
+template<typename T>
+NODISCARD bool readLittleEndian(std::istream &is, T &value)
+{
+    std::array<char, sizeof(T)> buf{};
+    is.read(buf.data(), static_cast<std::streamsize>(buf.size()));
+    if (is.gcount() == 0 && is.eof()) {
+        return false;
+    }
+    if (static_cast<size_t>(is.gcount()) != buf.size()) {
+        throw std::runtime_error("truncated session capture record");
+    }
+    value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value = static_cast<T>(value | (static_cast<T>(static_cast<uint8_t>(buf[i])) << (8u * i)));
+    }
+    return true;
+}
+
+} // namespace
+
+void writeHeader(std::ostream &os)
+{
+    os.write(HEADER.data(), static_cast<std::streamsize>(HEADER.size()));
+}
+
+void write(std::ostream &os, const std::chrono::microseconds time, const TelnetIacBytes &bytes)
+{
+    const auto size = bytes.size();
+    if (size < 0 || static_cast<uint64_t>(size) > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("chunk is too large");
+    }
+    writeLittleEndian(os, static_cast<uint64_t>(std::max<int64_t>(0, time.count())));
+    writeLittleEndian(os, static_cast<uint32_t>(size));
+    os.write(bytes.getQByteArray().constData(), static_cast<std::streamsize>(size));
+}
+
+std::vector<Chunk> read(std::istream &is)
+{
+    std::string header(HEADER.size(), '\0');
+    is.read(header.data(), static_cast<std::streamsize>(header.size()));
+    if (header != HEADER) {
+        throw std::runtime_error("not a session capture");
+    }
+
+    std::vector<Chunk> result;
+    uint64_t time = 0;
+    while (readLittleEndian(is, time)) {
+        uint32_t size = 0;
+        if (!readLittleEndian(is, size)) {
+            throw std::runtime_error("truncated session capture record");
+        }
+
+        QByteArray bytes{static_cast<qsizetype>(size), '\0'};
+        is.read(bytes.data(), static_cast<std::streamsize>(size));
+        if (static_cast<uint64_t>(is.gcount()) != size) {
+            throw std::runtime_error("truncated session capture record");
+        }
+
+        const auto us = std::chrono::microseconds{static_cast<int64_t>(time)};
+        if (!result.empty() && us < result.back().time) {
+            throw std::runtime_error("session capture timestamps go backwards");
+        }
+        result.emplace_back(Chunk{us, TelnetIacBytes{std::move(bytes)}});
+    }
+    return result;
+}
+
+} // namespace session_capture
+
+SessionRecorder::SessionRecorder(const std::string &filename)
+    : m_file{filename, std::ios::out | std::ios::trunc | std::ios::binary}
+{
+    if (m_file.is_open()) {
+        session_capture::writeHeader(m_file);
+    }
+}
+
+void SessionRecorder::record(const TelnetIacBytes &bytes)
+{
+    if (!isOpen() || bytes.isEmpty()) {
+        return;
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now()
+                                                                                - m_start);
+    session_capture::write(m_file, elapsed, bytes);
+
+    // Flush per chunk, so the capture survives a crash in the code being measured.
+    m_file.flush();
+}
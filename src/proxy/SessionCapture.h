@@ -0,0 +1,62 @@
+#pragma once
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "../global/RuleOf5.h"
+#include "../global/macros.h"
+#include "TaggedBytes.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/*! \brief Recording of the raw bytes received from the MUD, exactly as they arrived.
+ *
+ * The bytes are captured before the telnet layer sees them, so a capture includes the
+ * telnet negotiation and any MCCP-compressed stream, and replaying it exercises the
+ * whole inbound pipeline. The replay tool (tests/ReplaySession.cpp) serves a capture
+ * as a stand-in MUD.
+ *
+ * The file starts with a header line, followed by one binary record per chunk that was
+ * read from the socket: the time since the capture began (uint64 microseconds), the
+ * length (uint32), then the bytes themselves. Integers are little-endian.
+ *
+ * Set the MMAPPER_RECORD_SESSION environment variable to a file name to record
+ * a live session; each new connection to the MUD starts the file over.
+ */
+namespace session_capture {
+
+static constexpr const char *const RECORD_ENV_VAR = "MMAPPER_RECORD_SESSION";
+
+struct NODISCARD Chunk final
+{
+    std::chrono::microseconds time{};
+    TelnetIacBytes bytes;
+};
+
+extern void writeHeader(std::ostream &os);
+extern void write(std::ostream &os, std::chrono::microseconds time, const TelnetIacBytes &bytes);
+
+// NOTE: This throws std::runtime_error if the input is malformed.
+NODISCARD extern std::vector<Chunk> read(std::istream &is);
+
+} // namespace session_capture
+
+class NODISCARD SessionRecorder final
+{
+private:
+    using Clock = std::chrono::steady_clock;
+    std::ofstream m_file;
+    Clock::time_point m_start = Clock::now();
+
+public:
+    explicit SessionRecorder(const std::string &filename);
+    DELETE_CTORS_AND_ASSIGN_OPS(SessionRecorder);
+
+public:
+    NODISCARD bool isOpen() const { return m_file.is_open() && m_file.good(); }
+    void record(const TelnetIacBytes &bytes);
+};
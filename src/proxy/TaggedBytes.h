@@ -5,7 +5,11 @@
 #include "../global/macros.h"
 #include "../global/utils.h"
 
+#include <cassert>
+#include <string_view>
+
 #include <QByteArray>
+#include <QByteArrayView>
 #include <QDebug>
 
 // clang-format off
@@ -86,9 +90,98 @@ struct NODISCARD TaggedBytes : private QByteArray
     }
 };
 
+// Read-only window into the reference-counted buffer of a TaggedBytes.
+//
+// Slicing shares the buffer instead of copying it, so stages of the proxy pipeline
+// can split their input and pass the pieces along; the bytes are only copied if
+// someone asks for a QByteArray of a partial slice.
+template<typename Tag>
+class NODISCARD TaggedBytesSlice final
+{
+private:
+    // never modified, so copies of it keep sharing the same storage
+    QByteArray m_buffer;
+    qsizetype m_offset = 0;
+    qsizetype m_length = 0;
+
+public:
+    TaggedBytesSlice() = default;
+    explicit TaggedBytesSlice(const TaggedBytes<Tag> &bytes)
+        : m_buffer{bytes.getQByteArray()}
+        , m_length{m_buffer.size()}
+    {}
+    explicit TaggedBytesSlice(const TaggedBytes<Tag> &bytes,
+                              const qsizetype offset,
+                              const qsizetype length)
+        : m_buffer{bytes.getQByteArray()}
+        , m_offset{offset}
+        , m_length{length}
+    {
+        assert(0 <= offset && 0 <= length && offset + length <= m_buffer.size());
+    }
+
+public:
+    NODISCARD const char *data() const { return m_buffer.constData() + m_offset; }
+    NODISCARD qsizetype size() const { return m_length; }
+    NODISCARD bool isEmpty() const { return m_length == 0; }
+    NODISCARD char at(const qsizetype pos) const
+    {
+        assert(0 <= pos && pos < m_length);
+        return data()[pos];
+    }
+    NODISCARD char back() const { return at(m_length - 1); }
+
+    NODISCARD const char *begin() const { return data(); }
+    NODISCARD const char *end() const { return data() + m_length; }
+
+public:
+    NODISCARD TaggedBytesSlice mid(const qsizetype pos, const qsizetype len) const
+    {
+        assert(0 <= pos && 0 <= len && pos + len <= m_length);
+        TaggedBytesSlice result = *this;
+        result.m_offset += pos;
+        result.m_length = len;
+        return result;
+    }
+    NODISCARD TaggedBytesSlice mid(const qsizetype pos) const { return mid(pos, m_length - pos); }
+
+public:
+    NODISCARD QByteArrayView getQByteArrayView() const { return QByteArrayView{data(), m_length}; }
+    NODISCARD std::string_view getStdStringView() const
+    {
+        return std::string_view{data(), static_cast<size_t>(m_length)};
+    }
+
+    // Shares the buffer if the slice covers all of it; otherwise copies.
+    NODISCARD QByteArray toQByteArray() const
+    {
+        if (m_offset == 0 && m_length == m_buffer.size()) {
+            return m_buffer;
+        }
+        return QByteArray{data(), m_length};
+    }
+    NODISCARD TaggedBytes<Tag> toBytes() const { return TaggedBytes<Tag>{toQByteArray()}; }
+
+public:
+    NODISCARD friend bool operator==(const TaggedBytesSlice &a, const TaggedBytesSlice &b)
+    {
+        return a.getQByteArrayView() == b.getQByteArrayView();
+    }
+    NODISCARD friend bool operator!=(const TaggedBytesSlice &a, const TaggedBytesSlice &b)
+    {
+        return !(a == b);
+    }
+    friend QDebug operator<<(QDebug debug, const TaggedBytesSlice &slice)
+    {
+        return debug << slice.getQByteArrayView();
+    }
+};
+
 // These are registered in metatypes.cpp
 
-#define X_DECL_TAGGED_BYTES(name) using name##Bytes = TaggedBytes<tags::Tag##name##Bytes>;
+#define X_DECL_TAGGED_BYTES(name) \
+    using name##Bytes = TaggedBytes<tags::Tag##name##Bytes>; \
+    using name##Slice = TaggedBytesSlice<tags::Tag##name##Bytes>;
 XFOREACH_TAGGED_BYTE_TYPES(X_DECL_TAGGED_BYTES)
 #undef X_DECL_TAGGED_BYTES
 
@@ -112,6 +112,10 @@ void UserTelnet::onSendToUser(const QString &s, const bool goAhead)
 {
     auto outdata = normalizeForUser(getEncoding(), s, goAhead);
     submitOverTelnet(outdata, goAhead);
+    if (goAhead) {
+        // Don't make the user wait for the rest of the event loop to see the prompt.
+        m_outputs.onFlushSocket();
+    }
 }
 
 void UserTelnet::onGmcpToUser(const GmcpMessage &msg)
@@ -142,9 +146,9 @@ void UserTelnet::onSendMSSPToUser(const TelnetMsspBytes &data)
     sendMudServerStatus(data);
 }
 
-void UserTelnet::virt_sendToMapper(const RawBytes &data, const bool goAhead)
+void UserTelnet::virt_sendToMapper(const RawSlice &data, const bool goAhead)
 {
-    m_outputs.onAnalyzeUserStream(decodeFromUser(getEncoding(), data), goAhead);
+    m_outputs.onAnalyzeUserStream(decodeFromUser(getEncoding(), data.toBytes()), goAhead);
 }
 
 void UserTelnet::onRelayEchoMode(const bool isDisabled)
@@ -20,6 +20,7 @@ struct NODISCARD UserTelnetOutputs
         virt_onAnalyzeUserStream(bytes, goAhead);
     }
     void onSendToSocket(const TelnetIacBytes &bytes) { virt_onSendToSocket(bytes); }
+    void onFlushSocket() { virt_onFlushSocket(); }
     void onRelayGmcpFromUserToMud(const GmcpMessage &msg) { virt_onRelayGmcpFromUserToMud(msg); }
     void onRelayNawsFromUserToMud(const int width, const int height)
     {
@@ -33,6 +34,7 @@ struct NODISCARD UserTelnetOutputs
 private:
     virtual void virt_onAnalyzeUserStream(const RawBytes &, bool) = 0;
     virtual void virt_onSendToSocket(const TelnetIacBytes &) = 0;
+    virtual void virt_onFlushSocket() = 0;
     virtual void virt_onRelayGmcpFromUserToMud(const GmcpMessage &) = 0;
     virtual void virt_onRelayNawsFromUserToMud(int, int) = 0;
     virtual void virt_onRelayTermTypeFromUserToMud(const TelnetTermTypeBytes &) = 0;
@@ -59,7 +61,7 @@ class NODISCARD UserTelnet final : public AbstractTelnet
 
 private:
     NODISCARD bool virt_isGmcpModuleEnabled(const GmcpModuleTypeEnum &name) const final;
-    void virt_sendToMapper(const RawBytes &data, bool goAhead) final;
+    void virt_sendToMapper(const RawSlice &data, bool goAhead) final;
     void virt_receiveGmcpMessage(const GmcpMessage &) final;
     void virt_receiveTerminalType(const TelnetTermTypeBytes &) final;
     void virt_receiveWindowSize(int, int) final;
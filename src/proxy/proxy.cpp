@@ -30,6 +30,7 @@
 #include "../roompanel/RoomManager.h"
 #include "AbstractSocket.h"
 #include "MudTelnet.h"
+#include "SessionCapture.h"
 #include "UserTelnet.h"
 #include "connectionlistener.h"
 #include "mumesocket.h"
@@ -46,6 +47,7 @@
 #include <QScopedPointer>
 #include <QSslSocket>
 #include <QTcpSocket>
+#include <QTimer>
 
 using mmqt::makeQPointer;
 
@@ -95,6 +97,10 @@ class NODISCARD Proxy::UserSocket final : public QObject
     // disconnectFromHost/sendToSocket to handle a null socket gracefully after teardown.
     AbstractSocketGetter m_get_socket;
     Proxy::UserSocketOutputs &m_outputs;
+    // Output produced while handling one event (parsed lines, prompts, injected messages)
+    // is gathered here and written once the event loop is idle again, or sooner on a prompt.
+    QByteArray m_pending;
+    QTimer m_flushTimer;
 
 public:
     explicit UserSocket(AbstractSocketGetter get_socket, QObject *parent, UserSocketOutputs &outputs)
@@ -102,6 +108,9 @@ class NODISCARD Proxy::UserSocket final : public QObject
         , m_get_socket{std::move(get_socket)}
         , m_outputs{outputs}
     {
+        m_flushTimer.setSingleShot(true);
+        m_flushTimer.setInterval(0);
+        QObject::connect(&m_flushTimer, &QTimer::timeout, this, [this]() { flushPending(); });
         QObject::connect(getSocket(), &AbstractSocket::sig_disconnected, this, [this]() {
             m_outputs.onDisconnected();
         });
@@ -117,6 +126,7 @@ class NODISCARD Proxy::UserSocket final : public QObject
 public:
     void disconnectFromHost()
     {
+        flushPending();
         auto *const pSocket = getSocket();
         if (pSocket == nullptr) {
             qWarning() << "tried to disconnect from a non-existent user socket";
@@ -138,7 +148,27 @@ class NODISCARD Proxy::UserSocket final : public QObject
             qWarning() << "tried to send bytes to closed user socket";
             return;
         }
-        socket.write(bytes.getQByteArray());
+        m_pending.append(bytes.getQByteArray());
+        if (!m_flushTimer.isActive()) {
+            m_flushTimer.start();
+        }
+    }
+    void flushPending()
+    {
+        m_flushTimer.stop();
+        if (m_pending.isEmpty()) {
+            return;
+        }
+        auto *const pSocket = getSocket();
+        if (pSocket == nullptr || !pSocket->isConnected()) {
+            m_pending.clear();
+            return;
+        }
+        auto &socket = deref(pSocket);
+        socket.write(m_pending);
+        socket.flush();
+        // resize() keeps the allocation for the next batch.
+        m_pending.resize(0);
     }
 };
 
@@ -256,6 +286,7 @@ void Proxy::allocPipelineObjects()
     allocRemoteEdit();
 
     allocParser();
+    allocGmcpDispatcher();
 
     auto &lifetime = getPipeline().apis.sendToUserLifetime.emplace();
     global::registerSendToUser(lifetime, [this](const QString &str) {
@@ -361,6 +392,7 @@ void Proxy::allocMudSocket()
 
         void virt_onProcessMudStream(const TelnetIacBytes &bytes) final
         {
+            getProxy().captureMudStream(bytes);
             getMudTelnet().onAnalyzeMudStream(bytes);
         }
 
@@ -415,6 +447,7 @@ void Proxy::allocUserTelnet()
             // outbound (to user)
             getUserSocket().sendToSocket(bytes);
         }
+        void virt_onFlushSocket() final { getUserSocket().flushPending(); }
         void virt_onRelayGmcpFromUserToMud(const GmcpMessage &gmcp) final
         {
             // forwarded (to mud)
@@ -466,13 +499,12 @@ void Proxy::allocMudTelnet()
         NODISCARD Proxy &getProxy() { return m_proxy; }
         NODISCARD TelnetLineFilter &getMudTelnetFilter() { return getProxy().getMudTelnetFilter(); }
         NODISCARD UserTelnet &getUserTelnet() { return getProxy().getUserTelnet(); }
-        NODISCARD MumeXmlParser &getMudParser() { return getProxy().getMudParser(); }
-        NODISCARD Mmapper2Group &getGroupManager() { return getProxy().getGroupManager(); }
+        NODISCARD GmcpDispatcher &getGmcpDispatcher() { return getProxy().getGmcpDispatcher(); }
         NODISCARD MumeClock &getMumeClock() { return getProxy().getMumeClock(); }
         NODISCARD GameObserver &getGameObserver() { return getProxy().getGameObserver(); }
 
     private:
-        void virt_onAnalyzeMudStream(const RawBytes &bytes, bool goAhead) final
+        void virt_onAnalyzeMudStream(const RawSlice &bytes, bool goAhead) final
         {
             // inbound (from mud)
             getMudTelnetFilter().receive(bytes, goAhead);
@@ -505,9 +537,7 @@ void Proxy::allocMudTelnet()
             // forwarded (to user)
             getUserTelnet().onGmcpToUser(msg);
 
-            // REVISIT: should parser be first?
-            getGroupManager().slot_parseGmcpInput(msg);
-            getMudParser().slot_parseGmcpInput(msg);
+            getGmcpDispatcher().dispatch(msg);
             getGameObserver().observeSentToUserGmcp(msg);
         }
 
@@ -774,6 +804,35 @@ void Proxy::allocParser()
                      });
 }
 
+void Proxy::allocGmcpDispatcher()
+{
+    auto &pipe = getPipeline();
+    pipe.mud.gmcpDispatcher = std::make_unique<GmcpDispatcher>();
+    auto &dispatcher = deref(pipe.mud.gmcpDispatcher);
+
+    // REVISIT: should parser be first?
+    dispatcher.subscribe({GmcpMessageTypeEnum::CHAR_NAME,
+                          GmcpMessageTypeEnum::CHAR_STATUSVARS,
+                          GmcpMessageTypeEnum::CHAR_VITALS,
+                          GmcpMessageTypeEnum::GROUP_ADD,
+                          GmcpMessageTypeEnum::GROUP_REMOVE,
+                          GmcpMessageTypeEnum::GROUP_SET,
+                          GmcpMessageTypeEnum::GROUP_UPDATE,
+                          GmcpMessageTypeEnum::ROOM_INFO},
+                         m_lifetime,
+                         [this](const GmcpMessage &msg) {
+                             getGroupManager().slot_parseGmcpInput(msg);
+                         });
+    dispatcher.subscribe({GmcpMessageTypeEnum::CHAR_STATUSVARS,
+                          GmcpMessageTypeEnum::CHAR_VITALS,
+                          GmcpMessageTypeEnum::EVENT_MOVED,
+                          GmcpMessageTypeEnum::ROOM_INFO},
+                         m_lifetime,
+                         [this](const GmcpMessage &msg) {
+                             getMudParser().slot_parseGmcpInput(msg);
+                         });
+}
+
 void Proxy::allocMpiFilter()
 {
     struct NODISCARD LocalMpiFilterOutputs final : public MpiFilterOutputs
@@ -924,6 +983,34 @@ void Proxy::onMudConnected()
 
     // Reset clock precision to its lowest level
     m_mumeClock.setPrecision(MumeClockPrecisionEnum::UNSET);
+
+    startSessionCapture();
+}
+
+void Proxy::startSessionCapture()
+{
+    auto &recorder = getPipeline().mud.sessionRecorder;
+    recorder.reset();
+    if (!qEnvironmentVariableIsSet(session_capture::RECORD_ENV_VAR)) {
+        return;
+    }
+
+    const QString filename = qEnvironmentVariable(session_capture::RECORD_ENV_VAR);
+    auto newRecorder = std::make_unique<SessionRecorder>(mmqt::toStdStringUtf8(filename));
+    if (!newRecorder->isOpen()) {
+        qWarning() << "Unable to record the session to" << filename;
+        return;
+    }
+
+    qInfo() << "Recording the session to" << filename;
+    recorder = std::move(newRecorder);
+}
+
+void Proxy::captureMudStream(const TelnetIacBytes &bytes)
+{
+    if (auto &recorder = getPipeline().mud.sessionRecorder) {
+        recorder->record(bytes);
+    }
 }
 
 void Proxy::onMudError(const QString &errorStr)
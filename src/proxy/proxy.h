@@ -48,6 +48,7 @@ class ProxyUserGmcpApi;
 class QTcpSocket;
 class RemoteEdit;
 class RoomManager;
+class SessionRecorder;
 class TelnetLineFilter;
 class UserTelnet;
 class AbstractSocket;
@@ -137,7 +138,9 @@ class NODISCARD_QOBJECT Proxy final : public QObject
             std::unique_ptr<MpiFilter> mpiFilterFromMud;
             std::unique_ptr<MpiFilterToMud> mpiFilterToMud;
             std::unique_ptr<MumeXmlParser> mudParser;
+            std::unique_ptr<GmcpDispatcher> gmcpDispatcher;
             std::unique_ptr<PasswordConfig> passwordConfig;
+            std::unique_ptr<SessionRecorder> sessionRecorder;
         };
         Mud mud;
 
@@ -204,6 +207,7 @@ class NODISCARD_QOBJECT Proxy final : public QObject
     void allocUserTelnet();
     void allocMudTelnet();
     void allocParser();
+    void allocGmcpDispatcher();
     void allocMpiFilter();
     void allocRemoteEdit();
 
@@ -215,6 +219,8 @@ class NODISCARD_QOBJECT Proxy final : public QObject
     void onMudConnected();
     void onMudError(const QString &);
     void mudTerminatedConnection();
+    void startSessionCapture();
+    void captureMudStream(const TelnetIacBytes &bytes);
 
 private:
     friend ProxyMudConnectionApi;
@@ -313,6 +319,10 @@ class NODISCARD_QOBJECT Proxy final : public QObject
     }
     NODISCARD RemoteEdit &getRemoteEdit();
     NODISCARD MumeXmlParser &getMudParser() { return deref(getPipeline().mud.mudParser); }
+    NODISCARD GmcpDispatcher &getGmcpDispatcher()
+    {
+        return deref(getPipeline().mud.gmcpDispatcher);
+    }
     NODISCARD AbstractParser &getUserParser() { return deref(getPipeline().user.userParser); }
     NODISCARD PasswordConfig &getPasswordConfig()
     {
@@ -12,21 +12,23 @@
 #include "../global/tests.h"
 
 #include <iostream>
+#include <utility>
+#include <vector>
 
 #include <QByteArray>
 
 namespace { // anonymous
-NODISCARD bool isBackspace(const RawBytes &bytes)
+NODISCARD bool isBackspace(const RawSlice &bytes)
 {
     return !bytes.isEmpty() && bytes.back() == char_consts::C_BACKSPACE;
 }
 
-NODISCARD bool isNewline(const RawBytes &bytes)
+NODISCARD bool isNewline(const RawSlice &bytes)
 {
     return !bytes.isEmpty() && bytes.back() == char_consts::C_NEWLINE;
 }
 
-NODISCARD bool isCrlf(const RawBytes &bytes)
+NODISCARD bool isCrlf(const RawSlice &bytes)
 {
     return isNewline(bytes) && bytes.size() >= 2
            && bytes.at(bytes.size() - 2) == char_consts::C_CARRIAGE_RETURN;
@@ -39,74 +41,77 @@ bool TelnetLineFilter::endsWith(const char c) const
     return !m_buffer.isEmpty() && m_buffer.back() == c;
 }
 
-void TelnetLineFilter::fwd(const TelnetDataEnum type)
+RawSlice TelnetLineFilter::takeLine(const RawSlice &input,
+                                    const qsizetype begin,
+                                    const qsizetype end)
+{
+    if (m_buffer.isEmpty()) {
+        // The whole line arrived at once, so it can share the input's buffer.
+        return input.mid(begin, end - begin);
+    }
+
+    m_buffer.append(input.data() + begin, end - begin);
+    return RawSlice{std::exchange(m_buffer, RawBytes{})};
+}
+
+void TelnetLineFilter::fwd(const RawSlice &line, const TelnetDataEnum type)
 {
     if (IS_DEBUG_BUILD) {
         switch (type) {
         case TelnetDataEnum::Empty:
-            assert(m_buffer.isEmpty());
+            assert(line.isEmpty());
             break;
         case TelnetDataEnum::Prompt:
-            assert(!isNewline(m_buffer));
+            assert(!isNewline(line));
             break;
         case TelnetDataEnum::CRLF:
-            assert(isCrlf(m_buffer));
+            assert(isCrlf(line));
             break;
         case TelnetDataEnum::LF:
-            assert(isNewline(m_buffer) && !isCrlf(m_buffer));
+            assert(isNewline(line) && !isCrlf(line));
             break;
         case TelnetDataEnum::Backspace:
             assert(m_reportBackspaces == OptionBackspacesEnum::Yes);
-            assert(isBackspace(m_buffer));
+            assert(isBackspace(line));
             break;
         }
     }
 
     if (m_callback != nullptr) {
-        try {
-            m_callback(TelnetData{m_buffer, type});
-        } catch (...) {
-            m_buffer.clear();
-            throw;
-        }
+        m_callback(TelnetData{line, type});
     }
-    m_buffer.clear();
 }
 
-void TelnetLineFilter::receive(const RawBytes &input, const bool goAhead)
+void TelnetLineFilter::receive(const RawSlice &all, const bool goAhead)
 {
     using namespace char_consts;
 
-    for (const char c : input) {
-        switch (c) {
-        case C_BACKSPACE:
-            m_buffer += c;
-            if (m_reportBackspaces == OptionBackspacesEnum::Yes) {
-                fwd(TelnetDataEnum::Backspace);
-            }
-            break;
-
-        case C_CARRIAGE_RETURN:
-            m_buffer += c;
-            break;
-
-        case C_NEWLINE: {
-            const bool wasCr = endsWith(C_CARRIAGE_RETURN);
-            m_buffer += c;
-            fwd(wasCr ? TelnetDataEnum::CRLF : TelnetDataEnum::LF);
-            break;
-        }
-
-        default:
-            m_buffer += c;
-            break;
+    const qsizetype size = all.size();
+    const bool reportBackspaces = m_reportBackspaces == OptionBackspacesEnum::Yes;
+
+    // bytes before this have been forwarded
+    qsizetype begin = 0;
+    for (qsizetype i = 0; i < size; ++i) {
+        const char c = all.at(i);
+        if (c == C_NEWLINE) {
+            const bool wasCr = (i > begin) ? (all.at(i - 1) == C_CARRIAGE_RETURN)
+                                           : endsWith(C_CARRIAGE_RETURN);
+            const auto line = takeLine(all, begin, i + 1);
+            begin = i + 1;
+            fwd(line, wasCr ? TelnetDataEnum::CRLF : TelnetDataEnum::LF);
+        } else if (c == C_BACKSPACE && reportBackspaces) {
+            const auto line = takeLine(all, begin, i + 1);
+            begin = i + 1;
+            fwd(line, TelnetDataEnum::Backspace);
         }
     }
 
-    if (!m_buffer.isEmpty() && goAhead) {
+    if (goAhead && (begin < size || !m_buffer.isEmpty())) {
         // This should work fine with utf8 as long as a multibyte codepoints aren't split
         // by an IAC GA.
-        fwd(TelnetDataEnum::Prompt);
+        fwd(takeLine(all, begin, size), TelnetDataEnum::Prompt);
+    } else if (begin < size) {
+        m_buffer.append(all.data() + begin, size - begin);
     }
 }
 
@@ -151,7 +156,7 @@ void test_telnetfilter()
         {
             TEST_ASSERT(m_results.size() > n);
             const auto &data = m_results[n];
-            TEST_ASSERT(data.line.getQByteArray() == expect_line);
+            TEST_ASSERT(data.line.toQByteArray() == expect_line);
             TEST_ASSERT(data.type == expect_type);
         }
 
@@ -162,7 +167,7 @@ void test_telnetfilter()
             for (const TelnetData &data : m_results) {
                 os << "[" << n++ << "] = ";
 
-                print_string_quoted(os, data.line.getQByteArray().toStdString());
+                print_string_quoted(os, data.line.getStdStringView());
 #define X_CASE(x) \
     case TelnetDataEnum::x: \
         os << " with " << #x; \
@@ -274,6 +279,24 @@ void test_telnetfilter()
         fromUser.verify_result(4, "3\b4\r\n", TelnetDataEnum::CRLF);
         fromUser.verify_result(5, "5", TelnetDataEnum::Prompt);
     }
+
+    {
+        // complete lines share the input buffer; a CR at the end of one receive
+        // is still paired with the LF at the start of the next.
+        const RawBytes input{"abc\r\ndef\r"};
+        std::vector<TelnetData> results;
+        TelnetLineFilter filter{TelnetLineFilter::OptionBackspacesEnum::Yes,
+                                [&results](const TelnetData &data) { results.push_back(data); }};
+        filter.receive(input, false);
+        filter.receive(RawBytes{"\nghi"}, true);
+        TEST_ASSERT(results.size() == 3);
+        TEST_ASSERT(results[0].line.data() == input.getQByteArray().constData());
+        TEST_ASSERT(results[0].line.toQByteArray() == "abc\r\n");
+        TEST_ASSERT(results[1].line.toQByteArray() == "def\r\n");
+        TEST_ASSERT(results[1].type == TelnetDataEnum::CRLF);
+        TEST_ASSERT(results[2].line.toQByteArray() == "ghi");
+        TEST_ASSERT(results[2].type == TelnetDataEnum::Prompt);
+    }
 }
 
 } // namespace test
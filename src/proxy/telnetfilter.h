@@ -14,7 +14,8 @@ enum class NODISCARD TelnetDataEnum : uint8_t { Empty, Prompt, CRLF, LF, Backspa
 
 struct NODISCARD TelnetData final
 {
-    RawBytes line;
+    // Usually shares the buffer the line was received in.
+    RawSlice line;
     TelnetDataEnum type = TelnetDataEnum::Empty;
 };
 
@@ -39,10 +40,12 @@ class NODISCARD TelnetLineFilter final
 
 private:
     NODISCARD bool endsWith(char c) const;
-    void fwd(TelnetDataEnum);
+    NODISCARD RawSlice takeLine(const RawSlice &input, qsizetype begin, qsizetype end);
+    void fwd(const RawSlice &line, TelnetDataEnum);
 
 public:
-    void receive(const RawBytes &input, bool goAhead);
+    void receive(const RawSlice &input, bool goAhead);
+    void receive(const RawBytes &input, const bool goAhead) { receive(RawSlice{input}, goAhead); }
 };
 
 namespace test {
@@ -6,12 +6,15 @@
 
 #include "../global/Consts.h"
 #include "../global/StringView.h"
+#include "../global/TextUtils.h"
 #include "../global/float_cast.h"
 #include "../proxy/GmcpMessage.h"
 #include "RoomMobs.h"
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include <QtCore>
@@ -49,7 +52,9 @@ void RoomManager::slot_parseGmcpInput(const GmcpMessage &msg)
 void RoomManager::parseGmcpAdd(const GmcpMessage &msg)
 {
     showGmcp(msg);
-    if (!msg.getJsonDocument().has_value() || !msg.getJsonDocument()->getObject()) {
+    const auto optView = msg.getJsonView();
+    const auto optObj = optView ? optView->getObject() : std::nullopt;
+    if (!optObj) {
         if (m_debug) {
             qWarning().noquote() << "RoomManager received GMCP" << msg.getName().toQString()
                                  << "containing invalid Json: expecting object, got"
@@ -58,22 +63,21 @@ void RoomManager::parseGmcpAdd(const GmcpMessage &msg)
         return;
     }
 
-    auto obj = msg.getJsonDocument()->getObject().value();
-    addMob(obj);
+    addMob(optObj.value());
 }
 
 void RoomManager::parseGmcpRemove(const GmcpMessage &msg)
 {
     showGmcp(msg);
     // payload is a single number (usually followed by a space), not an array or object
-    // thus parsed msg.getDocument() is not valid: use msg.getJson() instead
     if (!msg.getJson() || msg.getJson()->getStdStringUtf8().empty()) {
         qWarning().noquote() << "RoomManager received GMCP" << msg.getName().toQString()
                              << "containing invalid empty payload: expecting number";
         return;
     }
-    auto optNum = msg.getJsonDocument()->getInt();
-    if (!optNum || optNum.value() <= static_cast<JsonInt>(RoomMobData::NOID)) {
+    const auto optView = msg.getJsonView();
+    const auto optNum = optView ? optView->getInt() : std::nullopt;
+    if (!optNum || optNum.value() <= static_cast<int32_t>(RoomMobData::NOID)) {
         qWarning().noquote() << "RoomManager received GMCP" << msg.getName().toQString()
                              << "containing invalid payload: expecting unsigned number, got"
                              << msg.getJson()->toQString();
@@ -89,8 +93,9 @@ void RoomManager::parseGmcpSet(const GmcpMessage &msg)
 {
     showGmcp(msg);
 
-    const auto &doc = msg.getJsonDocument().value();
-    if (!doc.getArray()) {
+    const auto optView = msg.getJsonView();
+    const auto optArray = optView ? optView->getArray() : std::nullopt;
+    if (!optArray) {
         if (m_debug) {
             qWarning().noquote() << "RoomManager received GMCP" << msg.getName().toQString()
                                  << "containing invalid Json: expecting array, got"
@@ -99,8 +104,7 @@ void RoomManager::parseGmcpSet(const GmcpMessage &msg)
         return;
     }
     m_room.resetMobs();
-    auto array = doc.getArray().value();
-    for (const auto &entry : array) {
+    for (const JsonValueView &entry : optArray.value()) {
         if (auto optObj = entry.getObject()) {
             addMob(optObj.value());
         } else {
@@ -117,8 +121,9 @@ void RoomManager::parseGmcpSet(const GmcpMessage &msg)
 void RoomManager::parseGmcpUpdate(const GmcpMessage &msg)
 {
     showGmcp(msg);
-    const auto &doc = msg.getJsonDocument().value();
-    if (!doc.getObject()) {
+    const auto optView = msg.getJsonView();
+    const auto optObj = optView ? optView->getObject() : std::nullopt;
+    if (!optObj) {
         if (m_debug) {
             qWarning().noquote() << "RoomManager received GMCP" << msg.getName().toQString()
                                  << "containing invalid Json: expecting object, got"
@@ -126,10 +131,10 @@ void RoomManager::parseGmcpUpdate(const GmcpMessage &msg)
         }
         return;
     }
-    updateMob(doc.getObject().value());
+    updateMob(optObj.value());
 }
 
-void RoomManager::addMob(const JsonObj &obj)
+void RoomManager::addMob(const JsonObjView &obj)
 {
     RoomMobUpdate data;
     if (toMob(obj, data)) {
@@ -138,7 +143,7 @@ void RoomManager::addMob(const JsonObj &obj)
     }
 }
 
-void RoomManager::updateMob(const JsonObj &obj)
+void RoomManager::updateMob(const JsonObjView &obj)
 {
     RoomMobUpdate data;
     if (toMob(obj, data)) {
@@ -155,22 +160,32 @@ inline void RoomManager::showGmcp(const GmcpMessage &msg) const
     }
 }
 
-const QHash<QString, MobFieldEnum> RoomManager::mobFields{
-    {"name", MobFieldEnum::NAME},
-    {"desc", MobFieldEnum::DESC},
-    {"fighting", MobFieldEnum::FIGHTING},
-    {"flags", MobFieldEnum::FLAGS},
-    {"labels", MobFieldEnum::LABELS},
-    {"riding", MobFieldEnum::MOUNT},
-    {"driving", MobFieldEnum::MOUNT},
-    {"position", MobFieldEnum::POSITION},
-    {"weapon", MobFieldEnum::WEAPON},
-};
-
-bool RoomManager::toMob(const JsonObj &obj, RoomMobUpdate &data) const
+NODISCARD static std::optional<MobFieldEnum> toMobFieldEnum(const std::string_view key)
+{
+    if (key == "name") {
+        return MobFieldEnum::NAME;
+    } else if (key == "desc") {
+        return MobFieldEnum::DESC;
+    } else if (key == "fighting") {
+        return MobFieldEnum::FIGHTING;
+    } else if (key == "flags") {
+        return MobFieldEnum::FLAGS;
+    } else if (key == "labels") {
+        return MobFieldEnum::LABELS;
+    } else if (key == "riding" || key == "driving") {
+        return MobFieldEnum::MOUNT;
+    } else if (key == "position") {
+        return MobFieldEnum::POSITION;
+    } else if (key == "weapon") {
+        return MobFieldEnum::WEAPON;
+    }
+    return std::nullopt;
+}
+
+bool RoomManager::toMob(const JsonObjView &obj, RoomMobUpdate &data) const
 {
     auto optId = obj.getInt("id");
-    if (!optId || optId.value() <= static_cast<JsonInt>(RoomMobData::NOID)) {
+    if (!optId || optId.value() <= static_cast<int32_t>(RoomMobData::NOID)) {
         if (m_debug) {
             qWarning().noquote().nospace()
                 << "RoomManager received GMCP containing invalid Json object field ";
@@ -183,38 +198,38 @@ bool RoomManager::toMob(const JsonObj &obj, RoomMobUpdate &data) const
         return false;
     }
     data.setId(static_cast<RoomMob::Id>(optId.value()));
-    for (auto iter = obj.begin(); iter != obj.end(); ++iter) {
-        auto match = mobFields.constFind(iter.first());
-        if (match != mobFields.constEnd()) {
-            toMobField(iter.second(), data, *match);
+    for (auto iter = obj.begin(), end = obj.end(); iter != end; ++iter) {
+        if (const auto match = toMobFieldEnum(iter.rawKey())) {
+            toMobField(iter.value(), data, *match);
         } else if (m_debug) {
             qWarning().noquote() << "RoomManager received GMCP containing unknown Json object field {"
-                                 << iter.first() << "}";
+                                 << mmqt::toQStringUtf8(iter.rawKey()) << "}";
         }
     }
     return true;
 }
 
-void RoomManager::toMobField(const JsonValue &value, RoomMobUpdate &data, const MobFieldEnum i)
+void RoomManager::toMobField(const JsonValueView &value,
+                             RoomMobUpdate &data,
+                             const MobFieldEnum i)
 {
     if (auto optInt = value.getInt()) {
         data.setField(i, QVariant::fromValue(static_cast<RoomMobData::Id>(optInt.value())));
     } else if (auto optString = value.getString()) {
-        data.setField(i, QVariant::fromValue(optString.value()));
+        data.setField(i, QVariant::fromValue(mmqt::toQStringUtf8(optString.value())));
     } else if (auto optArray = value.getArray()) {
-        const auto arr = optArray.value();
-        QString str;
+        std::string str;
         // MUME sends flags and labels as an array of strings
-        for (const JsonValue &item : arr) {
+        for (const JsonValueView &item : optArray.value()) {
             optString = item.getString();
             if (!optString)
                 continue;
-            if (!str.isEmpty()) {
+            if (!str.empty()) {
                 str += char_consts::C_COMMA;
             }
             str += optString.value();
         }
-        data.setField(i, QVariant::fromValue(str));
+        data.setField(i, QVariant::fromValue(mmqt::toQStringUtf8(str)));
     } else {
         // MUME may send "weapon":false and "fighting":null
     }
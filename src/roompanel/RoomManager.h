@@ -3,7 +3,7 @@
 // Copyright (C) 2021 The MMapper Authors
 // Author: Massimiliano Ghilardi <massimiliano.ghilardi@gmail.com> (Cosmos)
 
-#include "../global/JsonObj.h"
+#include "../global/JsonView.h"
 #include "RoomMob.h"
 #include "RoomMobs.h"
 
@@ -16,9 +16,6 @@ class NODISCARD_QOBJECT RoomManager final : public QObject
 {
     Q_OBJECT
 
-private:
-    static const QHash<QString, MobFieldEnum> mobFields;
-
 private:
     RoomMobs m_room;
     bool m_debug = false;
@@ -38,12 +35,12 @@ class NODISCARD_QOBJECT RoomManager final : public QObject
 
     void showGmcp(const GmcpMessage &msg) const;
 
-    void addMob(const JsonObj &obj);
-    void updateMob(const JsonObj &obj);
+    void addMob(const JsonObjView &obj);
+    void updateMob(const JsonObjView &obj);
     void updateWidget();
 
-    NODISCARD bool toMob(const JsonObj &obj, RoomMobUpdate &mob) const;
-    static void toMobField(const JsonValue &value, RoomMobUpdate &data, MobFieldEnum i);
+    NODISCARD bool toMob(const JsonObjView &obj, RoomMobUpdate &mob) const;
+    static void toMobField(const JsonValueView &value, RoomMobUpdate &data, MobFieldEnum i);
 
 signals:
     void sig_updateWidget(); // update RoomWidget
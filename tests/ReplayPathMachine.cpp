@@ -0,0 +1,287 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+// Headless replay of a recorded parse event log (see ParseEventLog.h) through
+// Mmapper2PathMachine; used as a benchmark and as a regression test for path
+// machine changes.
+//
+// Usage:
+//   ReplayPathMachine <map.xml> <events.log>
+//   ReplayPathMachine --self-test
+//
+// Exits with a non-zero status if the replay disagrees with the recording.
+
+#include "../src/configuration/configuration.h"
+#include "../src/global/TextUtils.h"
+#include "../src/global/progresscounter.h"
+#include "../src/map/Map.h"
+#include "../src/map/mmapper2room.h"
+#include "../src/mapfrontend/mapfrontend.h"
+#include "../src/mapstorage/MapSource.h"
+#include "../src/mapstorage/RawMapData.h"
+#include "../src/mapstorage/XmlMapStorage.h"
+#include "../src/pathmachine/ParseEventLog.h"
+#include "../src/pathmachine/mmapper2pathmachine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <QCoreApplication>
+
+namespace { // anonymous
+
+using Clock = std::chrono::steady_clock;
+constexpr size_t MAX_REPORTED_MISMATCHES = 10;
+
+class NODISCARD ReplayMapFrontend final : public MapFrontend
+{
+public:
+    ReplayMapFrontend()
+        : MapFrontend(nullptr)
+    {}
+
+private:
+    void virt_clear() final {}
+};
+
+struct NODISCARD ReplayResult final
+{
+    std::vector<double> latenciesUs;
+    std::map<std::pair<PathStateEnum, PathStateEnum>, size_t> transitions;
+    std::map<PathStateEnum, size_t> eventsPerState;
+    size_t numMismatches = 0;
+};
+
+NODISCARD double percentile(const std::vector<double> &sorted, const double p)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const auto n = sorted.size();
+    const auto index = std::min(n - 1, static_cast<size_t>(p * static_cast<double>(n)));
+    return sorted[index];
+}
+
+NODISCARD ReplayResult replay(MapFrontend &map, const std::vector<parse_event_log::Entry> &entries)
+{
+    Mmapper2PathMachine pathMachine{map, nullptr};
+    pathMachine.onMapLoaded();
+
+    ReplayResult result;
+    result.latenciesUs.reserve(entries.size());
+
+    PathStateEnum prevState = pathMachine.getState();
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const auto &entry = entries[i];
+
+        const auto before = Clock::now();
+        pathMachine.slot_handleParseEvent(SigParseEvent{entry.event});
+        const auto after = Clock::now();
+
+        result.latenciesUs.push_back(
+            std::chrono::duration<double, std::micro>(after - before).count());
+
+        const PathStateEnum state = pathMachine.getState();
+        const ExternalRoomId room = pathMachine.getMostLikelyRoomExternalId();
+        ++result.eventsPerState[state];
+        if (state != prevState) {
+            ++result.transitions[std::make_pair(prevState, state)];
+            prevState = state;
+        }
+
+        if (state == entry.state && room == entry.room) {
+            continue;
+        }
+
+        if (result.numMismatches++ < MAX_REPORTED_MISMATCHES) {
+            std::cout << "mismatch at event " << i << " ("
+                      << entry.event->getRoomName().getStdStringViewUtf8() << "): expected "
+                      << parse_event_log::getStateName(entry.state) << " in room "
+                      << entry.room.asUint32() << ", got " << parse_event_log::getStateName(state)
+                      << " in room " << room.asUint32() << "\n";
+        }
+    }
+
+    return result;
+}
+
+void report(std::ostream &os, ReplayResult &result)
+{
+    auto &latencies = result.latenciesUs;
+    std::sort(latencies.begin(), latencies.end());
+
+    os << std::fixed << std::setprecision(1);
+    os << "events: " << latencies.size() << "\n";
+    os << "latency (us): p50 " << percentile(latencies, 0.50) << ", p90 "
+       << percentile(latencies, 0.90) << ", p99 " << percentile(latencies, 0.99) << ", max "
+       << (latencies.empty() ? 0.0 : latencies.back()) << "\n";
+
+    for (const auto &[state, count] : result.eventsPerState) {
+        os << "events in " << parse_event_log::getStateName(state) << ": " << count << "\n";
+    }
+    for (const auto &[fromTo, count] : result.transitions) {
+        os << "transition " << parse_event_log::getStateName(fromTo.first) << " -> "
+           << parse_event_log::getStateName(fromTo.second) << ": " << count << "\n";
+    }
+    os << "mismatches: " << result.numMismatches << "\n";
+}
+
+NODISCARD bool loadMap(MapFrontend &map, const std::string &filename)
+{
+    // XmlMapStorage tries the fast loader first, and falls back to QXmlStreamReader
+    // for maps the fast path doesn't understand.
+    AbstractMapStorage::Data storageData{MapSource::alloc(mmqt::toQStringUtf8(filename))};
+    auto pc = std::make_shared<ProgressCounter>();
+    storageData.setProgressCounter(pc);
+    XmlMapStorage storage{storageData, nullptr};
+    QObject::connect(&storage,
+                     &AbstractMapStorage::sig_log,
+                     [](const QString &who, const QString &msg) {
+                         std::cerr << who.toStdString() << ": " << msg.toStdString() << "\n";
+                     });
+
+    auto data = storage.loadData();
+    if (!data) {
+        std::cerr << "unable to load " << filename << " (only MM2 XML maps are supported)\n";
+        return false;
+    }
+
+    auto mapPair = Map::fromRooms(*pc, std::move(data->rooms), std::move(data->markers));
+    map.block();
+    map.setSavedMap(mapPair.base);
+    map.setCurrentMap(mapPair.modified);
+    map.unblock();
+
+    std::cout << "loaded " << map.getCurrentMap().getRoomsCount() << " rooms from " << filename
+              << "\n";
+    return true;
+}
+
+NODISCARD std::vector<parse_event_log::Entry> loadEvents(const std::string &filename)
+{
+    std::ifstream file{filename, std::ios::binary};
+    if (!file) {
+        throw std::runtime_error("unable to open " + filename);
+    }
+    return parse_event_log::read(file);
+}
+
+// Checks that a recording survives a round trip, and that the replay machinery
+// runs without a GUI.
+NODISCARD bool selfTest()
+{
+    auto makeEvent = [](const CommandEnum move,
+                        const ServerRoomId id,
+                        std::string name,
+                        std::string desc) -> SharedParseEvent {
+        RawExits exits;
+        exits[ExitDirEnum::EAST].setExitFlags(ExitFlags{ExitFlagEnum::EXIT});
+        exits[ExitDirEnum::WEST].setExitFlags(ExitFlags{ExitFlagEnum::EXIT}
+                                              | ExitFlags{ExitFlagEnum::DOOR});
+        exits[ExitDirEnum::WEST].setDoorName(DoorName{"gate\twith\\tab"});
+
+        ServerExitIds exitIds;
+        exitIds[ExitDirEnum::EAST] = ServerRoomId{id.asUint32() + 1};
+
+        PromptFlagsType promptFlags;
+        promptFlags.setValid();
+        promptFlags.setLit();
+        promptFlags.setFogType(PromptFogEnum::LIGHT_FOG);
+
+        ConnectedRoomFlagsType connectedRoomFlags;
+        connectedRoomFlags.setValid();
+        connectedRoomFlags.setDirectSunlight(ExitDirEnum::EAST, DirectSunlightEnum::SAW_DIRECT_SUN);
+
+        return ParseEvent::createSharedEvent(move,
+                                             id,
+                                             RoomArea{"Test area"},
+                                             RoomName{std::move(name)},
+                                             RoomDesc{std::move(desc)},
+                                             RoomContents{"A thing is here.\n"},
+                                             exitIds,
+                                             RoomTerrainEnum::FIELD,
+                                             std::move(exits),
+                                             promptFlags,
+                                             connectedRoomFlags);
+    };
+
+    const std::vector<SharedParseEvent> events{
+        makeEvent(CommandEnum::LOOK, ServerRoomId{100}, "Room A", "First line.\nSecond line.\n"),
+        makeEvent(CommandEnum::EAST, ServerRoomId{101}, "Room B", "Another room.\n"),
+        makeEvent(CommandEnum::WEST, INVALID_SERVER_ROOMID, "Room A", ""),
+    };
+
+    std::stringstream ss;
+    parse_event_log::writeHeader(ss);
+    for (const auto &ev : events) {
+        parse_event_log::write(ss, *ev, PathStateEnum::SYNCING, INVALID_EXTERNAL_ROOMID);
+    }
+
+    const auto entries = parse_event_log::read(ss);
+    if (entries.size() != events.size()) {
+        std::cerr << "round trip: expected " << events.size() << " events, got "
+                  << entries.size() << "\n";
+        return false;
+    }
+
+    for (size_t i = 0; i < events.size(); ++i) {
+        std::stringstream a;
+        std::stringstream b;
+        parse_event_log::write(a, *events[i], PathStateEnum::SYNCING, INVALID_EXTERNAL_ROOMID);
+        parse_event_log::write(b, *entries[i].event, entries[i].state, entries[i].room);
+        if (a.str() != b.str() || entries[i].event->toQString() != events[i]->toQString()) {
+            std::cerr << "round trip: event " << i << " differs\n";
+            return false;
+        }
+    }
+
+    // With an empty map nothing can match, so the path machine must stay in SYNCING.
+    ReplayMapFrontend map;
+    auto result = replay(map, entries);
+    report(std::cout, result);
+    return result.numMismatches == 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    setEnteredMain();
+
+    try {
+        if (argc == 2 && std::string_view{argv[1]} == "--self-test") {
+            return selfTest() ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        if (argc != 3) {
+            std::cerr << "usage: " << argv[0] << " <map.xml> <events.log>\n"
+                      << "       " << argv[0] << " --self-test\n";
+            return EXIT_FAILURE;
+        }
+
+        ReplayMapFrontend map;
+        if (!loadMap(map, argv[1])) {
+            return EXIT_FAILURE;
+        }
+
+        const auto entries = loadEvents(argv[2]);
+        auto result = replay(map, entries);
+        report(std::cout, result);
+        return result.numMismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    } catch (const std::exception &e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+}
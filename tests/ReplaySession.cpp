@@ -0,0 +1,593 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+// Stand-in MUD that replays a session capture (see SessionCapture.h) over TCP;
+// used as an end-to-end benchmark of the inbound proxy pipeline without the live game.
+//
+// Usage:
+//   ReplaySession [--speed X] <capture>
+//   ReplaySession --serve [--port N] [--speed X] <capture>
+//   ReplaySession --self-test
+//
+// The first form connects its own client to the fake MUD, and feeds what it receives
+// through MudTelnet (including MCCP decompression), the TelnetLineFilter, the GmcpDispatcher
+// and the MpiFilter, exactly as the Proxy does, then reports throughput, per-stage latency
+// and the CPU time spent in the pipeline.
+//
+// MumeXmlParser and the path machine aren't included: the parser can't be built without
+// MapData and the Proxy, which bring in the rest of the application. The --serve form
+// measures them in a real MMapper, and ReplayPathMachine replays the path machine alone.
+//
+// With --serve, it keeps listening, so a real MMapper can connect to it: point the MUD
+// server at localhost and the port (with encryption disabled), and use "_perf show" in
+// the client to see where the time went.
+//
+// A speed of 1 replays in real time, 10 is ten times faster, and 0 (the default)
+// sends everything as fast as the connection will take it.
+
+#include "../src/configuration/configuration.h"
+#include "../src/global/AnsiOstream.h"
+#include "../src/global/PerfStats.h"
+#include "../src/global/Signal2.h"
+#include "../src/global/progresscounter.h"
+#include "../src/global/zpipe.h"
+#include "../src/mpi/mpifilter.h"
+#include "../src/proxy/AbstractTelnet.h"
+#include "../src/proxy/GmcpDispatcher.h"
+#include "../src/proxy/MudTelnet.h"
+#include "../src/proxy/SessionCapture.h"
+#include "../src/proxy/telnetfilter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+namespace { // anonymous
+
+using Clock = std::chrono::steady_clock;
+using session_capture::Chunk;
+
+// Stop writing when this much is waiting to be sent, so "as fast as possible" measures the
+// receiver rather than how quickly the sender can fill the socket's buffer.
+constexpr qint64 MAX_BYTES_TO_WRITE = 1 << 20;
+
+// CPU time used by the calling thread; the fake MUD runs on the same thread, so this is only
+// meaningful as the difference across a call that doesn't return to the event loop.
+NODISCARD std::optional<double> getThreadCpuSeconds()
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    timespec ts{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+    }
+#endif
+    return std::nullopt;
+}
+
+NODISCARD double percentile(const std::vector<double> &sorted, const double p)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const auto n = sorted.size();
+    const auto index = std::min(n - 1, static_cast<size_t>(p * static_cast<double>(n)));
+    return sorted[index];
+}
+
+class NODISCARD FakeMud final
+{
+private:
+    struct NODISCARD Connection final
+    {
+        QTcpSocket *socket = nullptr;
+        size_t next = 0;
+        Clock::time_point start = Clock::now();
+        uint64_t bytesSent = 0;
+        bool waitingForDrain = false;
+        bool finished = false;
+    };
+
+private:
+    const std::vector<Chunk> &m_chunks;
+    const double m_speed;
+    QTcpServer m_server;
+    std::vector<std::unique_ptr<Connection>> m_connections;
+
+public:
+    explicit FakeMud(const std::vector<Chunk> &chunks, const double speed)
+        : m_chunks{chunks}
+        , m_speed{speed}
+    {
+        QObject::connect(&m_server, &QTcpServer::newConnection, &m_server, [this]() {
+            while (QTcpSocket *const socket = m_server.nextPendingConnection()) {
+                onNewConnection(*socket);
+            }
+        });
+    }
+    DELETE_CTORS_AND_ASSIGN_OPS(FakeMud);
+
+public:
+    NODISCARD bool listen(const quint16 port)
+    {
+        return m_server.listen(QHostAddress::LocalHost, port);
+    }
+    NODISCARD quint16 getPort() const { return m_server.serverPort(); }
+    NODISCARD QString getErrorString() const { return m_server.errorString(); }
+
+private:
+    void onNewConnection(QTcpSocket &socket)
+    {
+        std::cout << "replaying " << m_chunks.size() << " chunks to "
+                  << socket.peerAddress().toString().toStdString() << ":" << socket.peerPort()
+                  << "\n";
+
+        auto &conn = *m_connections.emplace_back(std::make_unique<Connection>());
+        conn.socket = &socket;
+
+        // Whatever the client sends (e.g. telnet negotiation) is ignored.
+        QObject::connect(&socket, &QTcpSocket::readyRead, &socket, [&socket]() {
+            std::ignore = socket.readAll();
+        });
+        QObject::connect(&socket, &QTcpSocket::bytesWritten, &socket, [this, &conn]() {
+            if (conn.waitingForDrain && conn.socket->bytesToWrite() < MAX_BYTES_TO_WRITE / 2) {
+                conn.waitingForDrain = false;
+                pump(conn);
+            }
+        });
+        QObject::connect(&socket, &QTcpSocket::disconnected, &socket, &QObject::deleteLater);
+
+        pump(conn);
+    }
+
+    void pump(Connection &conn)
+    {
+        QTcpSocket &socket = deref(conn.socket);
+        while (conn.next < m_chunks.size()) {
+            const Chunk &chunk = m_chunks[conn.next];
+            if (m_speed > 0.0) {
+                const auto due = conn.start
+                                 + std::chrono::duration_cast<Clock::duration>(
+                                     std::chrono::duration<double, std::micro>(
+                                         static_cast<double>(chunk.time.count()) / m_speed));
+                const auto now = Clock::now();
+                if (now < due) {
+                    const auto ms = std::chrono::ceil<std::chrono::milliseconds>(due - now);
+                    QTimer::singleShot(ms, &socket, [this, &conn]() { pump(conn); });
+                    return;
+                }
+            }
+
+            const QByteArray &bytes = chunk.bytes.getQByteArray();
+            socket.write(bytes);
+            conn.bytesSent += static_cast<uint64_t>(bytes.size());
+            ++conn.next;
+
+            if (socket.bytesToWrite() >= MAX_BYTES_TO_WRITE) {
+                conn.waitingForDrain = true;
+                return;
+            }
+        }
+
+        if (!conn.finished) {
+            conn.finished = true;
+            const auto seconds = std::chrono::duration<double>(Clock::now() - conn.start).count();
+            std::cout << std::fixed << std::setprecision(1) << "sent " << conn.bytesSent
+                      << " bytes in " << seconds << " s\n";
+            // Closes once everything has been written.
+            socket.disconnectFromHost();
+        }
+    }
+};
+
+struct NODISCARD PipelineResult final
+{
+    uint64_t bytesIn = 0;
+    uint64_t numReads = 0;
+    uint64_t numLines = 0;
+    uint64_t textBytes = 0;
+    uint64_t numGmcpMessages = 0;
+    uint64_t numGmcpPayloadsParsed = 0;
+    uint64_t numMpiMessages = 0;
+    std::vector<double> readLatenciesUs;
+    std::vector<std::string> lines;
+    double wallSeconds = 0.0;
+    // Only the time spent inside the pipeline, on the thread that runs it.
+    std::optional<double> pipelineCpuSeconds;
+};
+
+// The inbound half of the Proxy's mud pipeline:
+// Sock -> Telnet -> { LineFilter, GmcpDispatcher, MpiFilter }.
+class NODISCARD HeadlessMudPipeline final : public MudTelnetOutputs, private MpiFilterOutputs
+{
+private:
+    QTcpSocket &m_socket;
+    PipelineResult &m_result;
+    const bool m_keepLines;
+    TelnetLineFilter m_filter;
+    Signal2Lifetime m_lifetime;
+    GmcpDispatcher m_gmcpDispatcher;
+    MpiFilter m_mpiFilter;
+    MudTelnet m_telnet;
+
+public:
+    explicit HeadlessMudPipeline(QTcpSocket &socket, PipelineResult &result, const bool keepLines)
+        : m_socket{socket}
+        , m_result{result}
+        , m_keepLines{keepLines}
+        , m_filter{TelnetLineFilter::OptionBackspacesEnum::Yes,
+                   [this](const TelnetData &data) { onLine(data); }}
+        , m_mpiFilter{static_cast<MpiFilterOutputs &>(*this)}
+        , m_telnet{*this}
+    {
+        // The same messages the parser and the group manager subscribe to in the Proxy;
+        // their handlers start by parsing the payload, which is what this one does.
+        m_gmcpDispatcher.subscribe({GmcpMessageTypeEnum::CHAR_NAME,
+                                    GmcpMessageTypeEnum::CHAR_STATUSVARS,
+                                    GmcpMessageTypeEnum::CHAR_VITALS,
+                                    GmcpMessageTypeEnum::EVENT_MOVED,
+                                    GmcpMessageTypeEnum::GROUP_ADD,
+                                    GmcpMessageTypeEnum::GROUP_REMOVE,
+                                    GmcpMessageTypeEnum::GROUP_SET,
+                                    GmcpMessageTypeEnum::GROUP_UPDATE,
+                                    GmcpMessageTypeEnum::ROOM_INFO},
+                                   m_lifetime,
+                                   [this](const GmcpMessage &msg) { onGmcp(msg); });
+    }
+    ~HeadlessMudPipeline() final = default;
+    DELETE_CTORS_AND_ASSIGN_OPS(HeadlessMudPipeline);
+
+public:
+    void onRead(QByteArray bytes)
+    {
+        m_result.bytesIn += static_cast<uint64_t>(bytes.size());
+        ++m_result.numReads;
+
+        const auto cpuBefore = getThreadCpuSeconds();
+        const auto before = Clock::now();
+        m_telnet.onAnalyzeMudStream(TelnetIacBytes{std::move(bytes)});
+        const auto after = Clock::now();
+        const auto cpuAfter = getThreadCpuSeconds();
+
+        m_result.readLatenciesUs.push_back(
+            std::chrono::duration<double, std::micro>(after - before).count());
+        if (cpuBefore && cpuAfter) {
+            m_result.pipelineCpuSeconds = m_result.pipelineCpuSeconds.value_or(0.0)
+                                          + (*cpuAfter - *cpuBefore);
+        }
+    }
+
+private:
+    void onLine(const TelnetData &data)
+    {
+        const auto line = data.line.getStdStringView();
+        ++m_result.numLines;
+        m_result.textBytes += line.size();
+        if (m_keepLines) {
+            m_result.lines.emplace_back(line);
+        }
+    }
+
+    void onGmcp(const GmcpMessage &msg)
+    {
+        if (msg.getJsonView()) {
+            ++m_result.numGmcpPayloadsParsed;
+        }
+    }
+
+private:
+    void virt_onAnalyzeMudStream(const RawSlice &bytes, const bool goAhead) final
+    {
+        m_filter.receive(bytes, goAhead);
+    }
+    void virt_onSendToSocket(const TelnetIacBytes &bytes) final
+    {
+        m_socket.write(bytes.getQByteArray());
+    }
+    void virt_onRelayGmcpFromMudToUser(const GmcpMessage &msg) final
+    {
+        ++m_result.numGmcpMessages;
+        m_gmcpDispatcher.dispatch(msg);
+    }
+    void virt_onRelayEchoMode(bool) final {}
+    void virt_onSendMSSPToUser(const TelnetMsspBytes &) final {}
+    void virt_onSendGameTimeToClock(const MsspTime &) final {}
+    void virt_onTryCharLogin() final {}
+    void virt_onMumeClientView(const QString &title, const QString &body) final
+    {
+        m_mpiFilter.receiveMpiView(title, body);
+    }
+    void virt_onMumeClientEdit(const RemoteSessionId id,
+                               const QString &title,
+                               const QString &body) final
+    {
+        m_mpiFilter.receiveMpiEdit(id, title, body);
+    }
+    void virt_onMumeClientError(const QString &) final {}
+
+private:
+    // The Proxy opens a viewer or editor window for these.
+    void virt_onParseNewMudInput(const TelnetData &) final {}
+    void virt_onEditMessage(const RemoteSessionId, const QString &, const QString &) final
+    {
+        ++m_result.numMpiMessages;
+    }
+    void virt_onViewMessage(const QString &, const QString &) final { ++m_result.numMpiMessages; }
+};
+
+NODISCARD PipelineResult runBenchmark(const std::vector<Chunk> &chunks,
+                                      const double speed,
+                                      const bool keepLines)
+{
+    perf_stats::reset();
+    gmcp_dispatch_stats::reset();
+
+    FakeMud mud{chunks, speed};
+    if (!mud.listen(0)) {
+        throw std::runtime_error("unable to listen: " + mud.getErrorString().toStdString());
+    }
+
+    PipelineResult result;
+    QTcpSocket socket;
+    HeadlessMudPipeline pipeline{socket, result, keepLines};
+
+    QEventLoop loop;
+    QObject::connect(&socket, &QTcpSocket::readyRead, &socket, [&socket, &pipeline]() {
+        pipeline.onRead(socket.readAll());
+    });
+    QObject::connect(&socket, &QTcpSocket::disconnected, &loop, &QEventLoop::quit);
+    QObject::connect(&socket, &QTcpSocket::errorOccurred, &loop, [&loop, &socket]() {
+        if (socket.error() != QAbstractSocket::RemoteHostClosedError) {
+            std::cerr << "socket error: " << socket.errorString().toStdString() << "\n";
+        }
+        loop.quit();
+    });
+
+    const auto before = Clock::now();
+    socket.connectToHost(QHostAddress::LocalHost, mud.getPort());
+    loop.exec();
+
+    // Anything that arrived with the FIN.
+    if (socket.bytesAvailable() > 0) {
+        pipeline.onRead(socket.readAll());
+    }
+
+    result.wallSeconds = std::chrono::duration<double>(Clock::now() - before).count();
+    return result;
+}
+
+void report(std::ostream &os, PipelineResult &result)
+{
+    auto &latencies = result.readLatenciesUs;
+    std::sort(latencies.begin(), latencies.end());
+
+    const auto perSecond = [&result](const uint64_t n) {
+        return result.wallSeconds > 0.0 ? static_cast<double>(n) / result.wallSeconds : 0.0;
+    };
+
+    os << std::fixed << std::setprecision(1);
+    os << "received: " << result.bytesIn << " bytes in " << result.numReads << " reads, "
+       << result.numLines << " lines (" << result.textBytes << " bytes of text), "
+       << result.numGmcpMessages << " GMCP messages (" << result.numGmcpPayloadsParsed
+       << " dispatched and parsed), " << result.numMpiMessages << " MPI messages\n";
+    os << "wall time: " << result.wallSeconds * 1e3 << " ms, ";
+    if (result.pipelineCpuSeconds) {
+        os << "cpu time in the pipeline: " << *result.pipelineCpuSeconds * 1e3 << " ms\n";
+    } else {
+        os << "cpu time in the pipeline: unavailable on this platform\n";
+    }
+    os << "throughput: " << perSecond(result.bytesIn) / 1024.0 << " KiB/s, "
+       << perSecond(result.numLines) << " lines/s\n";
+    os << "latency per read (us): p50 " << percentile(latencies, 0.50) << ", p90 "
+       << percentile(latencies, 0.90) << ", p99 " << percentile(latencies, 0.99) << ", max "
+       << (latencies.empty() ? 0.0 : latencies.back()) << "\n";
+
+#define X_REPORT_STAGE(_Enum, _key, _description) \
+    do { \
+        const auto snapshot = perf_stats::getSnapshot(PerfStageEnum::_Enum); \
+        if (snapshot.count != 0) { \
+            os << "stage " << _key << ": " << snapshot.count << " calls, mean " \
+               << snapshot.getMeanUs() << " us, p99 <= " \
+               << snapshot.getPercentileUpperBoundUs(0.99) << " us, total " \
+               << static_cast<double>(snapshot.totalNs) * 1e-6 << " ms\n"; \
+        } \
+    } while (false);
+    XFOREACH_PERF_STAGE(X_REPORT_STAGE)
+#undef X_REPORT_STAGE
+
+    AnsiOstream aos{os, AnsiSupportFlags{}};
+    gmcp_dispatch_stats::report(aos);
+}
+
+NODISCARD std::vector<Chunk> loadCapture(const std::string &filename)
+{
+    std::ifstream file{filename, std::ios::binary};
+    if (!file) {
+        throw std::runtime_error("unable to open " + filename);
+    }
+    return session_capture::read(file);
+}
+
+NODISCARD TelnetIacBytes makeIac(std::initializer_list<uint8_t> bytes)
+{
+    QByteArray result;
+    for (const uint8_t b : bytes) {
+        result.append(static_cast<char>(b));
+    }
+    return TelnetIacBytes{std::move(result)};
+}
+
+// Checks that a capture survives a round trip, and that a replay (including an MCCP stream
+// split across chunks) comes out of the telnet pipeline as the original lines.
+NODISCARD bool selfTest()
+{
+    std::vector<std::string> expected;
+    std::vector<Chunk> chunks;
+    auto addChunk = [&chunks](const int64_t ms, TelnetIacBytes bytes) {
+        chunks.emplace_back(Chunk{std::chrono::milliseconds{ms}, std::move(bytes)});
+    };
+
+    expected.emplace_back("Welcome to the fake MUD!\r\n");
+    addChunk(0, TelnetIacBytes{QByteArray::fromStdString(expected.back())});
+
+    std::string compressedText;
+    for (int i = 0; i < 200; ++i) {
+        expected.emplace_back("This is line " + std::to_string(i) + " of the story.\r\n");
+        compressedText += expected.back();
+    }
+
+    if (mmz::hasZlib()) {
+        addChunk(5, makeIac({TN_IAC, TN_WILL, OPT_COMPRESS2}));
+
+        ProgressCounter pc;
+        mmqt::QByteArrayInputStream in{QByteArray::fromStdString(compressedText)};
+        mmqt::QByteArrayOutputStream out;
+        if (mmz::zpipe_deflate(pc, in, out, 6) != 0) {
+            std::cerr << "unable to compress the test stream\n";
+            return false;
+        }
+        const QByteArray compressed = std::move(out).get();
+
+        // The compressed stream starts right after IAC SB COMPRESS2 IAC SE,
+        // and it's split at arbitrary points to exercise the streaming inflate.
+        QByteArray first = makeIac({TN_IAC, TN_SB, OPT_COMPRESS2, TN_IAC, TN_SE}).getQByteArray();
+        const auto third = compressed.size() / 3;
+        first.append(compressed.left(third));
+        addChunk(10, TelnetIacBytes{first});
+        addChunk(15, TelnetIacBytes{compressed.mid(third, third)});
+        addChunk(20, TelnetIacBytes{compressed.mid(2 * third)});
+    } else {
+        addChunk(10, TelnetIacBytes{QByteArray::fromStdString(compressedText)});
+    }
+
+    std::stringstream ss;
+    session_capture::writeHeader(ss);
+    for (const auto &chunk : chunks) {
+        session_capture::write(ss, chunk.time, chunk.bytes);
+    }
+
+    const auto roundTrip = session_capture::read(ss);
+    if (roundTrip.size() != chunks.size()) {
+        std::cerr << "round trip: expected " << chunks.size() << " chunks, got "
+                  << roundTrip.size() << "\n";
+        return false;
+    }
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        if (roundTrip[i].time != chunks[i].time || roundTrip[i].bytes != chunks[i].bytes) {
+            std::cerr << "round trip: chunk " << i << " differs\n";
+            return false;
+        }
+    }
+
+    for (const double speed : {0.0, 1.0}) {
+        auto result = runBenchmark(roundTrip, speed, true);
+        report(std::cout, result);
+        if (result.lines != expected) {
+            std::cerr << "replay at speed " << speed << ": expected " << expected.size()
+                      << " lines, got " << result.lines.size() << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+struct NODISCARD Options final
+{
+    std::string filename;
+    double speed = 0.0;
+    quint16 port = 4242;
+    bool serve = false;
+    bool selfTest = false;
+};
+
+NODISCARD std::optional<Options> parseArgs(const QStringList &args)
+{
+    Options opts;
+    for (qsizetype i = 1; i < args.size(); ++i) {
+        const QString &arg = args[i];
+        const bool hasValue = i + 1 < args.size();
+        bool ok = true;
+        if (arg == "--self-test") {
+            opts.selfTest = true;
+        } else if (arg == "--serve") {
+            opts.serve = true;
+        } else if (arg == "--speed" && hasValue) {
+            opts.speed = args[++i].toDouble(&ok);
+            ok = ok && std::isfinite(opts.speed) && opts.speed >= 0.0;
+        } else if (arg == "--port" && hasValue) {
+            opts.port = args[++i].toUShort(&ok);
+        } else if (!arg.startsWith("--") && opts.filename.empty()) {
+            opts.filename = arg.toStdString();
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            return std::nullopt;
+        }
+    }
+    if (!opts.selfTest && opts.filename.empty()) {
+        return std::nullopt;
+    }
+    return opts;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    setEnteredMain();
+
+    try {
+        const auto opts = parseArgs(QCoreApplication::arguments());
+        if (!opts) {
+            std::cerr << "usage: " << argv[0] << " [--speed X] <capture>\n"
+                      << "       " << argv[0] << " --serve [--port N] [--speed X] <capture>\n"
+                      << "       " << argv[0] << " --self-test\n";
+            return EXIT_FAILURE;
+        }
+
+        if (opts->selfTest) {
+            return selfTest() ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        const auto chunks = loadCapture(opts->filename);
+        std::cout << "loaded " << chunks.size() << " chunks from " << opts->filename << "\n";
+
+        if (opts->serve) {
+            FakeMud mud{chunks, opts->speed};
+            if (!mud.listen(opts->port)) {
+                std::cerr << "unable to listen on port " << opts->port << ": "
+                          << mud.getErrorString().toStdString() << "\n";
+                return EXIT_FAILURE;
+            }
+            std::cout << "listening on localhost:" << mud.getPort() << "\n";
+            return QCoreApplication::exec();
+        }
+
+        auto result = runBenchmark(chunks, opts->speed, false);
+        report(std::cout, result);
+        return EXIT_SUCCESS;
+    } catch (const std::exception &e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+}
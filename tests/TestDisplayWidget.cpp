@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "TestDisplayWidget.h"
+
+#include "../src/client/displaywidget.h"
+#include "../src/configuration/configuration.h"
+
+#include <QTextDocument>
+#include <QtTest/QtTest>
+
+namespace { // anonymous
+
+NODISCARD QString display(const QStringList &chunks)
+{
+    QTextDocument document;
+    AnsiTextHelper helper{document};
+    helper.init();
+    for (const QString &chunk : chunks) {
+        helper.displayText(chunk);
+    }
+    return document.toPlainText();
+}
+
+} // namespace
+
+TestDisplayWidget::TestDisplayWidget()
+{
+    setEnteredMain();
+}
+
+TestDisplayWidget::~TestDisplayWidget() = default;
+
+void TestDisplayWidget::displayTextTest()
+{
+    QCOMPARE(display({"plain text\n"}), QString("plain text\n"));
+    QCOMPARE(display({"\x1b[31mred\x1b[0m and \x1b[1mbold\x1b[0m\n"}),
+             QString("red and bold\n"));
+    QCOMPARE(display({"split ", "across ", "calls\n"}), QString("split across calls\n"));
+}
+
+void TestDisplayWidget::displayTextBackspaceTest()
+{
+    // Each backspace removes the character before it once the next text arrives,
+    // including when everything is still in the same call at the start of a line.
+    QCOMPARE(display({"foo|\b/\b-"}), QString("foo-"));
+    QCOMPARE(display({"first\nfoo|\b/\b-"}), QString("first\nfoo-"));
+    QCOMPARE(display({"foo|\b", "/\b", "-"}), QString("foo-"));
+
+    // Nothing to erase at the very start.
+    QCOMPARE(display({"\bfoo"}), QString("foo"));
+}
+
+QTEST_MAIN(TestDisplayWidget)
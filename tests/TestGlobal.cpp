@@ -7,14 +7,18 @@
 #include "../src/global/AnsiTextUtils.h"
 #include "../src/global/CaseUtils.h"
 #include "../src/global/CharUtils.h"
+#include "../src/global/Charset.h"
 #include "../src/global/Diff.h"
 #include "../src/global/EnumIndexedArray.h"
 #include "../src/global/Flags.h"
 #include "../src/global/HideQDebug.h"
 #include "../src/global/IndexedVectorWithDefault.h"
+#include "../src/global/JsonView.h"
 #include "../src/global/LineUtils.h"
+#include "../src/global/PerfStats.h"
 #include "../src/global/RAII.h"
 #include "../src/global/Signal2.h"
+#include "../src/global/SimdUtils.h"
 #include "../src/global/StringView.h"
 #include "../src/global/TaggedString.h"
 #include "../src/global/TextUtils.h"
@@ -26,7 +30,11 @@
 #include "../src/global/string_view_utils.h"
 #include "../src/global/unquote.h"
 #include "../src/global/utils.h"
+#include "../src/global/zpipe.h"
 
+#include <sstream>
+#include <stdexcept>
+#include <string>
 #include <tuple>
 
 #include <QDebug>
@@ -116,6 +124,31 @@ void TestGlobal::ansiTextUtilsTest()
     test::testAnsiTextUtils();
 }
 
+void TestGlobal::ansiTokenizerBenchmark()
+{
+    // ANSI-dense output, like a colorized room with exits, mobs and a prompt.
+    QString text;
+    for (int i = 0; i < 200; ++i) {
+        text += "\x1B[1;32mThe Prancing Pony\x1B[0m\n"
+                "\x1B[0mYou are standing in the common room of the inn. Tables and benches\n"
+                "are scattered about.\x1B[0m\n"
+                "\x1B[33mExits: \x1B[1;33mnorth\x1B[0m, \x1B[1;33meast\x1B[0m.\n"
+                "\x1B[1;31mA hungry wolf\x1B[0m is here, growling at you.\n"
+                "\x1B[36m*\x1B[0m HP:Healthy Mana:Full Move:Fresh >\n";
+    }
+
+    size_t tokens = 0;
+    size_t escapes = 0;
+    QBENCHMARK {
+        for (const mmqt::AnsiStringToken token : mmqt::AnsiTokenizer{text}) {
+            tokens += (token.type == mmqt::TokenTypeEnum::Word) ? 1u : 0u;
+        }
+        mmqt::foreachAnsi(text, [&escapes](qsizetype, QStringView) { ++escapes; });
+    }
+    QVERIFY(tokens > 0);
+    QVERIFY(escapes > 0);
+}
+
 void TestGlobal::ansiToRgbTest()
 {
     static_assert(153 == 16 + 36 * 3 + 6 * 4 + 5);
@@ -158,6 +191,29 @@ void TestGlobal::charsetTest()
     test::testCharset();
 }
 
+void TestGlobal::charsetTranscodeBenchmark()
+{
+    // Mostly ASCII, with the occasional accented name, like typical MUD output.
+    std::string utf8;
+    while (utf8.size() < 64 * 1024) {
+        utf8 += "The Prancing Pony is a large inn, famous for its ale. Barliman Butterbur\n"
+                "greets you. \xC3\x89owyn and Th\xC3\xA9oden are here, resting by the fire.\n";
+    }
+    const std::string latin1 = charset::conversion::utf8ToLatin1(utf8);
+    QVERIFY(charset::isValidUtf8(utf8));
+    QVERIFY(!charset::isAscii(latin1));
+    QCOMPARE(charset::conversion::latin1ToUtf8(latin1), utf8);
+
+    size_t bytes = 0;
+    QBENCHMARK {
+        bytes += charset::isValidUtf8(utf8) ? utf8.size() : 0;
+        bytes += charset::conversion::utf8ToLatin1(utf8).size();
+        bytes += charset::conversion::latin1ToUtf8(latin1).size();
+        bytes += charset::conversion::latin1ToAscii(latin1).size();
+    }
+    QVERIFY(bytes > 0);
+}
+
 void TestGlobal::charUtilsTest()
 {
     test::testCharUtils();
@@ -189,6 +245,39 @@ void TestGlobal::flagsTest()
     test::testFlags();
 }
 
+void TestGlobal::gzipWriterTest()
+{
+    if (!mmz::hasZlib()) {
+        QSKIP("built without zlib");
+    }
+
+    std::ostringstream os;
+    {
+        mmz::GzipWriter gzip{os, 6};
+        gzip.write("part one\n");
+        gzip.flush();
+        // Everything before the flush can already be read back.
+        QVERIFY(!os.str().empty());
+        gzip.write(std::string(100'000, 'x'));
+        gzip.write("part two\n");
+        gzip.finish();
+        bool threw = false;
+        try {
+            gzip.write("too late");
+        } catch (const std::runtime_error &) {
+            threw = true;
+        }
+        QVERIFY(threw);
+    }
+
+    ProgressCounter pc;
+    mmqt::QByteArrayInputStream is{QByteArray::fromStdString(os.str())};
+    mmqt::QByteArrayOutputStream out;
+    QCOMPARE(mmz::zpipe_inflate(pc, is, out), 0);
+    QCOMPARE(std::move(out).get().toStdString(),
+             "part one\n" + std::string(100'000, 'x') + "part two\n");
+}
+
 void TestGlobal::hideQDebugTest()
 {
     static constexpr auto onlyDebug = std::invoke([]() constexpr -> mmqt::HideQDebugOptions {
@@ -292,11 +381,21 @@ void TestGlobal::indexedVectorWithDefaultTest()
     test::testIndexedVectorWithDefault();
 }
 
+void TestGlobal::jsonViewTest()
+{
+    test::testJsonView();
+}
+
 void TestGlobal::lineUtilsTest()
 {
     test::testLineUtils();
 }
 
+void TestGlobal::perfStatsTest()
+{
+    test::testPerfStats();
+}
+
 void TestGlobal::powerOfTwoTest()
 {
     using namespace utils;
@@ -505,6 +604,11 @@ void TestGlobal::signal2Test()
     sig2_test_recursion();
 }
 
+void TestGlobal::simdUtilsTest()
+{
+    test::testSimdUtils();
+}
+
 void TestGlobal::stringViewTest()
 {
     test::testStringView();
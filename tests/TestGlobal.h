@@ -18,21 +18,27 @@ private Q_SLOTS:
     static void ansi256ColorTest();
     static void ansiOstreamTest();
     static void ansiTextUtilsTest();
+    static void ansiTokenizerBenchmark();
     static void ansiToRgbTest();
     static void caseUtilsTest();
     static void castTest();
     static void charsetTest();
+    static void charsetTranscodeBenchmark();
     static void charUtilsTest();
     static void colorTest();
     static void diffTest();
     static void emojiTest();
     static void entitiesTest();
     static void flagsTest();
+    static void gzipWriterTest();
     static void hideQDebugTest();
     static void indexedVectorWithDefaultTest();
+    static void jsonViewTest();
     static void lineUtilsTest();
+    static void perfStatsTest();
     static void powerOfTwoTest();
     static void signal2Test();
+    static void simdUtilsTest();
     static void stringViewTest();
     static void taggedStringTest();
     static void textUtilsTest();
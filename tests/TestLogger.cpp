@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "TestLogger.h"
+
+#include "../src/global/progresscounter.h"
+#include "../src/global/zpipe.h"
+#include "../src/logger/asynclogwriter.h"
+
+#include <stdexcept>
+#include <string>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+
+namespace { // anonymous
+
+NODISCARD AsyncLogWriter::Settings makeSettings(const QString &dir, const bool compress)
+{
+    AsyncLogWriter::Settings settings;
+    settings.autoLogDirectory = dir;
+    settings.autoLog = true;
+    settings.cleanupStrategy = AutoLoggerEnum::KeepForever;
+    settings.rotateWhenLogsReachBytes = 64 * 1024 * 1024;
+    settings.compressLogs = compress;
+    return settings;
+}
+
+// Returns the (decompressed) contents of the only log in the directory.
+NODISCARD std::string readOnlyLog(const QString &dir)
+{
+    const auto files = QDir{dir}.entryInfoList(QStringList{"MMapper_Log_*"}, QDir::Files);
+    if (files.size() != 1) {
+        throw std::runtime_error("expected exactly one log file");
+    }
+
+    QFile file{files.front().absoluteFilePath()};
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw std::runtime_error("unable to read the log file");
+    }
+    QByteArray contents = file.readAll();
+    if (files.front().fileName().endsWith(".gz")) {
+        ProgressCounter pc;
+        mmqt::QByteArrayInputStream is{contents};
+        mmqt::QByteArrayOutputStream os;
+        if (mmz::zpipe_inflate(pc, is, os) != 0) {
+            throw std::runtime_error("unable to inflate the log file");
+        }
+        contents = std::move(os).get();
+    }
+    return contents.toStdString();
+}
+
+} // namespace
+
+TestLogger::TestLogger() = default;
+
+TestLogger::~TestLogger() = default;
+
+void TestLogger::asyncLogWriterTest()
+{
+    QObject receiver;
+    for (const bool compress : {false, true}) {
+        if (compress && !mmz::hasZlib()) {
+            continue;
+        }
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        std::string expected;
+        {
+            AsyncLogWriter writer{receiver, "test", {}};
+            writer.open(makeSettings(dir.path(), compress));
+            for (int i = 0; i < 1000; ++i) {
+                std::string line = "line " + std::to_string(i) + "\n";
+                expected += line;
+                writer.write(std::move(line));
+            }
+            // The destructor writes whatever is still queued.
+        }
+
+        QCOMPARE(readOnlyLog(dir.path()), expected);
+    }
+}
+
+void TestLogger::asyncLogWriterDropTest()
+{
+    QObject receiver;
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    // A single write that's bigger than the queue can ever hold is always dropped,
+    // no matter how quickly the writer thread keeps up.
+    const size_t tooBig = AsyncLogWriter::MAX_QUEUED_BYTES + 1;
+    {
+        AsyncLogWriter writer{receiver, "test", {}};
+        writer.open(makeSettings(dir.path(), false));
+        writer.write("before\n");
+        writer.write(std::string(tooBig, 'x'));
+        writer.write("after\n");
+    }
+
+    const std::string log = readOnlyLog(dir.path());
+    QVERIFY(log.find('x') == std::string::npos);
+    QVERIFY(log.rfind("before\n", 0) == 0);
+    QVERIFY(log.size() >= 6 && log.compare(log.size() - 6, 6, "after\n") == 0);
+
+    // The note saying what was dropped goes in between.
+    const std::string note = log.substr(7, log.size() - 7 - 6);
+    QVERIFY(note.find(std::to_string(tooBig) + " bytes") != std::string::npos);
+    QVERIFY(note.find("were not logged") != std::string::npos);
+}
+
+QTEST_MAIN(TestLogger)
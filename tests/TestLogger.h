@@ -0,0 +1,20 @@
+#pragma once
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "../src/global/macros.h"
+
+#include <QObject>
+
+class NODISCARD_QOBJECT TestLogger final : public QObject
+{
+    Q_OBJECT
+
+public:
+    TestLogger();
+    ~TestLogger() final;
+
+private Q_SLOTS:
+    static void asyncLogWriterTest();
+    static void asyncLogWriterDropTest();
+};
@@ -7,8 +7,11 @@
 #include "../src/map/Diff.h"
 #include "../src/map/Map.h"
 #include "../src/map/TinyRoomIdSet.h"
+#include "../src/map/room.h"
 #include "../src/map/sanitizer.h"
 
+#include <string>
+
 #include <QDebug>
 #include <QtTest/QtTest>
 
@@ -16,6 +19,24 @@ TestMap::TestMap() = default;
 
 TestMap::~TestMap() = default;
 
+void TestMap::compareStringsBenchmark()
+{
+    const std::string desc
+        = "You are standing in the common room of the Prancing Pony. Tables and benches\n"
+          "are scattered about, and a large fire crackles in the hearth to the east.\n"
+          "A door leads out to the yard, and a passage leads north into the inn.\n";
+    std::string edited = desc;
+    edited.replace(edited.find("large"), 5, "small");
+
+    int matches = 0;
+    QBENCHMARK {
+        matches += compareStrings(desc, desc, 10) == ComparisonResultEnum::EQUAL;
+        matches += compareStrings(desc, edited, 10) == ComparisonResultEnum::TOLERANCE;
+        matches += compareStrings(desc, edited, 0) == ComparisonResultEnum::DIFFERENT;
+    }
+    QVERIFY(matches > 0);
+}
+
 void TestMap::diffTest()
 {
     Map::enableExtraSanityChecks(true);
@@ -15,6 +15,7 @@ class NODISCARD_QOBJECT TestMap final : public QObject
     ~TestMap() final;
 
 private Q_SLOTS:
+    static void compareStringsBenchmark();
     static void diffTest();
     static void mapTest();
     static void sanitizerTest();
@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (C) 2025 The MMapper Authors
+
+#include "TestMapStorage.h"
+
+#include "../src/global/TextUtils.h"
+#include "../src/global/progresscounter.h"
+#include "../src/mapstorage/MapSource.h"
+#include "../src/mapstorage/RawMapData.h"
+#include "../src/mapstorage/XmlMapFastLoader.h"
+#include "../src/mapstorage/XmlMapStorage.h"
+
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+
+#include <QtTest/QtTest>
+
+namespace { // anonymous
+
+constexpr int NUM_ROOMS = 300;
+
+// A map in the format XmlMapStorage writes, with enough rooms to be split across
+// several worker threads, and with entities and non-ASCII text in every string field.
+NODISCARD std::string makeXmlMap(const std::string_view extra)
+{
+    static constexpr const char *const aligns[] = {"GOOD", "NEUTRAL", "EVIL"};
+    static constexpr const char *const terrains[] = {"INDOORS", "CITY", "FIELD", "FOREST"};
+
+    std::ostringstream os;
+    os << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+       << "<map type=\"mmapper2xml\" version=\"1.0.0\">\n"
+       << extra;
+    for (int i = 0; i < NUM_ROOMS; ++i) {
+        os << "    <room id=\"" << i << "\"";
+        if (i % 3 != 0) {
+            os << " server_id=\"" << 1000 + i << "\"";
+        }
+        os << " name=\"Room &amp; &quot;Hall&quot; " << i << " caf\xc3\xa9\">\n"
+           << "        <area>The Shire &lt;" << i % 7 << "&gt;</area>\n"
+           << "        <align>" << aligns[i % 3] << "</align>\n"
+           << "        <light>" << (i % 2 == 0 ? "LIT" : "DARK") << "</light>\n"
+           << "        <terrain>" << terrains[i % 4] << "</terrain>\n"
+           << "        <coord x=\"" << i % 20 << "\" y=\"" << -(i / 20) << "\" z=\"" << i % 2
+           << "\"/>\n";
+        if (i % 5 == 0) {
+            os << "        <loadflag>TREASURE</loadflag>\n"
+               << "        <loadflag>HERB</loadflag>\n"
+               << "        <mobflag>RENT</mobflag>\n";
+        }
+        if (i + 1 < NUM_ROOMS) {
+            os << "        <exit dir=\"north\" doorname=\"gate &amp; bars\">\n"
+               << "            <to>" << i + 1 << "</to>\n"
+               << "            <doorflag>HIDDEN</doorflag>\n"
+               << "            <exitflag>DOOR</exitflag>\n"
+               << "        </exit>\n";
+        }
+        if (i > 0) {
+            os << "        <exit dir=\"south\">\n"
+               << "            <to>" << i - 1 << "</to>\n"
+               << "        </exit>\n";
+        }
+        os << "        <exit dir=\"up\">\n"
+           << "            <exitflag>NO_EXIT</exitflag>\n"
+           << "        </exit>\n"
+           << "        <description>A long hall &lt;" << i << "&gt; with a\n"
+           << "d&#233;cor of &#x263A; and &apos;quotes&apos;.\n</description>\n"
+           << "        <contents>A chest lies here.\n</contents>\n";
+        if (i % 4 == 0) {
+            os << "        <note>note " << i << "</note>\n";
+        }
+        os << "    </room>\n";
+    }
+    os << "    <marker type=\"TEXT\" class=\"HERB\" angle=\"45\">\n"
+       << "        <pos1 x=\"100\" y=\"-200\" z=\"0\"/>\n"
+       << "        <text>athelas &amp; more</text>\n"
+       << "    </marker>\n"
+       << "    <marker type=\"LINE\" class=\"ROAD\">\n"
+       << "        <pos1 x=\"0\" y=\"0\" z=\"0\"/>\n"
+       << "        <pos2 x=\"300\" y=\"-100\" z=\"0\"/>\n"
+       << "    </marker>\n"
+       << "    <marker type=\"ARROW\" class=\"GENERIC\">\n"
+       << "        <pos1 x=\"5\" y=\"5\" z=\"1\"/>\n"
+       << "    </marker>\n"
+       << "    <position x=\"3\" y=\"-4\" z=\"1\"/>\n"
+       << "</map>\n";
+    return std::move(os).str();
+}
+
+NODISCARD RawMapLoadData loadWithXmlMapStorage(const std::string &xml)
+{
+    AbstractMapStorage::Data data{
+        MapSource::alloc("test.xml", QByteArray::fromStdString(xml))};
+    data.setProgressCounter(std::make_shared<ProgressCounter>());
+    XmlMapStorage storage{data, nullptr};
+    auto result = storage.loadData();
+    if (!result) {
+        throw std::runtime_error("XmlMapStorage failed to load the map");
+    }
+    return std::move(result.value());
+}
+
+void compareMarkers(const RawInfomark &fast, const RawInfomark &generic)
+{
+#define X_COMPARE(_Type, _Prop, _OptInit) QVERIFY(fast.get##_Prop() == generic.get##_Prop());
+    XFOREACH_INFOMARK_PROPERTY(X_COMPARE)
+#undef X_COMPARE
+}
+
+} // namespace
+
+TestMapStorage::TestMapStorage() = default;
+
+TestMapStorage::~TestMapStorage() = default;
+
+void TestMapStorage::xmlFastLoaderTest()
+{
+    const std::string plain = makeXmlMap("");
+    // QXmlStreamReader skips comments, but the fast loader refuses them.
+    const std::string commented = makeXmlMap("    <!-- forces the generic reader -->\n");
+
+    {
+        ProgressCounter pc;
+        QVERIFY(xml_fast_loader::tryLoad(plain, pc).has_value());
+        QVERIFY(!xml_fast_loader::tryLoad(commented, pc).has_value());
+    }
+
+    const RawMapLoadData fast = loadWithXmlMapStorage(plain);
+    const RawMapLoadData generic = loadWithXmlMapStorage(commented);
+
+    QCOMPARE(fast.rooms.size(), static_cast<size_t>(NUM_ROOMS));
+    QCOMPARE(fast.rooms.size(), generic.rooms.size());
+    for (size_t i = 0; i < fast.rooms.size(); ++i) {
+        const auto &a = fast.rooms[i];
+        const auto &b = generic.rooms[i];
+        if (a != b) {
+            qWarning().noquote() << "fast:" << mmqt::toQStringUtf8(a.toStdStringUtf8());
+            qWarning().noquote() << "generic:" << mmqt::toQStringUtf8(b.toStdStringUtf8());
+        }
+        QVERIFY(a == b);
+    }
+
+    QCOMPARE(fast.markers.size(), static_cast<size_t>(3));
+    QCOMPARE(fast.markers.size(), generic.markers.size());
+    for (size_t i = 0; i < fast.markers.size(); ++i) {
+        compareMarkers(fast.markers[i], generic.markers[i]);
+    }
+
+    QVERIFY(fast.position == generic.position);
+    QCOMPARE(fast.readonly, generic.readonly);
+}
+
+void TestMapStorage::xmlFastLoaderRejectsTest()
+{
+    // Bad data must never escape as an exception; the caller falls back instead.
+    const auto rejects = [](const std::string &xml) -> bool {
+        try {
+            ProgressCounter pc;
+            return !xml_fast_loader::tryLoad(xml, pc).has_value();
+        } catch (...) {
+            return false;
+        }
+    };
+
+    const std::string plain = makeXmlMap("");
+    const auto replaced = [&plain](const std::string_view from, const std::string_view to) {
+        std::string copy = plain;
+        const auto pos = copy.find(from);
+        if (pos == std::string::npos) {
+            throw std::logic_error("test pattern not found");
+        }
+        copy.replace(pos, from.size(), to);
+        return copy;
+    };
+
+    QVERIFY(rejects(replaced("<room id=\"1\"", "<room id=\"0\"")));
+    QVERIFY(rejects(replaced("<align>GOOD</align>", "<align>BOGUS</align>")));
+    QVERIFY(rejects(replaced("class=\"HERB\" angle=\"45\"", "class=\"HERB\" angle=\"x\"")));
+    QVERIFY(rejects(replaced("type=\"ARROW\"", "type=\"BOGUS\"")));
+    QVERIFY(rejects(replaced("<pos1 x=\"5\"", "<pos1 x=\"\xff\"")));
+    QVERIFY(rejects(plain.substr(0, plain.size() / 2)));
+}
+
+QTEST_MAIN(TestMapStorage)
@@ -3,12 +3,20 @@
 
 #include "TestProxy.h"
 
+#include "../src/global/Signal2.h"
 #include "../src/global/TextUtils.h"
+#include "../src/proxy/GmcpDispatcher.h"
 #include "../src/proxy/GmcpMessage.h"
 #include "../src/proxy/GmcpModule.h"
 #include "../src/proxy/GmcpUtils.h"
 #include "../src/proxy/telnetfilter.h"
 
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+
 #include <QDebug>
 #include <QtTest/QtTest>
 
@@ -21,11 +29,94 @@ void TestProxy::escapeTest()
     QCOMPARE(GmcpUtils::escapeGmcpStringData("\\\n\r\b\f\t"), QString(R"(\\\n\r\b\f\t)"));
 }
 
+void TestProxy::gmcpDispatcherTest()
+{
+    gmcp_dispatch_stats::reset();
+
+    GmcpDispatcher dispatcher;
+    std::optional<Signal2Lifetime> lifetime;
+    lifetime.emplace();
+
+    int vitals = 0;
+    int rooms = 0;
+    int items = 0;
+    dispatcher.subscribe(GmcpMessageTypeEnum::CHAR_VITALS,
+                         *lifetime,
+                         [&vitals](const GmcpMessage &) { ++vitals; });
+    dispatcher.subscribe({GmcpMessageTypeEnum::ROOM_INFO, GmcpMessageTypeEnum::EVENT_MOVED},
+                         *lifetime,
+                         [&rooms](const GmcpMessage &) { ++rooms; });
+    dispatcher.subscribeModule("Char.Items", *lifetime, [&items](const GmcpMessage &) {
+        ++items;
+    });
+    QCOMPARE(dispatcher.getNumSubscribers(GmcpMessageTypeEnum::CHAR_VITALS), size_t{1});
+    QCOMPARE(dispatcher.getNumSubscribers(GmcpMessageTypeEnum::CHAR_NAME), size_t{0});
+    QCOMPARE(dispatcher.getNumModuleSubscribers("char.items"), size_t{1});
+
+    dispatcher.dispatch(GmcpMessage::fromRawBytes(R"(Char.Vitals {"hp":10})"));
+    dispatcher.dispatch(GmcpMessage::fromRawBytes(R"(Room.Info {"id":1})"));
+    dispatcher.dispatch(GmcpMessage::fromRawBytes(R"(Event.Moved {"dir":"north"})"));
+    dispatcher.dispatch(GmcpMessage::fromRawBytes(R"(Char.Name {"name":"Gandalf"})"));
+    dispatcher.dispatch(GmcpMessage::fromRawBytes(R"(char.items.list {})"));
+    dispatcher.dispatch(GmcpMessage::fromRawBytes(R"(Char.Skills.List {})"));
+    QCOMPARE(vitals, 1);
+    QCOMPARE(rooms, 2);
+    QCOMPARE(items, 1);
+
+    QCOMPARE(gmcp_dispatch_stats::getSnapshot(GmcpMessageTypeEnum::CHAR_VITALS).count,
+             uint64_t{1});
+    QCOMPARE(gmcp_dispatch_stats::getSnapshot(GmcpMessageTypeEnum::CHAR_NAME).count, uint64_t{0});
+    QCOMPARE(gmcp_dispatch_stats::getSnapshot(GmcpMessageTypeEnum::UNKNOWN).count, uint64_t{1});
+
+    // a throwing handler is logged, and doesn't stop the others
+    dispatcher.subscribe(GmcpMessageTypeEnum::CHAR_VITALS, *lifetime, [](const GmcpMessage &) {
+        throw std::runtime_error("bad payload");
+    });
+    dispatcher.dispatch(GmcpMessage{GmcpMessageTypeEnum::CHAR_VITALS});
+    QCOMPARE(vitals, 2);
+    QCOMPARE(dispatcher.getNumSubscribers(GmcpMessageTypeEnum::CHAR_VITALS), size_t{2});
+
+    bool threw = false;
+    try {
+        dispatcher.subscribe(GmcpMessageTypeEnum::UNKNOWN, *lifetime, [](const GmcpMessage &) {});
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    QVERIFY(threw);
+
+    // expired handlers are dropped
+    lifetime.reset();
+    dispatcher.dispatch(GmcpMessage{GmcpMessageTypeEnum::CHAR_VITALS});
+    QCOMPARE(vitals, 2);
+    QCOMPARE(dispatcher.getNumSubscribers(GmcpMessageTypeEnum::CHAR_VITALS), size_t{0});
+
+    gmcp_dispatch_stats::reset();
+}
+
 void TestProxy::gmcpMessageDeserializeTest()
 {
     GmcpMessage gmcp1 = GmcpMessage::fromRawBytes(R"(Core.Hello { "Hello": "world" })");
     QCOMPARE(gmcp1.getName().toQByteArray(), QByteArray("Core.Hello"));
     QCOMPARE(gmcp1.getJson()->toQString(), mmqt::toQStringUtf8(R"({ "Hello": "world" })"));
+    {
+        // The view is parsed once, and copies point into their own payload.
+        const GmcpMessage copy = std::invoke([&gmcp1]() {
+            GmcpMessage original = gmcp1;
+            std::ignore = original.getJsonView();
+            return GmcpMessage{original};
+        });
+        for (const GmcpMessage *const msg : {&gmcp1, &copy}) {
+            const auto view = msg->getJsonView();
+            QVERIFY(view.has_value());
+            const std::string_view payload = msg->getJson()->getStdStringViewUtf8();
+            const std::string_view raw = view->getRaw();
+            QVERIFY(raw.data() >= payload.data());
+            QVERIFY(raw.data() + raw.size() <= payload.data() + payload.size());
+            const auto hello = view->getObject().value().get("Hello");
+            QVERIFY(hello.has_value());
+            QVERIFY(hello->getStringView() == std::string_view{"world"});
+        }
+    }
 
     GmcpMessage gmcp2 = GmcpMessage::fromRawBytes(R"(Core.Goodbye)");
     QCOMPARE(gmcp2.getName().toQByteArray(), QByteArray("Core.Goodbye"));
@@ -16,6 +16,7 @@ class NODISCARD_QOBJECT TestProxy final : public QObject
 
 private Q_SLOTS:
     static void escapeTest();
+    static void gmcpDispatcherTest();
     static void gmcpMessageDeserializeTest();
     static void gmcpMessageSerializeTest();
     static void gmcpModuleTest();
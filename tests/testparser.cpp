@@ -4,12 +4,16 @@
 #include "testparser.h"
 
 #include "../src/global/Charset.h"
+#include "../src/global/JsonView.h"
 #include "../src/global/TextUtils.h"
 #include "../src/global/parserutils.h"
+#include "../src/map/PromptFlags.h"
 #include "../src/map/RawExit.h"
 #include "../src/map/mmapper2room.h"
 #include "../src/map/parseevent.h"
 #include "../src/map/sanitizer.h"
+#include "../src/parser/Action.h"
+#include "../src/parser/GmcpPromptFlags.h"
 
 #include <QDebug>
 #include <QString>
@@ -40,12 +44,58 @@ TestParser::TestParser() = default;
 
 TestParser::~TestParser() = default;
 
+void TestParser::actionMatcherTest()
+{
+    test::testActionMatcher();
+}
+
+void TestParser::gmcpPromptFlagsTest()
+{
+    const auto apply = [](const char *const json, PromptFlagsType &flags) {
+        const auto obj = JsonValueView::parse(json).value().getObject().value();
+        return applyGmcpPromptFlags(obj, flags);
+    };
+
+    PromptFlagsType flags;
+    {
+        // Heavy rain is the only flag that needs an escape in JSON.
+        const auto updated = apply(R"({"weather":"\""})", flags);
+        QVERIFY(updated.weather);
+        QVERIFY(!updated.fog);
+        QCOMPARE(flags.getWeatherType(), PromptWeatherEnum::HEAVY_RAIN);
+    }
+    {
+        const auto updated = apply(R"({"fog":"=","light":"*","weather":"'"})", flags);
+        QVERIFY(updated.fog && updated.weather);
+        QCOMPARE(flags.getFogType(), PromptFogEnum::HEAVY_FOG);
+        QCOMPARE(flags.getWeatherType(), PromptWeatherEnum::RAIN);
+        QVERIFY(flags.isLit());
+    }
+    {
+        const auto updated = apply(R"({"fog":null,"weather":null,"light":"o"})", flags);
+        QVERIFY(updated.fog && updated.weather);
+        QCOMPARE(flags.getFogType(), PromptFogEnum::NO_FOG);
+        QCOMPARE(flags.getWeatherType(), PromptWeatherEnum::NICE);
+        QVERIFY(flags.isDark());
+    }
+    {
+        // Fields that aren't sent leave the flags alone.
+        const auto updated = apply(R"({"hp":100})", flags);
+        QVERIFY(!updated.fog && !updated.weather);
+        QVERIFY(flags.isDark());
+    }
+}
+
 void TestParser::removeAnsiMarksTest()
 {
     QString ansiString("\033[32mHello world\033[0m");
     QString expected("Hello world");
     ParserUtils::removeAnsiMarksInPlace(ansiString);
     QCOMPARE(ansiString, expected);
+
+    std::string ansiStdString = "\033[32mHello\033[1;33;44m world\033[0m\033[";
+    ParserUtils::removeAnsiMarksInPlace(ansiStdString);
+    QCOMPARE(ansiStdString, std::string{"Hello world\033["});
 }
 
 void TestParser::toAsciiTest()
@@ -15,6 +15,10 @@ class NODISCARD_QOBJECT TestParser final : public QObject
     ~TestParser() final;
 
 private Q_SLOTS:
+    // Action
+    static void actionMatcherTest();
+    // GmcpPromptFlags
+    static void gmcpPromptFlagsTest();
     // ParserUtils
     static void createParseEventTest();
     static void removeAnsiMarksTest();